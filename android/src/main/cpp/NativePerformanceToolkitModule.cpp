@@ -1,4 +1,5 @@
 #include "NativePerformanceToolkitModule.h"
+#include "PlatformBridge.hpp"
 
 namespace margelo::nitro::performancetoolkit {
 
@@ -7,10 +8,16 @@ PerformanceToolkitModule::PerformanceToolkitModule(
     jni::alias_ref<react::JRuntimeExecutor::javaobject> runtimeExecutorHolder,
     jdouble deviceRefreshRate
 ) : _runtimeExecutor(runtimeExecutorHolder->cthis()->get()) {
-    RuntimeBridgeState::get().setRuntimeExecutor(_runtimeExecutor);
+    _registrationId = RuntimeBridgeState::get().setRuntimeExecutor(_runtimeExecutor);
     RuntimeBridgeState::get().setDeviceRefreshRate(static_cast<double>(deviceRefreshRate));
 }
 
+// Destroyed from the TurboModule's invalidate() when its runtime goes away. Unless a reload already
+// registered the next runtime, trackers stop posting into this one right here
+PerformanceToolkitModule::~PerformanceToolkitModule() {
+    RuntimeBridgeState::get().unregisterRuntime(RuntimeBridgeState::MAIN_RUNTIME_NAME, _registrationId);
+}
+
 jni::local_ref<PerformanceToolkitModule::jhybriddata> PerformanceToolkitModule::initHybrid(
     jni::alias_ref<PerformanceToolkitModule::jhybridobject> jThis,
     jni::alias_ref<JRuntimeExecutor::javaobject> runtimeExecutorHolder,
@@ -22,7 +29,9 @@ jni::local_ref<PerformanceToolkitModule::jhybriddata> PerformanceToolkitModule::
 jni::local_ref<BindingsInstallerHolder::javaobject> PerformanceToolkitModule::getBindingsInstallerNative(
     jni::alias_ref<PerformanceToolkitModule::javaobject> /* jThis */
 ) {
-    return BindingsInstallerHolder::newObjectCxxArgs([](jsi::Runtime& /* rt */) {});
+    return BindingsInstallerHolder::newObjectCxxArgs([](jsi::Runtime& /* rt */) {
+        PlatformBridge::notifyBindingsInstalled();
+    });
 }
 
 void PerformanceToolkitModule::registerNatives() {
@@ -18,6 +18,7 @@ struct PerformanceToolkitModule : public jni::HybridClass<PerformanceToolkitModu
         jni::alias_ref<react::JRuntimeExecutor::javaobject> runtimeExecutorHolder,
         jdouble deviceRefreshRate
     );
+    ~PerformanceToolkitModule();
 
     static void registerNatives();
     static jni::local_ref<jhybriddata> initHybrid(
@@ -32,6 +33,7 @@ struct PerformanceToolkitModule : public jni::HybridClass<PerformanceToolkitModu
 
 private:
     RuntimeExecutor _runtimeExecutor;
+    uint64_t _registrationId = 0;
 };
 
 } // namespace margelo::nitro::performancetoolkit
@@ -0,0 +1,54 @@
+#include "NativePlatformBridge.h"
+
+#include <time.h>
+
+namespace margelo::nitro::performancetoolkit {
+
+void NativePlatformBridge::notifyUiFrame(jni::alias_ref<jclass> /* clazz */, jlong frameTimeNanos) {
+    // Choreographer only reports the vsync time, the frame budget comes from the current refresh rate.
+    // Its timebase is System.nanoTime, which is CLOCK_MONOTONIC
+    timespec now{};
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    const int64_t platformNowNs = static_cast<int64_t>(now.tv_sec) * 1'000'000'000 + now.tv_nsec;
+    PlatformBridge::notifyUiFrame(static_cast<int64_t>(frameTimeNanos), 0, platformNowNs);
+}
+
+void NativePlatformBridge::notifyRefreshRateChanged(jni::alias_ref<jclass> /* clazz */, jdouble refreshRate) {
+    PlatformBridge::notifyRefreshRateChanged(static_cast<double>(refreshRate));
+}
+
+void NativePlatformBridge::notifyFirstUiFrame(jni::alias_ref<jclass> /* clazz */) {
+    PlatformBridge::notifyFirstUiFrame();
+}
+
+void NativePlatformBridge::setCacheDirectory(jni::alias_ref<jclass> /* clazz */, jni::alias_ref<jni::JString> path) {
+    PlatformBridge::setCacheDirectory(path->toStdString().c_str());
+}
+
+jni::local_ref<jni::JByteBuffer> NativePlatformBridge::getUiFpsBuffer(jni::alias_ref<jclass> /* clazz */) {
+    // Filled by the shared UiFrameAnalyzer from the frames forwarded by notifyUiFrame
+    return jni::JByteBuffer::wrapBytes(reinterpret_cast<uint8_t*>(PlatformBridge::getUiFpsCell()), sizeof(int32_t));
+}
+
+jni::local_ref<jni::JByteBuffer> NativePlatformBridge::getCpuUsageBuffer(jni::alias_ref<jclass> /* clazz */) {
+    // The sampler is a process-wide singleton, the cell outlives any buffer wrapping it
+    return jni::JByteBuffer::wrapBytes(reinterpret_cast<uint8_t*>(PlatformBridge::getCpuUsageCell()), sizeof(int32_t));
+}
+
+jni::local_ref<jni::JByteBuffer> NativePlatformBridge::getMemoryUsageBuffer(jni::alias_ref<jclass> /* clazz */) {
+    return jni::JByteBuffer::wrapBytes(reinterpret_cast<uint8_t*>(PlatformBridge::getMemoryUsageCell()), sizeof(int32_t));
+}
+
+void NativePlatformBridge::registerNatives() {
+    javaClassStatic()->registerNatives({
+        makeNativeMethod("notifyUiFrame", NativePlatformBridge::notifyUiFrame),
+        makeNativeMethod("notifyRefreshRateChanged", NativePlatformBridge::notifyRefreshRateChanged),
+        makeNativeMethod("notifyFirstUiFrame", NativePlatformBridge::notifyFirstUiFrame),
+        makeNativeMethod("setCacheDirectory", NativePlatformBridge::setCacheDirectory),
+        makeNativeMethod("getUiFpsBuffer", NativePlatformBridge::getUiFpsBuffer),
+        makeNativeMethod("getCpuUsageBuffer", NativePlatformBridge::getCpuUsageBuffer),
+        makeNativeMethod("getMemoryUsageBuffer", NativePlatformBridge::getMemoryUsageBuffer),
+    });
+}
+
+} // namespace margelo::nitro::performancetoolkit
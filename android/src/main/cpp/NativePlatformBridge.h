@@ -0,0 +1,25 @@
+#pragma once
+
+#include <fbjni/fbjni.h>
+#include "PlatformBridge.hpp"
+
+namespace margelo::nitro::performancetoolkit {
+
+using namespace facebook;
+
+// JNI side of PlatformBridge, lets Kotlin push native events into the shared C++ core
+struct NativePlatformBridge : public jni::JavaClass<NativePlatformBridge> {
+    static constexpr auto kJavaDescriptor = "Lcom/performancetoolkit/PlatformBridge;";
+
+    static void registerNatives();
+
+    static void notifyUiFrame(jni::alias_ref<jclass> /* clazz */, jlong frameTimeNanos);
+    static void notifyRefreshRateChanged(jni::alias_ref<jclass> /* clazz */, jdouble refreshRate);
+    static void notifyFirstUiFrame(jni::alias_ref<jclass> /* clazz */);
+    static void setCacheDirectory(jni::alias_ref<jclass> /* clazz */, jni::alias_ref<jni::JString> path);
+    static jni::local_ref<jni::JByteBuffer> getUiFpsBuffer(jni::alias_ref<jclass> /* clazz */);
+    static jni::local_ref<jni::JByteBuffer> getCpuUsageBuffer(jni::alias_ref<jclass> /* clazz */);
+    static jni::local_ref<jni::JByteBuffer> getMemoryUsageBuffer(jni::alias_ref<jclass> /* clazz */);
+};
+
+} // namespace margelo::nitro::performancetoolkit
@@ -1,9 +1,12 @@
 #include <jni.h>
 #include "PerformanceToolkitOnLoad.hpp"
 #include "NativePerformanceToolkitModule.h"
+#include "NativePlatformBridge.h"
 
 JNIEXPORT jint JNICALL JNI_OnLoad(JavaVM* vm, void*) {
+  margelo::nitro::performancetoolkit::PlatformBridge::notifyNativeLibraryLoaded();
   jint result = margelo::nitro::performancetoolkit::initialize(vm);
   margelo::nitro::performancetoolkit::PerformanceToolkitModule::registerNatives();
+  margelo::nitro::performancetoolkit::NativePlatformBridge::registerNatives();
   return result;
 }
@@ -1,8 +1,12 @@
 package com.performancetoolkit
 
 import android.content.Context
+import android.hardware.display.DisplayManager
 import android.os.Build
+import android.os.Handler
+import android.os.Looper
 import android.util.Log
+import android.view.Choreographer
 import android.view.WindowManager
 import com.performancetoolkit.NativeTurboPerformanceToolkitSpec
 import com.facebook.jni.HybridData
@@ -21,6 +25,15 @@ class PerformanceToolkitTurboModule(reactContext: ReactApplicationContext) :
   @DoNotStrip private var hybridData: HybridData?
   private val runtimeExecutor: RuntimeExecutor
 
+  // Adaptive refresh rate displays can switch mid-session, keep the C++ trackers in sync
+  private val displayListener = object : DisplayManager.DisplayListener {
+    override fun onDisplayAdded(displayId: Int) {}
+    override fun onDisplayRemoved(displayId: Int) {}
+    override fun onDisplayChanged(displayId: Int) {
+      PlatformBridge.notifyRefreshRateChanged(DeviceUtils.getDeviceCurrentRefreshRate(reactApplicationContext))
+    }
+  }
+
   companion object {
     private const val TAG = "PerformanceToolkitTM"
     const val NAME: String = NativeTurboPerformanceToolkitSpec.NAME
@@ -28,6 +41,10 @@ class PerformanceToolkitTurboModule(reactContext: ReactApplicationContext) :
     init {
       try {
         PerformanceToolkitOnLoad.initializeNative()
+        // Startup timeline: the first frame drawn after the library loaded
+        Handler(Looper.getMainLooper()).post {
+          Choreographer.getInstance().postFrameCallback { PlatformBridge.notifyFirstUiFrame() }
+        }
       } catch (e: Exception) {
         Log.e(TAG, "Error initializing native library", e)
       }
@@ -39,7 +56,7 @@ class PerformanceToolkitTurboModule(reactContext: ReactApplicationContext) :
       ?: throw IllegalStateException("PerformanceToolkit: React Native runtime executor is not available. Please ensure New Architecture is enabled.")
 
     runtimeExecutor = executor
-    val deviceFps = DeviceUtils.getDeviceMaxRefreshRate(reactContext)
+    val deviceFps = DeviceUtils.getDeviceCurrentRefreshRate(reactContext)
     
     try {
       hybridData = initHybrid(runtimeExecutor, deviceFps)
@@ -47,9 +64,17 @@ class PerformanceToolkitTurboModule(reactContext: ReactApplicationContext) :
       Log.e(TAG, "Error initializing PerformanceToolkitTurboModule", e)
       throw e
     }
+
+    PlatformBridge.setCacheDirectory(reactContext.cacheDir.absolutePath)
+
+    val displayManager = reactContext.getSystemService(Context.DISPLAY_SERVICE) as? DisplayManager
+    displayManager?.registerDisplayListener(displayListener, Handler(Looper.getMainLooper()))
   }
 
   override fun invalidate() {
+    val displayManager = reactApplicationContext.getSystemService(Context.DISPLAY_SERVICE) as? DisplayManager
+    displayManager?.unregisterDisplayListener(displayListener)
+
     try {
       hybridData?.resetNative()
       hybridData = null
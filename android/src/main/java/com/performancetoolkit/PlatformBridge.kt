@@ -0,0 +1,55 @@
+package com.performancetoolkit
+
+import com.facebook.proguard.annotations.DoNotStrip
+import java.nio.ByteBuffer
+
+/**
+ * Pushes native events into the shared C++ core (see cpp/PlatformBridge.hpp).
+ * Natives are registered in JNI_OnLoad, so only call these once the native library is loaded.
+ */
+@DoNotStrip
+@Suppress("KotlinJniMissingFunction")
+object PlatformBridge {
+  @JvmStatic
+  @DoNotStrip
+  external fun notifyUiFrame(frameTimeNanos: Long)
+
+  @JvmStatic
+  @DoNotStrip
+  external fun notifyRefreshRateChanged(refreshRate: Double)
+
+  /**
+   * Records the first UI frame of the startup timeline, later calls are ignored.
+   */
+  @JvmStatic
+  @DoNotStrip
+  external fun notifyFirstUiFrame()
+
+  /**
+   * Directory session recordings are written to by default (the app cache dir).
+   */
+  @JvmStatic
+  @DoNotStrip
+  external fun setCacheDirectory(path: String)
+
+  /**
+   * Returns a direct buffer over the UI FPS (int32) computed natively from the frames passed to [notifyUiFrame].
+   */
+  @JvmStatic
+  @DoNotStrip
+  external fun getUiFpsBuffer(): ByteBuffer
+
+  /**
+   * Starts the native CPU sampler and returns a direct buffer over its process CPU usage (int32, percent).
+   */
+  @JvmStatic
+  @DoNotStrip
+  external fun getCpuUsageBuffer(): ByteBuffer
+
+  /**
+   * Starts the native memory sampler and returns a direct buffer over its process memory usage (int32, MB).
+   */
+  @JvmStatic
+  @DoNotStrip
+  external fun getMemoryUsageBuffer(): ByteBuffer
+}
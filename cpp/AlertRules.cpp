@@ -0,0 +1,277 @@
+#include "AlertRules.hpp"
+
+#include <algorithm>
+
+namespace margelo::nitro::performancetoolkit {
+
+static constexpr double MS_PER_MINUTE = 60'000.0;
+
+AlertRules& AlertRules::get() {
+  static AlertRules instance;
+  return instance;
+}
+
+AlertRules::AlertRules() : _queue(std::make_unique<Cell[]>(QUEUE_CAPACITY)) {
+  for (uint32_t i = 0; i < QUEUE_CAPACITY; i++) {
+    _queue[i].sequence.store(i, std::memory_order_relaxed);
+  }
+}
+
+AlertRules::RuleId AlertRules::add(const Rule& rule, Listener listener) {
+  auto entry = std::make_shared<Entry>();
+  entry->rule = rule;
+  entry->rule.forMs = std::max(rule.forMs, 0.0);
+  if (rule.condition == Condition::SlopeAbove || rule.condition == Condition::SlopeBelow) {
+    // A slope needs two points, and the window can't be longer than what a rule keeps
+    if (entry->rule.forSamples != 0) {
+      entry->rule.forSamples = std::clamp<uint32_t>(entry->rule.forSamples, 2, WINDOW_CAPACITY);
+    }
+  }
+  entry->listener = std::move(listener);
+
+  std::lock_guard<std::mutex> lock(_mutex);
+  entry->id = _nextRuleId++;
+  auto entries = std::make_shared<std::vector<std::shared_ptr<Entry>>>(*_entries);
+  entries->push_back(entry);
+  _entries = std::move(entries);
+  _rulesVersion.fetch_add(1, std::memory_order_release);
+  _watchedSlots.fetch_or(1u << static_cast<uint32_t>(rule.metric), std::memory_order_release);
+  return entry->id;
+}
+
+void AlertRules::remove(RuleId id) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  auto entries = std::make_shared<std::vector<std::shared_ptr<Entry>>>(*_entries);
+  entries->erase(
+    std::remove_if(entries->begin(), entries->end(), [id](const auto& entry) { return entry->id == id; }),
+    entries->end()
+  );
+  uint32_t watchedSlots = 0;
+  for (const auto& entry : *entries) {
+    watchedSlots |= 1u << static_cast<uint32_t>(entry->rule.metric);
+  }
+  _entries = std::move(entries);
+  _rulesVersion.fetch_add(1, std::memory_order_release);
+  _watchedSlots.store(watchedSlots, std::memory_order_release);
+}
+
+void AlertRules::onSamples(std::initializer_list<std::pair<MetricSlot, double>> values, double timestampMs) {
+  const uint32_t watchedSlots = _watchedSlots.load(std::memory_order_acquire);
+  uint32_t publishedSlots = 0;
+  for (const auto& [slot, value] : values) {
+    publishedSlots |= 1u << static_cast<uint32_t>(slot);
+  }
+  if ((watchedSlots & publishedSlots) == 0) {
+    return;
+  }
+
+  for (const auto& [slot, value] : values) {
+    if ((watchedSlots & (1u << static_cast<uint32_t>(slot))) != 0 && !push(QueuedSample{slot, Sample{value, timestampMs}})) {
+      _droppedSamples.fetch_add(1, std::memory_order_relaxed); // Full, evaluation is behind
+    }
+  }
+  // The first sample after the task drained the queue schedules the next evaluation
+  if (!_evaluationScheduled.exchange(true)) {
+    TrackerScheduler::get().schedule(TrackerScheduler::Clock::duration::zero(), [this]() -> std::optional<TrackerScheduler::Clock::duration> {
+      evaluatePending();
+      return std::nullopt;
+    });
+  }
+}
+
+bool AlertRules::isIdle() const {
+  return _evaluatedSamples.load(std::memory_order_acquire) == _enqueuePosition.load(std::memory_order_acquire);
+}
+
+uint64_t AlertRules::getDroppedSamples() const {
+  return _droppedSamples.load(std::memory_order_relaxed);
+}
+
+bool AlertRules::push(const QueuedSample& sample) {
+  // Each cell's sequence tells whose turn it is
+  uint64_t position = _enqueuePosition.load(std::memory_order_relaxed);
+  for (;;) {
+    Cell& cell = _queue[position & (QUEUE_CAPACITY - 1)];
+    const uint64_t sequence = cell.sequence.load(std::memory_order_acquire);
+    const auto difference = static_cast<int64_t>(sequence) - static_cast<int64_t>(position);
+    if (difference == 0) {
+      if (_enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+        cell.sample = sample;
+        cell.sequence.store(position + 1, std::memory_order_release);
+        return true;
+      }
+    } else if (difference < 0) {
+      return false; // Full
+    } else {
+      position = _enqueuePosition.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+bool AlertRules::pop(QueuedSample& out) {
+  uint64_t position = _dequeuePosition.load(std::memory_order_relaxed);
+  for (;;) {
+    Cell& cell = _queue[position & (QUEUE_CAPACITY - 1)];
+    const uint64_t sequence = cell.sequence.load(std::memory_order_acquire);
+    const auto difference = static_cast<int64_t>(sequence) - static_cast<int64_t>(position + 1);
+    if (difference == 0) {
+      if (_dequeuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+        out = cell.sample;
+        cell.sequence.store(position + QUEUE_CAPACITY, std::memory_order_release);
+        return true;
+      }
+    } else if (difference < 0) {
+      return false; // Empty
+    } else {
+      position = _dequeuePosition.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+void AlertRules::evaluatePending() {
+  // Cleared before draining: a sample pushed after the drain saw an empty queue schedules a new
+  // task. The exchange orders the pops after it, so they see every push that found it still set
+  _evaluationScheduled.exchange(false);
+
+  std::shared_ptr<const std::vector<std::shared_ptr<Entry>>> entries;
+  uint64_t rulesVersion = 0;
+  QueuedSample queued{};
+  while (pop(queued)) {
+    // A rule added before its first sample was popped sees that sample
+    if (entries == nullptr || _rulesVersion.load(std::memory_order_acquire) != rulesVersion) {
+      std::lock_guard<std::mutex> lock(_mutex);
+      entries = _entries;
+      rulesVersion = _rulesVersion.load(std::memory_order_relaxed);
+    }
+    for (const auto& entry : *entries) {
+      Firing firing;
+      if (queued.slot == entry->rule.metric && evaluate(*entry, queued.sample, firing)) {
+        entry->listener(firing);
+      }
+    }
+    _evaluatedSamples.fetch_add(1, std::memory_order_release);
+  }
+}
+
+bool AlertRules::evaluate(Entry& entry, const Sample& sample, Firing& firing) {
+  entry.samples[entry.sampleCount % WINDOW_CAPACITY] = sample;
+  entry.sampleCount++;
+  switch (entry.rule.condition) {
+    case Condition::Above:
+    case Condition::Below:
+      return evaluateThreshold(entry, sample, firing);
+    case Condition::SlopeAbove:
+    case Condition::SlopeBelow:
+      return evaluateSlope(entry, sample, firing);
+  }
+  return false;
+}
+
+// Copies the newest `count` of `sampleCount` samples recorded into the ring, oldest first
+static std::vector<AlertRules::Sample> newestSamples(const std::array<AlertRules::Sample, AlertRules::WINDOW_CAPACITY>& samples, uint64_t sampleCount, uint64_t count) {
+  std::vector<AlertRules::Sample> window;
+  window.reserve(count);
+  for (uint64_t i = sampleCount - count; i < sampleCount; i++) {
+    window.push_back(samples[i % AlertRules::WINDOW_CAPACITY]);
+  }
+  return window;
+}
+
+bool AlertRules::evaluateThreshold(Entry& entry, const Sample& sample, Firing& firing) {
+  const Rule& rule = entry.rule;
+  // NaN compares false both ways, a missing value never violates
+  const bool violating = rule.condition == Condition::Above ? sample.value > rule.threshold : sample.value < rule.threshold;
+  if (!violating) {
+    entry.violatingSamples = 0;
+    entry.fired = false;
+    return false;
+  }
+  if (entry.violatingSamples == 0) {
+    entry.violatingSinceMs = sample.timestampMs;
+  }
+  entry.violatingSamples++;
+  if (entry.fired || entry.violatingSamples < rule.forSamples || sample.timestampMs - entry.violatingSinceMs < rule.forMs) {
+    return false;
+  }
+
+  entry.fired = true;
+  const uint64_t retained = std::min<uint64_t>(entry.sampleCount, WINDOW_CAPACITY);
+  firing = Firing{
+    entry.id,
+    rule.metric,
+    sample.value,
+    entry.violatingSinceMs,
+    sample.timestampMs,
+    newestSamples(entry.samples, entry.sampleCount, std::min<uint64_t>(entry.violatingSamples, retained)),
+  };
+  return true;
+}
+
+bool AlertRules::evaluateSlope(Entry& entry, const Sample& sample, Firing& firing) {
+  const Rule& rule = entry.rule;
+  const uint64_t retained = std::min<uint64_t>(entry.sampleCount, WINDOW_CAPACITY);
+
+  uint64_t count = 0;
+  if (rule.forSamples != 0) {
+    if (retained < rule.forSamples) {
+      return false; // Not enough history yet
+    }
+    count = rule.forSamples;
+  } else {
+    const double windowMs = rule.forMs > 0.0 ? rule.forMs : DEFAULT_SLOPE_WINDOW_MS;
+    while (count < retained && entry.samples[(entry.sampleCount - count - 1) % WINDOW_CAPACITY].timestampMs >= sample.timestampMs - windowMs) {
+      count++;
+    }
+    // Only judge a full window: an older sample must exist, unless the window outgrew the ring
+    if (count == retained && retained < WINDOW_CAPACITY) {
+      return false;
+    }
+  }
+  if (count < 2) {
+    return false;
+  }
+
+  // Least squares over the window, time relative to its first sample to keep precision
+  const uint64_t first = entry.sampleCount - count;
+  const double originMs = entry.samples[first % WINDOW_CAPACITY].timestampMs;
+  double sumX = 0.0;
+  double sumY = 0.0;
+  double sumXX = 0.0;
+  double sumXY = 0.0;
+  for (uint64_t i = first; i < entry.sampleCount; i++) {
+    const Sample& point = entry.samples[i % WINDOW_CAPACITY];
+    const double x = (point.timestampMs - originMs) / MS_PER_MINUTE;
+    sumX += x;
+    sumY += point.value;
+    sumXX += x * x;
+    sumXY += x * point.value;
+  }
+  const double n = static_cast<double>(count);
+  const double denominator = n * sumXX - sumX * sumX;
+  if (denominator <= 0.0) {
+    return false; // All samples at the same time
+  }
+  const double slopePerMinute = (n * sumXY - sumX * sumY) / denominator;
+
+  const bool violating = rule.condition == Condition::SlopeAbove ? slopePerMinute > rule.threshold : slopePerMinute < rule.threshold;
+  if (!violating) {
+    entry.fired = false;
+    return false;
+  }
+  if (entry.fired) {
+    return false;
+  }
+
+  entry.fired = true;
+  firing = Firing{
+    entry.id,
+    rule.metric,
+    slopePerMinute,
+    originMs,
+    sample.timestampMs,
+    newestSamples(entry.samples, entry.sampleCount, count),
+  };
+  return true;
+}
+
+} // namespace margelo::nitro::performancetoolkit
@@ -0,0 +1,139 @@
+#pragma once
+
+#include "MetricsBlock.hpp"
+#include "TrackerScheduler.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace margelo::nitro::performancetoolkit {
+
+// Threshold alerts evaluated natively against every sample, so short violations between JS polls
+// are not missed and JS only runs when a rule fires.
+//
+// MetricsBlock hands every published value to `onSamples` on the publishing thread (samplers,
+// but also the JS and UI threads). Values of watched slots are only pushed into a bounded
+// lock-free queue there, rules are evaluated in a TrackerScheduler task that drains it, so a
+// publish never runs rule code. Each rule watches one metric slot and keeps its last
+// WINDOW_CAPACITY samples:
+//   - Above / Below fire once the value stayed past `threshold` for `forMs` and `forSamples`
+//     (both optional, without either the first violating sample fires)
+//   - SlopeAbove / SlopeBelow fire when the least-squares slope (units per minute) over the last
+//     `forSamples` samples, or else the last `forMs` (DEFAULT_SLOPE_WINDOW_MS), passes `threshold`
+// A rule fires once per violation and re-arms when its condition stops holding.
+//
+// Listeners are called on the scheduler thread and must not block. Nitro callbacks from JS are
+// dispatched to their runtime asynchronously.
+class AlertRules {
+public:
+  using RuleId = uint64_t;
+
+  static constexpr uint32_t WINDOW_CAPACITY = 256;
+  static constexpr uint32_t QUEUE_CAPACITY = 1024; // Power of two, seconds of samples of every slot
+  static constexpr double DEFAULT_SLOPE_WINDOW_MS = 60'000.0;
+
+  enum class Condition : uint32_t {
+    Above = 0,
+    Below,
+    SlopeAbove,
+    SlopeBelow,
+  };
+
+  struct Rule {
+    MetricSlot metric;
+    Condition condition;
+    double threshold;
+    double forMs;        // 0 = not set
+    uint32_t forSamples; // 0 = not set
+  };
+
+  struct Sample {
+    double value;
+    double timestampMs; // steady clock ms, same timebase as MetricsBlock's updatedAtMs
+  };
+
+  struct Firing {
+    RuleId ruleId;
+    MetricSlot metric;
+    double value; // Latest value, or the slope per minute for slope rules
+    double startedAtMs;
+    double firedAtMs;
+    std::vector<Sample> window; // Samples the rule fired on, oldest first
+  };
+
+  using Listener = std::function<void(const Firing& firing)>;
+
+  static AlertRules& get();
+
+  RuleId add(const Rule& rule, Listener listener);
+  void remove(RuleId id);
+
+  // Called by MetricsBlock after every publish, never blocks
+  void onSamples(std::initializer_list<std::pair<MetricSlot, double>> values, double timestampMs);
+
+  // Whether every sample queued so far was evaluated and its listeners returned
+  bool isIdle() const;
+  // Samples dropped because the queue was full
+  uint64_t getDroppedSamples() const;
+
+private:
+  AlertRules();
+
+  struct QueuedSample {
+    MetricSlot slot;
+    Sample sample;
+  };
+
+  struct Cell {
+    std::atomic<uint64_t> sequence;
+    QueuedSample sample;
+  };
+
+  struct Entry {
+    RuleId id;
+    Rule rule;
+    Listener listener;
+
+    // Evaluation state, scheduler thread only
+    std::array<Sample, WINDOW_CAPACITY> samples;
+    uint64_t sampleCount = 0;
+    double violatingSinceMs = 0.0;
+    uint32_t violatingSamples = 0;
+    bool fired = false;
+  };
+
+  bool push(const QueuedSample& sample);
+  bool pop(QueuedSample& out);
+  // Scheduler task, evaluates everything queued
+  void evaluatePending();
+
+  // Records `sample` and fills `firing` if the rule fires on it
+  static bool evaluate(Entry& entry, const Sample& sample, Firing& firing);
+  static bool evaluateThreshold(Entry& entry, const Sample& sample, Firing& firing);
+  static bool evaluateSlope(Entry& entry, const Sample& sample, Firing& firing);
+
+  std::mutex _mutex;
+  // Copy-on-write, so evaluation never holds the lock while calling listeners
+  std::shared_ptr<const std::vector<std::shared_ptr<Entry>>> _entries = std::make_shared<const std::vector<std::shared_ptr<Entry>>>();
+  RuleId _nextRuleId = 1;
+  std::atomic<uint64_t> _rulesVersion{0}; // Bumped with every change of _entries, under _mutex
+  // Slots watched by at least one rule, lets publishes of other slots return right away
+  std::atomic<uint32_t> _watchedSlots{0};
+
+  // Bounded MPMC queue (Vyukov) from the publishing threads to the evaluation task
+  std::unique_ptr<Cell[]> _queue;
+  alignas(64) std::atomic<uint64_t> _enqueuePosition{0};
+  alignas(64) std::atomic<uint64_t> _dequeuePosition{0};
+  alignas(64) std::atomic<uint64_t> _evaluatedSamples{0}; // Popped and evaluated, trails _dequeuePosition
+  std::atomic<uint64_t> _droppedSamples{0};
+  std::atomic<bool> _evaluationScheduled{false};
+};
+
+} // namespace margelo::nitro::performancetoolkit
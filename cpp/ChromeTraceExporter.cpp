@@ -0,0 +1,144 @@
+#include "ChromeTraceExporter.hpp"
+#include "SessionReader.hpp"
+
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace margelo::nitro::performancetoolkit {
+
+static constexpr size_t WRITE_BUFFER_SIZE = 64 * 1024;
+static constexpr int PID = 1;
+static constexpr int UI_THREAD_TID = 1;
+static constexpr int JS_THREAD_TID = 2;
+static constexpr int JS_LONG_TASKS_TID = 3; // Own track, long tasks cover the same time as their JS tick
+static constexpr int USER_TIMING_FIRST_TID = 100; // One track per thread that recorded user timings
+
+namespace {
+
+struct FileCloser {
+  void operator()(std::FILE* file) const {
+    std::fclose(file);
+  }
+};
+
+// User timing names are arbitrary strings, escape them for a JSON string literal
+void writeJsonString(std::FILE* out, const std::string& value) {
+  std::fputc('"', out);
+  for (const char c : value) {
+    switch (c) {
+      case '"':
+        std::fputs("\\\"", out);
+        break;
+      case '\\':
+        std::fputs("\\\\", out);
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          std::fprintf(out, "\\u%04x", c);
+        } else {
+          std::fputc(c, out);
+        }
+    }
+  }
+  std::fputc('"', out);
+}
+
+} // namespace
+
+std::string ChromeTraceExporter::defaultTracePath(const std::string& sessionPath) {
+  const size_t slash = sessionPath.find_last_of('/');
+  const size_t dot = sessionPath.find_last_of('.');
+  const bool hasExtension = dot != std::string::npos && (slash == std::string::npos || dot > slash);
+  return (hasExtension ? sessionPath.substr(0, dot) : sessionPath) + ".json";
+}
+
+ChromeTraceExporter::Result ChromeTraceExporter::exportSession(const std::string& sessionPath, const std::string& tracePath) {
+  SessionReader reader(sessionPath);
+  std::unique_ptr<std::FILE, FileCloser> file(std::fopen(tracePath.c_str(), "w"));
+  if (file == nullptr) {
+    throw std::runtime_error("Cannot create trace file " + tracePath + ": " + std::strerror(errno));
+  }
+  std::FILE* out = file.get();
+  std::setvbuf(out, nullptr, _IOFBF, WRITE_BUFFER_SIZE);
+
+  const SessionFileHeader& header = reader.header();
+  const double frameIntervalMs = header.refreshRate > 0.0 ? 1000.0 / header.refreshRate : 1000.0 / 60.0;
+  const auto toTraceUs = [&header](int64_t timeNs) {
+    return static_cast<double>(timeNs - header.startTimeNs) / 1000.0;
+  };
+
+  std::fprintf(out, "{\"traceEvents\":[\n");
+  std::fprintf(out, "{\"ph\":\"M\",\"pid\":%d,\"name\":\"process_name\",\"args\":{\"name\":\"React Native\"}}", PID);
+  std::fprintf(out, ",\n{\"ph\":\"M\",\"pid\":%d,\"tid\":%d,\"name\":\"thread_name\",\"args\":{\"name\":\"UI thread\"}}", PID, UI_THREAD_TID);
+  std::fprintf(out, ",\n{\"ph\":\"M\",\"pid\":%d,\"tid\":%d,\"name\":\"thread_name\",\"args\":{\"name\":\"JS thread\"}}", PID, JS_THREAD_TID);
+  std::fprintf(out, ",\n{\"ph\":\"M\",\"pid\":%d,\"tid\":%d,\"name\":\"thread_name\",\"args\":{\"name\":\"JS long tasks\"}}", PID, JS_LONG_TASKS_TID);
+
+  uint64_t samples = 0;
+  std::vector<bool> namedUserThreads;
+  SessionSample sample{};
+  while (reader.next(sample)) {
+    samples++;
+    const double timeUs = toTraceUs(sample.timeNs);
+    const double durationUs = sample.value * 1000.0;
+    switch (sample.type) {
+      case SessionRecordType::UiFrame: {
+        const double intervals = std::round(sample.value / frameIntervalMs);
+        const int droppedFrames = intervals > 1.0 ? static_cast<int>(intervals) - 1 : 0;
+        std::fprintf(out, ",\n{\"ph\":\"X\",\"pid\":%d,\"tid\":%d,\"name\":\"%s\",\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"droppedFrames\":%d}}",
+                     PID, UI_THREAD_TID, droppedFrames > 0 ? "Slow frame" : "Frame", timeUs - durationUs, durationUs, droppedFrames);
+        break;
+      }
+      case SessionRecordType::JsTick:
+        std::fprintf(out, ",\n{\"ph\":\"X\",\"pid\":%d,\"tid\":%d,\"name\":\"JS tick latency\",\"ts\":%.3f,\"dur\":%.3f}",
+                     PID, JS_THREAD_TID, timeUs - durationUs, durationUs);
+        break;
+      case SessionRecordType::LongTask:
+      case SessionRecordType::GcPause:
+        std::fprintf(out, ",\n{\"ph\":\"X\",\"pid\":%d,\"tid\":%d,\"name\":\"%s\",\"ts\":%.3f,\"dur\":%.3f}",
+                     PID, JS_LONG_TASKS_TID, sample.type == SessionRecordType::GcPause ? "GC pause" : "Long task", timeUs, durationUs);
+        break;
+      case SessionRecordType::CpuUsage:
+        std::fprintf(out, ",\n{\"ph\":\"C\",\"pid\":%d,\"name\":\"CPU usage\",\"ts\":%.3f,\"args\":{\"percent\":%.1f}}", PID, timeUs, sample.value);
+        break;
+      case SessionRecordType::MemoryUsage:
+        std::fprintf(out, ",\n{\"ph\":\"C\",\"pid\":%d,\"name\":\"Memory usage\",\"ts\":%.3f,\"args\":{\"MB\":%.3f}}", PID, timeUs, sample.value);
+        break;
+      case SessionRecordType::UserMark:
+      case SessionRecordType::UserSpan: {
+        const int tid = USER_TIMING_FIRST_TID + static_cast<int>(sample.thread);
+        if (sample.thread >= namedUserThreads.size()) {
+          namedUserThreads.resize(sample.thread + 1, false);
+        }
+        if (!namedUserThreads[sample.thread]) {
+          namedUserThreads[sample.thread] = true;
+          std::fprintf(out, ",\n{\"ph\":\"M\",\"pid\":%d,\"tid\":%d,\"name\":\"thread_name\",\"args\":{\"name\":\"User timings %u\"}}",
+                       PID, tid, sample.thread + 1);
+        }
+        std::fprintf(out, ",\n{\"pid\":%d,\"tid\":%d,\"ts\":%.3f,\"name\":", PID, tid, timeUs);
+        writeJsonString(out, reader.nameOf(sample.nameId));
+        if (sample.type == SessionRecordType::UserSpan) {
+          std::fprintf(out, ",\"ph\":\"X\",\"dur\":%.3f}", durationUs);
+        } else {
+          std::fprintf(out, ",\"ph\":\"i\",\"s\":\"t\"}");
+        }
+        break;
+      }
+      default:
+        break;
+    }
+  }
+
+  std::fprintf(out, "\n],\"displayTimeUnit\":\"ms\",\"otherData\":{\"startWallTimeMs\":%.0f,\"refreshRate\":%.0f,\"droppedSamples\":%llu}}\n",
+               header.startWallTimeMs, header.refreshRate, static_cast<unsigned long long>(header.droppedSamples));
+  if (std::ferror(out) != 0 || std::fflush(out) != 0) {
+    throw std::runtime_error("Cannot write trace file " + tracePath);
+  }
+  return Result{samples, header.droppedSamples};
+}
+
+} // namespace margelo::nitro::performancetoolkit
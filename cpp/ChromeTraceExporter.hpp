@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace margelo::nitro::performancetoolkit {
+
+// Converts a recorded session (see SessionFormat.hpp) into the Chrome Trace Event JSON format,
+// which ui.perfetto.dev and chrome://tracing open directly.
+//
+// Samples are streamed from the session file to the trace file one at a time, so the memory
+// use doesn't depend on the session length. The trace has one process with a "UI thread" track
+// (one slice per frame), a "JS thread" track (one slice per JS tick latency, long tasks and GC
+// pauses), counter tracks for CPU and memory and one "User timings" track per thread that set
+// marks (instant events) or spans. Timestamps are relative to the session start.
+// Free of JSI/Nitro includes, shared by the native API and the host CLI.
+class ChromeTraceExporter {
+public:
+  struct Result {
+    uint64_t samples;
+    uint64_t droppedSamples; // Lost while recording, copied from the session header
+  };
+
+  // Throws std::runtime_error if the session can't be read or the trace can't be written
+  static Result exportSession(const std::string& sessionPath, const std::string& tracePath);
+
+  // `<session path without extension>.json`
+  static std::string defaultTracePath(const std::string& sessionPath);
+};
+
+} // namespace margelo::nitro::performancetoolkit
@@ -0,0 +1,307 @@
+#include "CpuSampler.hpp"
+#include "MetricsBlock.hpp"
+#include "PlatformBridge.hpp"
+#include "SamplerRates.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#if defined(__linux__)
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#elif defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+namespace margelo::nitro::performancetoolkit {
+
+static constexpr size_t STAT_BUFFER_SIZE = 1024; // stat lines are ~300 bytes
+static constexpr uint32_t UTIME_FIELD = 14; // 1-based field numbers from proc(5)
+static constexpr uint32_t STIME_FIELD = 15;
+static constexpr uint32_t STARTTIME_FIELD = 22;
+
+static int64_t nowNs() {
+  const auto now = std::chrono::steady_clock::now().time_since_epoch();
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+}
+
+static bool startsWith(const char* value, const char* prefix) {
+  return std::strncmp(value, prefix, std::strlen(prefix)) == 0;
+}
+
+CpuSampler& CpuSampler::get() {
+  static CpuSampler instance;
+  return instance;
+}
+
+CpuSampler::CpuSampler() : _threadBuffer(ArrayBuffer::allocate(sizeof(Header) + sizeof(Record) * MAX_THREADS)) {
+  auto* bytes = _threadBuffer->data();
+  _header = new (bytes) Header{{0}, {0}, static_cast<uint32_t>(sizeof(Record)), MAX_THREADS};
+  _records = reinterpret_cast<Record*>(bytes + sizeof(Header));
+  for (uint32_t i = 0; i < MAX_THREADS; i++) {
+    new (&_records[i]) Record{{0}, {0}, {0.0}, {}};
+  }
+}
+
+CpuSampler::~CpuSampler() {
+#if defined(__linux__)
+  for (uint32_t i = 0; i < _threadCount; i++) {
+    close(_threads[i].fd);
+  }
+  if (_processFd >= 0) {
+    close(_processFd);
+  }
+#endif
+}
+
+bool CpuSampler::parseStat(const char* data, size_t length, ParsedStat& out) {
+  // "<pid> (<name>) <state> <ppid> ...", the name can contain anything so use the last ')'
+  const char* end = data + length;
+  const char* nameStart = static_cast<const char*>(std::memchr(data, '(', length));
+  if (nameStart == nullptr) {
+    return false;
+  }
+  nameStart++;
+  const char* nameEnd = nullptr;
+  for (const char* cursor = end - 1; cursor >= nameStart; cursor--) {
+    if (*cursor == ')') {
+      nameEnd = cursor;
+      break;
+    }
+  }
+  if (nameEnd == nullptr) {
+    return false;
+  }
+  const size_t nameLength = std::min<size_t>(static_cast<size_t>(nameEnd - nameStart), NAME_SIZE - 1);
+  std::memcpy(out.name, nameStart, nameLength);
+  out.name[nameLength] = '\0';
+
+  // Field 3 (state) starts after ") "
+  const char* cursor = nameEnd + 1;
+  uint32_t field = 2;
+  out.utimeTicks = 0;
+  out.stimeTicks = 0;
+  out.startTicks = 0;
+  while (cursor < end && field < STARTTIME_FIELD) {
+    while (cursor < end && *cursor == ' ') {
+      cursor++;
+    }
+    field++;
+    uint64_t value = 0;
+    while (cursor < end && *cursor != ' ' && *cursor != '\n') {
+      value = value * 10 + static_cast<uint64_t>(*cursor - '0');
+      cursor++;
+    }
+    if (field == UTIME_FIELD) {
+      out.utimeTicks = value;
+    } else if (field == STIME_FIELD) {
+      out.stimeTicks = value;
+    } else if (field == STARTTIME_FIELD) {
+      out.startTicks = value;
+    }
+  }
+  return field >= STIME_FIELD;
+}
+
+ThreadRole CpuSampler::classifyThread(const char* name, bool isMainThread) {
+  if (isMainThread) {
+    return ThreadRole::Ui;
+  }
+  if (std::strcmp(name, "mqt_js") == 0 || std::strcmp(name, "mqt_v_js") == 0) {
+    return ThreadRole::Js;
+  }
+  // Kernel truncates names to 15 characters, "mqt_native_modules" becomes "mqt_native_modu"
+  if (startsWith(name, "mqt_native_modu") || std::strcmp(name, "mqt_v_native") == 0) {
+    return ThreadRole::NativeModules;
+  }
+  if (startsWith(name, "mqt_") || startsWith(name, "hermes") || startsWith(name, "hades")) {
+    return ThreadRole::ReactBackground;
+  }
+  return ThreadRole::Other;
+}
+
+#if defined(__linux__)
+
+static bool readStat(int fd, CpuSampler::ParsedStat& out) {
+  char data[STAT_BUFFER_SIZE];
+  const ssize_t length = pread(fd, data, sizeof(data), 0);
+  if (length <= 0) {
+    return false;
+  }
+  return CpuSampler::parseStat(data, static_cast<size_t>(length), out);
+}
+
+bool CpuSampler::start() {
+  std::call_once(_started, [this]() {
+    _processFd = open("/proc/self/stat", O_RDONLY | O_CLOEXEC);
+    if (_processFd < 0) {
+      return;
+    }
+    _supported = true;
+    _pid = static_cast<int32_t>(getpid());
+    const long ticksPerSecond = sysconf(_SC_CLK_TCK);
+    if (ticksPerSecond > 0) {
+      _ticksPerSecond = static_cast<double>(ticksPerSecond);
+    }
+
+    // First sample only sets the baseline
+    sample();
+    SamplerRates::get().schedule(SamplerKind::Cpu, [this]() { sample(); });
+  });
+  return _supported;
+}
+
+void CpuSampler::rescanThreads() {
+  DIR* directory = opendir("/proc/self/task");
+  if (directory == nullptr) {
+    return;
+  }
+  while (dirent* entry = readdir(directory)) {
+    if (entry->d_name[0] < '0' || entry->d_name[0] > '9') {
+      continue; // "." and ".."
+    }
+    const auto tid = static_cast<int32_t>(std::strtol(entry->d_name, nullptr, 10));
+    bool known = false;
+    for (uint32_t i = 0; i < _threadCount; i++) {
+      if (_threads[i].tid == tid) {
+        known = true;
+        break;
+      }
+    }
+    if (known || _threadCount >= MAX_THREADS) {
+      continue;
+    }
+    char path[64];
+    std::snprintf(path, sizeof(path), "/proc/self/task/%d/stat", tid);
+    const int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd >= 0) {
+      _threads[_threadCount++] = ThreadState{tid, fd, 0, false};
+    }
+  }
+  closedir(directory);
+}
+
+void CpuSampler::sample() {
+  const int64_t sampleNs = nowNs();
+  const double elapsedSeconds = _lastSampleNs != 0 ? static_cast<double>(sampleNs - _lastSampleNs) / 1e9 : 0.0;
+  const auto toPercent = [this, elapsedSeconds](uint64_t deltaTicks) {
+    return elapsedSeconds > 0.0 ? static_cast<double>(deltaTicks) / _ticksPerSecond / elapsedSeconds * 100.0 : 0.0;
+  };
+
+  ParsedStat stat{};
+  if (readStat(_processFd, stat)) {
+    const uint64_t ticks = stat.utimeTicks + stat.stimeTicks;
+    if (elapsedSeconds > 0.0) {
+      const double percent = std::round(toPercent(ticks - _lastProcessTicks));
+      _cpuUsageCell = static_cast<int32_t>(percent);
+      PlatformBridge::recordCpuUsage(percent);
+    }
+    _lastProcessTicks = ticks;
+  }
+
+  if (_threadCount == 0 || ++_samplesSinceRescan >= RESCAN_EVERY_SAMPLES) {
+    _samplesSinceRescan = 0;
+    rescanThreads();
+  }
+
+  double jsThreadUsage = 0.0;
+  double uiThreadUsage = 0.0;
+
+  const uint32_t sequence = _header->sequence.load(std::memory_order_relaxed);
+  _header->sequence.store(sequence + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  uint32_t written = 0;
+  for (uint32_t i = 0; i < _threadCount;) {
+    ThreadState& thread = _threads[i];
+    if (!readStat(thread.fd, stat)) {
+      // Thread exited, swap-remove it
+      close(thread.fd);
+      thread = _threads[--_threadCount];
+      continue;
+    }
+    const uint64_t ticks = stat.utimeTicks + stat.stimeTicks;
+    const double usage = thread.hasPrevious ? toPercent(ticks - thread.lastTicks) : 0.0;
+    thread.lastTicks = ticks;
+    thread.hasPrevious = true;
+
+    const ThreadRole role = classifyThread(stat.name, thread.tid == _pid);
+    if (role == ThreadRole::Js) {
+      jsThreadUsage = usage;
+    } else if (role == ThreadRole::Ui) {
+      uiThreadUsage = usage;
+    }
+
+    Record& record = _records[written++];
+    record.tid.store(thread.tid, std::memory_order_relaxed);
+    record.role.store(static_cast<uint32_t>(role), std::memory_order_relaxed);
+    record.cpuUsage.store(usage, std::memory_order_relaxed);
+    std::memcpy(record.name, stat.name, NAME_SIZE);
+    i++;
+  }
+  _header->threadCount.store(written, std::memory_order_relaxed);
+  _header->sequence.store(sequence + 2, std::memory_order_release);
+
+  if (elapsedSeconds > 0.0) {
+    MetricsBlock::get().publish({
+      {MetricSlot::JsThreadCpuUsage, jsThreadUsage},
+      {MetricSlot::UiThreadCpuUsage, uiThreadUsage},
+    });
+  }
+  _lastSampleNs = sampleNs;
+}
+
+#elif defined(__APPLE__)
+
+// No procfs: process CPU time from getrusage (microseconds, used as ticks), no per-thread breakdown
+bool CpuSampler::start() {
+  std::call_once(_started, [this]() {
+    _supported = true;
+    _ticksPerSecond = 1'000'000.0;
+    sample();
+    SamplerRates::get().schedule(SamplerKind::Cpu, [this]() { sample(); });
+  });
+  return _supported;
+}
+
+void CpuSampler::rescanThreads() {}
+
+void CpuSampler::sample() {
+  rusage usage{};
+  if (getrusage(RUSAGE_SELF, &usage) != 0) {
+    return;
+  }
+  const auto toMicros = [](const timeval& time) {
+    return static_cast<uint64_t>(time.tv_sec) * 1'000'000 + static_cast<uint64_t>(time.tv_usec);
+  };
+  const int64_t sampleNs = nowNs();
+  const uint64_t ticks = toMicros(usage.ru_utime) + toMicros(usage.ru_stime);
+  if (_lastSampleNs != 0 && sampleNs > _lastSampleNs) {
+    const double elapsedSeconds = static_cast<double>(sampleNs - _lastSampleNs) / 1e9;
+    const double percent = std::round(static_cast<double>(ticks - _lastProcessTicks) / _ticksPerSecond / elapsedSeconds * 100.0);
+    _cpuUsageCell = static_cast<int32_t>(percent);
+    PlatformBridge::recordCpuUsage(percent);
+  }
+  _lastProcessTicks = ticks;
+  _lastSampleNs = sampleNs;
+}
+
+#else
+
+bool CpuSampler::start() {
+  return false; // Unsupported platform, the CPU buffer stays at 0
+}
+
+void CpuSampler::rescanThreads() {}
+
+void CpuSampler::sample() {}
+
+#endif
+
+} // namespace margelo::nitro::performancetoolkit
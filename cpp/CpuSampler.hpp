@@ -0,0 +1,124 @@
+#pragma once
+
+#include <NitroModules/ArrayBuffer.hpp>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+namespace margelo::nitro::performancetoolkit {
+
+using namespace margelo::nitro;
+
+enum class ThreadRole : uint32_t {
+  Other = 0,
+  Ui,              // Main thread
+  Js,              // mqt_js / mqt_v_js
+  NativeModules,   // mqt_native_modules / mqt_v_native
+  ReactBackground, // Other React Native / Hermes owned threads
+};
+
+// Process and per-thread CPU usage from procfs (Linux/Android). On Apple platforms only the process
+// usage is sampled, from getrusage, elsewhere this is a no-op.
+//
+// Samples run on the TrackerScheduler thread. `/proc/self/stat` and every
+// `/proc/self/task/<tid>/stat` stay open and are re-read with pread, parsing works on a stack
+// buffer, so a steady state sample doesn't allocate. The task list is rescanned every few samples
+// to pick up new threads, threads that exited are dropped when their stat stops being readable.
+//
+// Per-thread usage is published in its own ArrayBuffer (see src/threadCpuUsage.ts for the reader):
+//
+//   Header (16 bytes)
+//     0  uint32   sequence    - seqlock, odd while a sample is being written
+//     4  uint32   threadCount - number of valid records
+//     8  uint32   recordSize  - size of one record in bytes
+//    12  uint32   capacity    - number of record slots
+//   Records (capacity * 40 bytes)
+//     0  int32    tid
+//     4  uint32   role        - ThreadRole
+//     8  float64  cpuUsage    - percent of one core since the previous sample
+//    16  char[24] name        - NUL terminated thread name
+class CpuSampler {
+public:
+  static constexpr uint32_t SAMPLE_INTERVAL_MS = 500; // Default period, see SamplerRates
+  static constexpr uint32_t RESCAN_EVERY_SAMPLES = 4; // Look for new threads every 2 seconds at the default period
+  static constexpr uint32_t MAX_THREADS = 256;
+  static constexpr size_t NAME_SIZE = 24; // Kernel thread names are at most 15 characters
+
+  struct ParsedStat {
+    char name[NAME_SIZE];
+    uint64_t utimeTicks;
+    uint64_t stimeTicks;
+    uint64_t startTicks; // Clock ticks after boot the process (or thread) started, 0 if the line ends before it
+  };
+
+  struct Header {
+    std::atomic<uint32_t> sequence;
+    std::atomic<uint32_t> threadCount;
+    uint32_t recordSize;
+    uint32_t capacity;
+  };
+
+  struct Record {
+    std::atomic<int32_t> tid;
+    std::atomic<uint32_t> role;
+    std::atomic<double> cpuUsage;
+    char name[NAME_SIZE];
+  };
+
+  static_assert(sizeof(Header) == 16, "Header layout is shared with JS");
+  static_assert(sizeof(Record) == 40, "Record layout is shared with JS");
+
+  static CpuSampler& get();
+
+  // Starts sampling on the first call, returns false where procfs isn't available
+  bool start();
+
+  // Parses the contents of a `stat` file, the name may contain spaces and parentheses
+  static bool parseStat(const char* data, size_t length, ParsedStat& out);
+  static ThreadRole classifyThread(const char* name, bool isMainThread);
+
+  // Process CPU usage (percent of one core) as int32, the legacy 4 byte buffer layout
+  int32_t* getCpuUsageCell() {
+    return &_cpuUsageCell;
+  }
+
+  const std::shared_ptr<ArrayBuffer>& getThreadBuffer() const {
+    return _threadBuffer;
+  }
+
+private:
+  CpuSampler();
+  ~CpuSampler();
+
+  struct ThreadState {
+    int32_t tid = 0;
+    int fd = -1;
+    uint64_t lastTicks = 0;
+    bool hasPrevious = false;
+  };
+
+  void sample();
+  void rescanThreads();
+
+  std::once_flag _started;
+  bool _supported = false;
+  int _processFd = -1;
+  int32_t _pid = 0;
+  double _ticksPerSecond = 100.0;
+  uint64_t _lastProcessTicks = 0;
+  int64_t _lastSampleNs = 0;
+  uint32_t _samplesSinceRescan = 0;
+
+  std::array<ThreadState, MAX_THREADS> _threads{};
+  uint32_t _threadCount = 0;
+  alignas(4) int32_t _cpuUsageCell = 0;
+
+  std::shared_ptr<ArrayBuffer> _threadBuffer;
+  Header* _header;
+  Record* _records;
+};
+
+} // namespace margelo::nitro::performancetoolkit
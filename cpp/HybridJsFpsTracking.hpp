@@ -5,7 +5,7 @@
 
 namespace margelo::nitro::performancetoolkit {
 
-class JsFpsTracker;
+class RuntimeTrackers;
 
 class HybridJsFpsTracking : public HybridJsFpsTrackingSpec {
 public:
@@ -13,10 +13,26 @@ public:
   ~HybridJsFpsTracking() override;
 
   std::shared_ptr<ArrayBuffer> getJsFpsBuffer() override;
+  std::shared_ptr<ArrayBuffer> getJsDroppedFramesBuffer() override;
+  std::shared_ptr<ArrayBuffer> getJsFrameTimelineBuffer() override;
+  std::shared_ptr<ArrayBuffer> getJsLagEventsBuffer() override;
+  void setTrackingMode(JsFpsTrackingMode mode) override;
+  JsFpsTrackingMode getTrackingMode() override;
+  void setLongTaskThreshold(double thresholdMs) override;
+  std::vector<LongTask> drainLongTasks() override;
+  std::shared_ptr<ArrayBuffer> getRuntimeFpsBuffer() override;
+  std::vector<std::string> getTrackedRuntimes() override;
+  void unregisterRuntime(const std::string& name) override;
+
+  // Raw JSI method, registers the runtime it is called on (a worklet on the UI thread) as "ui"
+  jsi::Value registerUiRuntime(jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* args, size_t count);
+
+protected:
+  void loadHybridMethods() override;
 
 private:
-  std::shared_ptr<JsFpsTracker> _tracker;
-  std::shared_ptr<ArrayBuffer> _fpsBuffer;
+  // Started process-wide trackers, they outlive this object and follow the runtimes across reloads
+  static RuntimeTrackers& trackers();
 };
 
 } // namespace margelo::nitro::performancetoolkit
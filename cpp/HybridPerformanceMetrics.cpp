@@ -0,0 +1,312 @@
+#include "HybridPerformanceMetrics.hpp"
+#include "AlertRules.hpp"
+#include "ChromeTraceExporter.hpp"
+#include "CpuSampler.hpp"
+#include "JsHeapSampler.hpp"
+#include "MetricHistograms.hpp"
+#include "MetricsBlock.hpp"
+#include "MetricsSubscriptions.hpp"
+#include "RuntimeBridge.hpp"
+#include "SamplingProfiles.hpp"
+#include "SessionRecorder.hpp"
+#include "StartupTracer.hpp"
+#include "ToolkitOverhead.hpp"
+#include "TrackerScheduler.hpp"
+#include "UserTimings.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <utility>
+
+namespace margelo::nitro::performancetoolkit {
+
+static Percentiles toPercentiles(HistogramMetric metric, uint32_t windowSeconds) {
+  const HistogramSnapshot snapshot = MetricHistograms::get().snapshot(metric, windowSeconds);
+  // Histograms bucket scaled integers, convert back to the metric's unit
+  const double scale = MetricHistograms::scaleOf(metric);
+  return Percentiles(
+    static_cast<double>(snapshot.getValueAtPercentile(50.0)) / scale,
+    static_cast<double>(snapshot.getValueAtPercentile(90.0)) / scale,
+    static_cast<double>(snapshot.getValueAtPercentile(99.0)) / scale,
+    static_cast<double>(snapshot.getMax()) / scale,
+    static_cast<double>(snapshot.getTotalCount())
+  );
+}
+
+HybridPerformanceMetrics::HybridPerformanceMetrics() : HybridObject(TAG) {}
+
+std::shared_ptr<ArrayBuffer> HybridPerformanceMetrics::getMetricsBuffer() {
+  // JS heap stats are only sampled while someone reads the block, retried on the next call if the runtime isn't ready yet
+  JsHeapSampler::get().start();
+  ToolkitOverhead::get().start();
+  SamplingProfiles::get(); // Publishes the counter update interval of the initial profile
+  return MetricsBlock::get().getBuffer();
+}
+
+std::shared_ptr<ArrayBuffer> HybridPerformanceMetrics::getThreadCpuUsageBuffer() {
+  // Stays empty where per-thread sampling isn't supported
+  CpuSampler::get().start();
+  return CpuSampler::get().getThreadBuffer();
+}
+
+MetricPercentiles HybridPerformanceMetrics::getMetricPercentiles(double windowSeconds) {
+  const auto window = static_cast<uint32_t>(std::clamp(std::round(windowSeconds), 1.0, static_cast<double>(MetricHistograms::MAX_WINDOW_SECONDS)));
+  return MetricPercentiles(
+    toPercentiles(HistogramMetric::JsLatency, window),
+    toPercentiles(HistogramMetric::JsFps, window),
+    toPercentiles(HistogramMetric::UiFps, window),
+    toPercentiles(HistogramMetric::CpuUsage, window),
+    toPercentiles(HistogramMetric::MemoryUsage, window),
+    toPercentiles(HistogramMetric::UiFrameTime, window)
+  );
+}
+
+std::shared_ptr<Promise<std::string>> HybridPerformanceMetrics::startSessionRecording(const std::optional<std::string>& path) {
+  // Creating the file and allocating its first chunk is disk I/O, keep it off the JS thread
+  return Promise<std::string>::async([path]() {
+    return SessionRecorder::get().start(path);
+  });
+}
+
+std::shared_ptr<Promise<std::optional<std::string>>> HybridPerformanceMetrics::stopSessionRecording() {
+  // Joins the writer, which drains the queue and truncates the file first
+  return Promise<std::optional<std::string>>::async([]() {
+    return SessionRecorder::get().stop();
+  });
+}
+
+std::shared_ptr<Promise<std::string>> HybridPerformanceMetrics::exportSessionTrace(const std::string& sessionPath, const std::optional<std::string>& tracePath) {
+  // Streams the whole session, can take a while for long sessions so keep it off the JS thread
+  return Promise<std::string>::async([sessionPath, tracePath]() {
+    const std::string outputPath = tracePath.value_or(ChromeTraceExporter::defaultTracePath(sessionPath));
+    ChromeTraceExporter::exportSession(sessionPath, outputPath);
+    return outputPath;
+  });
+}
+
+double HybridPerformanceMetrics::internTimingName(const std::string& name) {
+  return static_cast<double>(UserTimings::get().intern(name));
+}
+
+void HybridPerformanceMetrics::mark(double nameId) {
+  UserTimings::get().mark(static_cast<uint32_t>(nameId));
+}
+
+void HybridPerformanceMetrics::beginSpan(double nameId) {
+  UserTimings::get().beginSpan(static_cast<uint32_t>(nameId));
+}
+
+void HybridPerformanceMetrics::endSpan(double nameId) {
+  UserTimings::get().endSpan(static_cast<uint32_t>(nameId));
+}
+
+double HybridPerformanceMetrics::addMetricsListener(const std::function<void(double)>& listener, const std::optional<std::vector<double>>& minChanges) {
+  // Nitro dispatches the call to the runtime that created the callback
+  const auto id = MetricsSubscriptions::get().add(
+    [listener](uint32_t changedSlots) { listener(static_cast<double>(changedSlots)); },
+    minChanges.value_or(std::vector<double>{})
+  );
+  return static_cast<double>(id);
+}
+
+// Global function of the worklets UI runtime that gets the changed slots, set by src/hooks/uiThreadHooks.ts
+static constexpr const char* UI_METRICS_CALLBACK = "__performanceToolkitOnMetricsChange";
+
+// Posts metric changes to the runtime registered as "ui", batched to at most one post per counter
+// update interval of the sampling profile. Only runs on the scheduler thread (subscription
+// deliveries and its own flush), so it needs no locks
+class UiMetricsForwarder : public std::enable_shared_from_this<UiMetricsForwarder> {
+public:
+  void onChanged(uint32_t changedSlots) {
+    _pendingSlots |= changedSlots;
+    if (_flushScheduled) {
+      return;
+    }
+    // While the profile pauses the counters nothing is posted, publishing a new interval is a change too
+    const double intervalMs = MetricsBlock::get().read(MetricSlot::CounterUpdateIntervalMs);
+    if (!(intervalMs > 0.0)) {
+      return;
+    }
+    const auto interval = std::chrono::duration_cast<TrackerScheduler::Clock::duration>(std::chrono::duration<double, std::milli>(intervalMs));
+    const auto now = TrackerScheduler::get().now();
+    if (now - _lastPost >= interval) {
+      post(now);
+      return;
+    }
+    _flushScheduled = true;
+    std::weak_ptr<UiMetricsForwarder> weakSelf = weak_from_this();
+    TrackerScheduler::get().schedule(_lastPost + interval - now, [weakSelf]() -> std::optional<TrackerScheduler::Clock::duration> {
+      // Gone once the listener was removed
+      if (auto self = weakSelf.lock()) {
+        self->_flushScheduled = false;
+        self->post(TrackerScheduler::get().now());
+      }
+      return std::nullopt;
+    });
+  }
+
+private:
+  void post(TrackerScheduler::Clock::time_point now) {
+    _lastPost = now;
+    const uint32_t changedSlots = std::exchange(_pendingSlots, 0);
+    // Dropped while no UI runtime is registered, the counters read the whole block once it is
+    ToolkitOverhead::get().addJsTask();
+    _executor([changedSlots](jsi::Runtime& runtime) {
+      ToolkitOverhead::ScopedTimer timer(ToolkitOverhead::TimedWork::JsTask);
+      ToolkitOverhead::get().addJsiCalls();
+      jsi::Value callback = runtime.global().getProperty(runtime, UI_METRICS_CALLBACK);
+      if (callback.isObject() && callback.getObject(runtime).isFunction(runtime)) {
+        ToolkitOverhead::get().addJsiCalls();
+        callback.getObject(runtime).asFunction(runtime).call(runtime, static_cast<double>(changedSlots));
+      }
+    });
+  }
+
+  RuntimeExecutor _executor = RuntimeBridgeState::get().getBoundExecutor(RuntimeBridgeState::UI_RUNTIME_NAME);
+  uint32_t _pendingSlots = 0;
+  TrackerScheduler::Clock::time_point _lastPost{};
+  bool _flushScheduled = false;
+};
+
+double HybridPerformanceMetrics::addUiMetricsListener() {
+  // Nitro can't dispatch callbacks to the worklets UI runtime, changes go through its "ui" registration
+  auto forwarder = std::make_shared<UiMetricsForwarder>();
+  const auto id = MetricsSubscriptions::get().add(
+    [forwarder](uint32_t changedSlots) { forwarder->onChanged(changedSlots); },
+    std::vector<double>{}
+  );
+  return static_cast<double>(id);
+}
+
+void HybridPerformanceMetrics::removeMetricsListener(double listenerId) {
+  MetricsSubscriptions::get().remove(static_cast<MetricsSubscriptions::ListenerId>(listenerId));
+}
+
+static AlertRules::Condition toCondition(AlertCondition condition) {
+  switch (condition) {
+    case AlertCondition::ABOVE:
+      return AlertRules::Condition::Above;
+    case AlertCondition::BELOW:
+      return AlertRules::Condition::Below;
+    case AlertCondition::SLOPE_ABOVE:
+      return AlertRules::Condition::SlopeAbove;
+    case AlertCondition::SLOPE_BELOW:
+      return AlertRules::Condition::SlopeBelow;
+  }
+  return AlertRules::Condition::Above;
+}
+
+double HybridPerformanceMetrics::addAlertRule(const AlertRule& rule, const std::function<void(const Alert&)>& onAlert) {
+  if (!(rule.metric >= 0.0 && rule.metric < static_cast<double>(MetricSlot::Count))) {
+    throw std::runtime_error("Unknown metric slot " + std::to_string(rule.metric));
+  }
+  if (std::isnan(rule.threshold)) {
+    throw std::runtime_error("Alert threshold must be a number");
+  }
+  const AlertRules::Rule nativeRule{
+    static_cast<MetricSlot>(static_cast<uint32_t>(rule.metric)),
+    toCondition(rule.condition),
+    rule.threshold,
+    rule.forMs.value_or(0.0),
+    static_cast<uint32_t>(std::clamp(rule.forSamples.value_or(0.0), 0.0, static_cast<double>(UINT32_MAX))),
+  };
+  // Nitro dispatches the call to the runtime that created the callback, the sampler never waits for JS
+  const auto id = AlertRules::get().add(nativeRule, [onAlert](const AlertRules::Firing& firing) {
+    std::vector<double> values;
+    std::vector<double> timestampsMs;
+    values.reserve(firing.window.size());
+    timestampsMs.reserve(firing.window.size());
+    for (const auto& sample : firing.window) {
+      values.push_back(sample.value);
+      timestampsMs.push_back(sample.timestampMs);
+    }
+    onAlert(Alert(
+      static_cast<double>(firing.ruleId),
+      static_cast<double>(firing.metric),
+      firing.value,
+      firing.startedAtMs,
+      firing.firedAtMs,
+      std::move(values),
+      std::move(timestampsMs)
+    ));
+  });
+  return static_cast<double>(id);
+}
+
+void HybridPerformanceMetrics::removeAlertRule(double ruleId) {
+  AlertRules::get().remove(static_cast<AlertRules::RuleId>(ruleId));
+}
+
+OverheadStats HybridPerformanceMetrics::getOverheadStats() {
+  ToolkitOverhead::get().start();
+  const ToolkitOverhead::Totals totals = ToolkitOverhead::get().totals();
+  const auto toMs = [](int64_t ns) { return static_cast<double>(ns) / 1'000'000.0; };
+  const auto now = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+  return OverheadStats(
+    toMs(totals.schedulerCpuNs),
+    toMs(totals.sessionWriterCpuNs),
+    toMs(totals.jsTaskNs),
+    toMs(totals.uiFrameNs),
+    static_cast<double>(totals.jsTasks),
+    static_cast<double>(totals.wakeups),
+    static_cast<double>(totals.jsiCalls),
+    totals.measuredSinceNs != 0 ? toMs(now - totals.measuredSinceNs) : 0.0
+  );
+}
+
+// Negative and NaN mean off, like 0
+static uint32_t toIntervalMs(double intervalMs) {
+  return intervalMs > 0.0 ? static_cast<uint32_t>(std::min(std::round(intervalMs), static_cast<double>(UINT32_MAX))) : 0;
+}
+
+static SamplingConfig toSamplingConfig(const SamplingProfiles::Settings& settings) {
+  return SamplingConfig(
+    settings.profile,
+    static_cast<double>(settings.jsFpsWindowMs),
+    static_cast<double>(settings.uiFpsWindowMs),
+    static_cast<double>(settings.cpuIntervalMs),
+    static_cast<double>(settings.memoryIntervalMs),
+    static_cast<double>(settings.jsHeapIntervalMs),
+    static_cast<double>(settings.counterUpdateIntervalMs),
+    settings.frameTimeline
+  );
+}
+
+SamplingConfig HybridPerformanceMetrics::setSamplingProfile(SamplingProfile profile, const std::optional<SamplingOverrides>& overrides) {
+  SamplingProfiles::Settings settings = SamplingProfiles::defaults(profile);
+  if (overrides.has_value()) {
+    const auto overrideMs = [](uint32_t& target, const std::optional<double>& value) {
+      if (value.has_value()) {
+        target = toIntervalMs(*value);
+      }
+    };
+    overrideMs(settings.jsFpsWindowMs, overrides->jsFpsWindowMs);
+    overrideMs(settings.uiFpsWindowMs, overrides->uiFpsWindowMs);
+    overrideMs(settings.cpuIntervalMs, overrides->cpuIntervalMs);
+    overrideMs(settings.memoryIntervalMs, overrides->memoryIntervalMs);
+    overrideMs(settings.jsHeapIntervalMs, overrides->jsHeapIntervalMs);
+    overrideMs(settings.counterUpdateIntervalMs, overrides->counterUpdateIntervalMs);
+    settings.frameTimeline = overrides->frameTimeline.value_or(settings.frameTimeline);
+  }
+  return toSamplingConfig(SamplingProfiles::get().apply(settings));
+}
+
+SamplingConfig HybridPerformanceMetrics::getSamplingConfig() {
+  return toSamplingConfig(SamplingProfiles::get().getSettings());
+}
+
+StartupTimeline HybridPerformanceMetrics::getStartupTimeline() {
+  const StartupTracer& tracer = StartupTracer::get();
+  return StartupTimeline(
+    tracer.getMs(StartupMilestone::ProcessStart),
+    tracer.getMs(StartupMilestone::NativeLibraryLoaded),
+    tracer.getMs(StartupMilestone::RuntimeCreated),
+    tracer.getMs(StartupMilestone::BindingsInstalled),
+    tracer.getMs(StartupMilestone::FirstJsTick),
+    tracer.getMs(StartupMilestone::FirstUiFrame)
+  );
+}
+
+} // namespace margelo::nitro::performancetoolkit
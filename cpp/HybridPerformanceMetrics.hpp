@@ -0,0 +1,34 @@
+#pragma once
+
+#include "HybridPerformanceMetricsSpec.hpp"
+
+namespace margelo::nitro::performancetoolkit {
+
+// Cross-metric native views (histograms, ...) implemented in shared C++
+class HybridPerformanceMetrics : public HybridPerformanceMetricsSpec {
+public:
+  HybridPerformanceMetrics();
+  ~HybridPerformanceMetrics() override = default;
+
+  std::shared_ptr<ArrayBuffer> getMetricsBuffer() override;
+  std::shared_ptr<ArrayBuffer> getThreadCpuUsageBuffer() override;
+  MetricPercentiles getMetricPercentiles(double windowSeconds) override;
+  std::shared_ptr<Promise<std::string>> startSessionRecording(const std::optional<std::string>& path) override;
+  std::shared_ptr<Promise<std::optional<std::string>>> stopSessionRecording() override;
+  std::shared_ptr<Promise<std::string>> exportSessionTrace(const std::string& sessionPath, const std::optional<std::string>& tracePath) override;
+  double internTimingName(const std::string& name) override;
+  void mark(double nameId) override;
+  void beginSpan(double nameId) override;
+  void endSpan(double nameId) override;
+  double addMetricsListener(const std::function<void(double)>& listener, const std::optional<std::vector<double>>& minChanges) override;
+  double addUiMetricsListener() override;
+  void removeMetricsListener(double listenerId) override;
+  double addAlertRule(const AlertRule& rule, const std::function<void(const Alert&)>& onAlert) override;
+  void removeAlertRule(double ruleId) override;
+  OverheadStats getOverheadStats() override;
+  SamplingConfig setSamplingProfile(SamplingProfile profile, const std::optional<SamplingOverrides>& overrides) override;
+  SamplingConfig getSamplingConfig() override;
+  StartupTimeline getStartupTimeline() override;
+};
+
+} // namespace margelo::nitro::performancetoolkit
@@ -0,0 +1,487 @@
+#include "JsFpsTracker.hpp"
+#include "JsFrameTimeline.hpp"
+#include "JsHeapSampler.hpp"
+#include "JsLagEvents.hpp"
+#include "LongTaskRecorder.hpp"
+#include "MetricHistograms.hpp"
+#include "MetricsBlock.hpp"
+#include "RuntimeBridge.hpp"
+#include "SamplerRates.hpp"
+#include "SessionRecorder.hpp"
+#include "ToolkitOverhead.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace margelo::nitro::performancetoolkit {
+
+JsFpsTracker::JsFpsTracker(
+    Writer writer,
+    std::shared_ptr<JsFrameTimeline> timeline,
+    std::shared_ptr<JsLagEvents> lagEvents,
+    std::shared_ptr<LongTaskRecorder> longTasks,
+    RuntimeExecutor executor,
+    JsFpsTrackingMode mode,
+    bool isMainRuntime,
+    TrackerScheduler& scheduler)
+    : _scheduler(scheduler),
+      _writer(std::move(writer)),
+      _timeline(std::move(timeline)),
+      _lagEvents(std::move(lagEvents)),
+      _longTasks(std::move(longTasks)),
+      _executor(std::move(executor)),
+      _mode(mode),
+      _windowNs(static_cast<long long>(FPS_WINDOW_MS * 1'000'000.0)),
+      _timelineEnabled(true),
+      _isMainRuntime(isMainRuntime),
+      _framesInWindow(0),
+      _maxLatencyNsInWindow(0),
+      _stallNsInWindow(0),
+      _windowStartNs(0),
+      _lastJsTickNs(0),
+      _pendingScheduledNs(0),
+      _probeBackoffNs(0),
+      _running(true),
+      _taskPending(false),
+      _probeGeneration(0) {}
+
+JsFpsTracker::~JsFpsTracker() {
+  stop();
+}
+
+void JsFpsTracker::start() {
+  _windowStartNs = nowNs();
+  _slidingWindow.reset(_windowStartNs.load());
+  startProbing();
+  startReportingLoop(); // Low-frequency FPS reporting
+  if (_isMainRuntime) {
+    startAveragesLoop();
+  }
+}
+
+void JsFpsTracker::stop() {
+  _running = false;
+  stopProbing();
+  stopReportingLoop();
+  stopAveragesLoop();
+}
+
+void JsFpsTracker::setMode(JsFpsTrackingMode mode) {
+  if (mode == _mode) {
+    return;
+  }
+  stopProbing();
+  _mode = mode;
+  // Frame counts and stall time don't mix, averages start over with what the new mode measures
+  _slidingWindow.reset(nowNs());
+  if (_running.load()) {
+    startProbing();
+  }
+}
+
+void JsFpsTracker::setWindowMs(double windowMs) {
+  const auto windowNs = static_cast<long long>(windowMs * 1'000'000.0);
+  if (windowNs <= 0 || _windowNs.exchange(windowNs) == windowNs) {
+    return;
+  }
+  // Cut the current window short, report() measures the window it actually got
+  if (_reportingTask != 0) {
+    _scheduler.reschedule(_reportingTask, Clock::duration::zero());
+  }
+}
+
+void JsFpsTracker::setTimelineEnabled(bool enabled) {
+  _timelineEnabled = enabled;
+}
+
+void JsFpsTracker::onRuntimeReplaced() {
+  _probeGeneration.fetch_add(1);
+  _pendingScheduledNs = 0;
+  _taskPending = false;
+}
+
+SlidingFpsWindow::Averages JsFpsTracker::getAverages() const {
+  const bool stallBased = _mode == JsFpsTrackingMode::ON_DEMAND;
+  long long pendingStallFromNs = 0;
+  const long long pendingScheduledNs = _pendingScheduledNs.load();
+  if (stallBased && _taskPending.load() && pendingScheduledNs != 0) {
+    pendingStallFromNs = pendingScheduledNs + toNs(frameInterval());
+  }
+  return _slidingWindow.compute(nowNs(), stallBased, RuntimeBridgeState::get().getDeviceRefreshRate(), pendingStallFromNs);
+}
+
+void JsFpsTracker::startProbing() {
+  if (_mode == JsFpsTrackingMode::CONTINUOUS) {
+    startFramePacingLoop(); // High-frequency frame counting
+  } else {
+    startOnDemandProbing(); // Probes driven by UI frames or adaptive back-off
+  }
+}
+
+void JsFpsTracker::stopProbing() {
+  stopFramePacingLoop();
+  stopOnDemandProbing();
+}
+
+void JsFpsTracker::startFramePacingLoop() {
+  if (_framePacingTask != 0) {
+    return;
+  }
+
+  std::weak_ptr<JsFpsTracker> weakSelf = shared_from_this();
+  _framePacingTask = _scheduler.schedule(frameInterval(), [weakSelf]() -> std::optional<Clock::duration> {
+    auto self = weakSelf.lock();
+    if (!self || !self->_running.load()) {
+      return std::nullopt;
+    }
+
+    // ONLY post a task to JS - no calculations here
+    self->scheduleNextFrame();
+    // Re-read every frame so pacing follows refresh rate switches
+    return self->frameInterval();
+  });
+}
+
+void JsFpsTracker::stopFramePacingLoop() {
+  if (_framePacingTask != 0) {
+    _scheduler.cancel(_framePacingTask);
+    _framePacingTask = 0;
+  }
+}
+
+// On-demand mode: nothing wakes up just to probe. While the native UI frame source is producing
+// frames, every frame arms a probe (deduplicated by _taskPending). When there are no frames, a
+// back-off task probes at the frame interval while the JS thread is busy and doubles the delay
+// up to PROBE_MAX_BACKOFF_MS while it is idle.
+void JsFpsTracker::startOnDemandProbing() {
+  if (_backoffTask != 0) {
+    return;
+  }
+
+  std::weak_ptr<JsFpsTracker> weakSelf = shared_from_this();
+  _frameListener = UiFrameSource::get().addListener([weakSelf](int64_t) {
+    if (auto self = weakSelf.lock()) {
+      self->scheduleNextFrame();
+    }
+  });
+
+  _probeBackoffNs = toNs(frameInterval());
+  _backoffTask = _scheduler.schedule(std::chrono::nanoseconds(_probeBackoffNs.load()), [weakSelf]() -> std::optional<Clock::duration> {
+    auto self = weakSelf.lock();
+    if (!self || !self->_running.load()) {
+      return std::nullopt;
+    }
+
+    const long long lastFrameNs = UiFrameSource::get().getLastFrameNs();
+    const bool frameSourceActive = lastFrameNs != 0 &&
+      (self->nowNs() - lastFrameNs) < static_cast<long long>(FRAME_SOURCE_IDLE_MS * 1'000'000.0);
+    if (frameSourceActive) {
+      // Frames arm the probes, only check back occasionally in case they stop
+      return std::chrono::nanoseconds(static_cast<long long>(PROBE_MAX_BACKOFF_MS * 1'000'000.0));
+    }
+
+    self->scheduleNextFrame();
+    return std::chrono::nanoseconds(self->_probeBackoffNs.load());
+  });
+}
+
+void JsFpsTracker::stopOnDemandProbing() {
+  if (_frameListener != 0) {
+    UiFrameSource::get().removeListener(_frameListener);
+    _frameListener = 0;
+  }
+  if (_backoffTask != 0) {
+    _scheduler.cancel(_backoffTask);
+    _backoffTask = 0;
+  }
+}
+
+void JsFpsTracker::startReportingLoop() {
+  if (_reportingTask != 0) {
+    return;
+  }
+
+  std::weak_ptr<JsFpsTracker> weakSelf = shared_from_this();
+  // Reporting task runs only once per window (1 second by default)
+  _reportingTask = _scheduler.schedule(window(), [weakSelf]() -> std::optional<Clock::duration> {
+    auto self = weakSelf.lock();
+    if (!self || !self->_running.load()) {
+      return std::nullopt;
+    }
+    self->report();
+    // Re-read every window so a changed window applies from the next one
+    return self->window();
+  });
+}
+
+void JsFpsTracker::stopReportingLoop() {
+  if (_reportingTask != 0) {
+    _scheduler.cancel(_reportingTask);
+    _reportingTask = 0;
+  }
+}
+
+void JsFpsTracker::startAveragesLoop() {
+  if (_averagesTask != 0) {
+    return;
+  }
+
+  std::weak_ptr<JsFpsTracker> weakSelf = shared_from_this();
+  const auto slot = std::chrono::milliseconds(SlidingFpsWindow::SLOT_MS);
+  // Aligned to slot boundaries, so every run sees the slot that just completed
+  _averagesTask = _scheduler.schedule(slot, [weakSelf, slot]() -> std::optional<Clock::duration> {
+    auto self = weakSelf.lock();
+    if (!self || !self->_running.load()) {
+      return std::nullopt;
+    }
+    const SlidingFpsWindow::Averages averages = self->getAverages();
+    MetricsBlock::get().publish({
+      {MetricSlot::JsFpsInstant, averages.instant},
+      {MetricSlot::JsFps1s, averages.oneSecond},
+      {MetricSlot::JsFps5s, averages.fiveSeconds},
+      {MetricSlot::JsFpsSession, averages.session},
+    });
+    return slot;
+  }, slot);
+}
+
+void JsFpsTracker::stopAveragesLoop() {
+  if (_averagesTask != 0) {
+    _scheduler.cancel(_averagesTask);
+    _averagesTask = 0;
+  }
+}
+
+void JsFpsTracker::report() {
+  // Calculate FPS based on what happened since the last report
+  const long long now = nowNs();
+  const long long windowStartNs = _windowStartNs.exchange(now);
+  const double windowMs = static_cast<double>(now - windowStartNs) / 1'000'000.0;
+
+  // Read and reset frame counter
+  const uint32_t frames = _framesInWindow.exchange(0);
+
+  // Detect JS stall based on last tick timestamp
+  const long long lastTickNs = _lastJsTickNs.load();
+  bool jsStalled = (lastTickNs == 0) || ((now - lastTickNs) >= _windowNs.load());
+
+  // Cap and frame budget follow the current device refresh rate
+  const double deviceMaxFps = RuntimeBridgeState::get().getDeviceRefreshRate();
+  const double frameMs = RuntimeBridgeState::get().getFrameIntervalMs();
+
+  double fps = 0.0;
+  double droppedFrames = 0.0;
+  if (_mode == JsFpsTrackingMode::CONTINUOUS) {
+    if (frames > 0 && windowMs > 0) {
+      fps = (frames * 1000.0) / windowMs;
+    } else if (jsStalled) {
+      fps = 0.0;
+    }
+    // Every frame budget in the window without a JS tick is a dropped frame
+    droppedFrames = std::max(0.0, windowMs / frameMs - frames);
+  } else {
+    // Probes are sparse, so derive FPS from how much of the window the JS thread could not
+    // respond within one frame. A probe still waiting right now counts as stalled until now.
+    long long stallNs = _stallNsInWindow.exchange(0);
+    const long long pendingScheduledNs = _pendingScheduledNs.load();
+    if (_taskPending.load() && pendingScheduledNs != 0) {
+      const long long stallStartNs = std::max(pendingScheduledNs + toNs(frameInterval()), windowStartNs);
+      stallNs += std::max(0LL, now - stallStartNs);
+    }
+    const double stallMs = std::min(static_cast<double>(stallNs) / 1'000'000.0, windowMs);
+    if (lastTickNs != 0 && windowMs > 0) {
+      fps = deviceMaxFps * (1.0 - stallMs / windowMs);
+      droppedFrames = stallMs / frameMs;
+    } else {
+      droppedFrames = windowMs / frameMs;
+    }
+  }
+
+  double cappedFps = std::min(std::round(fps), deviceMaxFps);
+  if (_isMainRuntime) {
+    MetricHistograms::get().record(HistogramMetric::JsFps, cappedFps);
+  }
+
+  // A probe still waiting counts with its wait so far, so a frozen runtime shows up right away
+  long long maxLatencyNs = _maxLatencyNsInWindow.exchange(0);
+  const long long pendingSinceNs = _pendingScheduledNs.load();
+  if (_taskPending.load() && pendingSinceNs != 0) {
+    maxLatencyNs = std::max(maxLatencyNs, now - pendingSinceNs);
+  }
+
+  // Write to native buffers as Int32 (not on JS thread)
+  if (_writer) {
+    _writer(static_cast<int32_t>(cappedFps), static_cast<int32_t>(std::round(droppedFrames)), static_cast<double>(maxLatencyNs) / 1'000'000.0);
+  }
+}
+
+void JsFpsTracker::scheduleNextFrame() {
+  if (!_running.load()) {
+    return;
+  }
+  
+  // Check if there's already a task pending to avoid queue buildup
+  bool expected = false;
+  if (!_taskPending.compare_exchange_strong(expected, true)) {
+    // The previous probe is still waiting for the JS thread, let the watchdog check for how long
+    if (_longTasks) {
+      _longTasks->onTickPending(static_cast<double>(_pendingScheduledNs.load()) / 1'000'000.0, toMs(_scheduler.now()));
+    }
+    return;
+  }
+  
+  // Capture shared_ptr to keep tracker alive
+  auto self = shared_from_this();
+  const auto scheduledAt = _scheduler.now();
+  const uint64_t generation = _probeGeneration.load();
+  _pendingScheduledNs = toNs(scheduledAt);
+  ToolkitOverhead::get().addJsTask();
+  _executor([self, scheduledAt, generation](jsi::Runtime&) {
+    ToolkitOverhead::ScopedTimer timer(ToolkitOverhead::TimedWork::JsTask);
+    if (generation != self->_probeGeneration.load()) {
+      return; // Posted to a runtime that was replaced since, the pending flag belongs to a newer probe
+    }
+    if (!self->_running.load()) {
+      self->_taskPending = false;
+      return;
+    }
+    
+    // Record a JS tick and increment frame counter only
+    const auto now = self->_scheduler.now();
+    const long long tickNs = toNs(now);
+    self->_lastJsTickNs.store(tickNs);
+    self->_framesInWindow.fetch_add(1);
+    self->_slidingWindow.addFrame(tickNs);
+
+    if (self->_mode == JsFpsTrackingMode::ON_DEMAND) {
+      self->onProbeCompleted(toNs(scheduledAt), tickNs);
+    }
+    const long long latencyNs = tickNs - toNs(scheduledAt);
+    long long maxLatencyNs = self->_maxLatencyNsInWindow.load();
+    while (latencyNs > maxLatencyNs && !self->_maxLatencyNsInWindow.compare_exchange_weak(maxLatencyNs, latencyNs)) {
+    }
+    if (!self->_isMainRuntime) {
+      self->_taskPending = false;
+      return;
+    }
+
+    // Per-tick record for latency analysis, written from the JS thread (single producer)
+    if (self->_timeline && self->_timelineEnabled.load(std::memory_order_relaxed)) {
+      self->_timeline->push(toMs(scheduledAt), toMs(now));
+    }
+    MetricHistograms::get().record(HistogramMetric::JsLatency, toMs(now) - toMs(scheduledAt));
+    SessionRecorder::get().record(SessionRecordType::JsTick, tickNs, toMs(now) - toMs(scheduledAt));
+    self->attributeLag(toMs(scheduledAt), toMs(now) - toMs(scheduledAt), tickNs);
+    if (self->_longTasks) {
+      self->_longTasks->onTickRan(toMs(scheduledAt), toMs(now) - toMs(scheduledAt));
+    }
+    self->_taskPending = false;
+  });
+}
+
+// Runs on the JS thread. A tick that waited longer than one frame is tagged as a GC pause if the
+// GC count cached by JsHeapSampler went up since the last on-time tick, otherwise as a long task or
+// backlog by its latency. The engine is never asked here: the heap sampler's pass that sees a GC
+// during a stall may only run after the late tick, so a late tick without a new GC waits for the
+// next sample (at most LAG_MAX_DEFER_SAMPLES periods) before it is attributed.
+void JsFpsTracker::attributeLag(double scheduledMs, double latencyMs, long long tickNs) {
+  JsHeapSampler& heapSampler = JsHeapSampler::get();
+  if (!_heapSamplerStarted) {
+    _heapSamplerStarted = heapSampler.start(); // Retried until the main runtime is registered
+  }
+  const int64_t collectionCount = heapSampler.getCollectionCount();
+  const uint64_t heapSample = heapSampler.getSampleCount();
+  const auto newCollections = [this, collectionCount]() -> int64_t {
+    return _gcCountBaseline < 0 || collectionCount < 0 ? 0 : std::max<int64_t>(0, collectionCount - _gcCountBaseline);
+  };
+
+  if (_pendingLag) {
+    const long long maxDeferNs = static_cast<long long>(SamplerRates::get().getIntervalMs(SamplerKind::JsHeap)) * LAG_MAX_DEFER_SAMPLES * 1'000'000;
+    if (heapSample != _pendingLag->heapSample || tickNs - _pendingLag->tickNs > maxDeferNs) {
+      pushLag(_pendingLag->scheduledMs, _pendingLag->latencyMs, newCollections());
+      _pendingLag.reset();
+      _gcCountBaseline = collectionCount;
+    }
+  }
+
+  if (latencyMs <= RuntimeBridgeState::get().getFrameIntervalMs()) {
+    if (!_pendingLag) {
+      _gcCountBaseline = collectionCount;
+    }
+    return;
+  }
+  const int64_t collections = newCollections();
+  const bool canDefer = collections == 0 && collectionCount >= 0 && !SamplerRates::get().isPaused(SamplerKind::JsHeap);
+  if (!canDefer) {
+    pushLag(scheduledMs, latencyMs, collections);
+    _gcCountBaseline = collectionCount;
+    return;
+  }
+  if (_pendingLag) {
+    // Late again before the next sample, the earlier tick had no GC of its own
+    pushLag(_pendingLag->scheduledMs, _pendingLag->latencyMs, 0);
+  }
+  _pendingLag = PendingLag{scheduledMs, latencyMs, tickNs, heapSample};
+}
+
+void JsFpsTracker::pushLag(double scheduledMs, double latencyMs, int64_t newCollections) {
+  const JsLagCause cause = JsLagEvents::classify(latencyMs, newCollections);
+  if (_lagEvents) {
+    _lagEvents->push(scheduledMs, latencyMs, cause, static_cast<uint32_t>(newCollections));
+  }
+  if (cause != JsLagCause::Backlog) {
+    const auto type = cause == JsLagCause::GcPause ? SessionRecordType::GcPause : SessionRecordType::LongTask;
+    SessionRecorder::get().record(type, static_cast<int64_t>(scheduledMs * 1'000'000.0), latencyMs);
+  }
+}
+
+void JsFpsTracker::onProbeCompleted(long long scheduledNs, long long ranNs) {
+  const long long frameNs = toNs(frameInterval());
+  const long long latencyNs = ranNs - scheduledNs;
+
+  // Only the part of the stall that falls into the current window, the report already
+  // accounted for the rest while this probe was pending
+  const long long stallStartNs = std::max(scheduledNs + frameNs, _windowStartNs.load());
+  if (ranNs > stallStartNs) {
+    _stallNsInWindow.fetch_add(ranNs - stallStartNs);
+  }
+  _slidingWindow.addStall(scheduledNs + frameNs, ranNs);
+
+  // Adaptive back-off: probe every frame while the JS thread is busy, slow down while idle
+  const long long maxBackoffNs = static_cast<long long>(PROBE_MAX_BACKOFF_MS * 1'000'000.0);
+  if (latencyNs > frameNs) {
+    _probeBackoffNs = frameNs;
+  } else {
+    _probeBackoffNs = std::min(_probeBackoffNs.load() * 2, maxBackoffNs);
+  }
+}
+
+TrackerScheduler::Clock::duration JsFpsTracker::window() const {
+  return std::chrono::duration_cast<Clock::duration>(std::chrono::nanoseconds(_windowNs.load()));
+}
+
+TrackerScheduler::Clock::duration JsFpsTracker::frameInterval() {
+  // Get frame interval dynamically based on current device refresh rate
+  return std::chrono::duration_cast<Clock::duration>(
+    std::chrono::duration<double, std::milli>(RuntimeBridgeState::get().getFrameIntervalMs())
+  );
+}
+
+long long JsFpsTracker::toNs(Clock::duration duration) {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+}
+
+long long JsFpsTracker::toNs(Clock::time_point timePoint) {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(timePoint.time_since_epoch()).count();
+}
+
+long long JsFpsTracker::nowNs() const {
+  return toNs(_scheduler.now());
+}
+
+double JsFpsTracker::toMs(Clock::time_point timePoint) {
+  return std::chrono::duration<double, std::milli>(timePoint.time_since_epoch()).count();
+}
+
+} // namespace margelo::nitro::performancetoolkit
@@ -0,0 +1,140 @@
+#pragma once
+
+#include "JsFpsTrackingMode.hpp"
+#include "SlidingFpsWindow.hpp"
+#include "TrackerScheduler.hpp"
+#include "UiFrameSource.hpp"
+
+#include <jsi/jsi.h>
+#include <ReactCommon/RuntimeExecutor.h>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+
+namespace margelo::nitro::performancetoolkit {
+
+using namespace facebook;
+using namespace facebook::react;
+
+class JsFrameTimeline;
+class JsLagEvents;
+class LongTaskRecorder;
+
+// Measures how responsive a JS runtime is by posting probe tasks through its RuntimeExecutor and
+// timing when they run. Counting (continuous mode) or stall accounting (on-demand mode) happens on
+// the TrackerScheduler thread, the JS thread only runs the probe itself. At the end of every window
+// (FPS_WINDOW_MS unless changed with setWindowMs) the FPS, dropped frames and longest probe wait
+// of the window are handed to `writer`.
+//
+// Every probe also feeds a SlidingFpsWindow, which gives the FPS of the last 250 ms, second, five
+// seconds and of the whole session at any time (getAverages). The main runtime's tracker publishes
+// them to the metrics block every SlidingFpsWindow::SLOT_MS, aligned with the samplers' wakeups.
+//
+// Needs nothing but a RuntimeExecutor, which is what lets the host build (host/) drive it with a
+// fake executor. All timing goes through `scheduler`'s clock: given a scheduler on a VirtualClock
+// and an executor that runs its tasks from that scheduler, the tracker runs as a deterministic
+// simulation.
+class JsFpsTracker : public std::enable_shared_from_this<JsFpsTracker> {
+public:
+  using Writer = std::function<void(int32_t fps, int32_t droppedFrames, double maxLatencyMs)>;
+
+  static constexpr double FPS_WINDOW_MS = 1000.0; // Default FPS window, every window is reported once when it ends
+  static constexpr double PROBE_MAX_BACKOFF_MS = 500.0; // Slowest probe rate while the JS thread looks idle (on-demand mode)
+  static constexpr double FRAME_SOURCE_IDLE_MS = 100.0; // UI frames older than this mean the frame source stopped
+  static constexpr uint32_t LAG_MAX_DEFER_SAMPLES = 2; // Heap sample periods a late tick waits for a GC count before it's attributed without
+
+  // Only the main runtime feeds the timeline, lag events, long tasks, histograms and sessions,
+  // trackers of other runtimes (isMainRuntime = false) only report through `writer`
+  explicit JsFpsTracker(
+      Writer writer,
+      std::shared_ptr<JsFrameTimeline> timeline,
+      std::shared_ptr<JsLagEvents> lagEvents,
+      std::shared_ptr<LongTaskRecorder> longTasks,
+      RuntimeExecutor executor,
+      JsFpsTrackingMode mode,
+      bool isMainRuntime = true,
+      TrackerScheduler& scheduler = TrackerScheduler::get());
+
+  ~JsFpsTracker();
+
+  void start();
+  void stop();
+  void setMode(JsFpsTrackingMode mode);
+  // Ends the current window right away and reports every `windowMs` from then on
+  void setWindowMs(double windowMs);
+  // Whether probes write per-tick records to the timeline (main runtime only)
+  void setTimelineEnabled(bool enabled);
+  // The runtime behind the executor was replaced (reload). The probe pending in the old runtime may
+  // never run, so it stops holding back new probes, and is ignored if it does run
+  void onRuntimeReplaced();
+  // Sliding averages as of now, the session starts with start() or a mode change
+  SlidingFpsWindow::Averages getAverages() const;
+
+private:
+  using Clock = TrackerScheduler::Clock;
+
+  void startProbing();
+  void stopProbing();
+  void startFramePacingLoop();
+  void stopFramePacingLoop();
+  void startOnDemandProbing();
+  void stopOnDemandProbing();
+  void startReportingLoop();
+  void stopReportingLoop();
+  void startAveragesLoop();
+  void stopAveragesLoop();
+
+  void report();
+  void scheduleNextFrame();
+  void attributeLag(double scheduledMs, double latencyMs, long long tickNs);
+  void pushLag(double scheduledMs, double latencyMs, int64_t newCollections);
+  void onProbeCompleted(long long scheduledNs, long long ranNs);
+
+  Clock::duration window() const;
+  static Clock::duration frameInterval();
+  static long long toNs(Clock::duration duration);
+  static long long toNs(Clock::time_point timePoint);
+  long long nowNs() const;
+  static double toMs(Clock::time_point timePoint);
+
+  TrackerScheduler& _scheduler;
+  Writer _writer;
+  std::shared_ptr<JsFrameTimeline> _timeline;
+  std::shared_ptr<JsLagEvents> _lagEvents;
+  std::shared_ptr<LongTaskRecorder> _longTasks;
+  RuntimeExecutor _executor;
+  std::atomic<JsFpsTrackingMode> _mode;
+  std::atomic<long long> _windowNs;
+  std::atomic<bool> _timelineEnabled;
+  const bool _isMainRuntime;
+  std::atomic<uint32_t> _framesInWindow;
+  std::atomic<long long> _maxLatencyNsInWindow;
+  std::atomic<long long> _stallNsInWindow;
+  std::atomic<long long> _windowStartNs;
+  std::atomic<long long> _lastJsTickNs;
+  std::atomic<long long> _pendingScheduledNs;
+  std::atomic<long long> _probeBackoffNs;
+  std::atomic<bool> _running;
+  std::atomic<bool> _taskPending;
+  std::atomic<uint64_t> _probeGeneration; // Bumped by onRuntimeReplaced, probes of older generations are ignored
+  SlidingFpsWindow _slidingWindow;
+  TrackerScheduler::TaskId _framePacingTask = 0;
+  TrackerScheduler::TaskId _backoffTask = 0;
+  TrackerScheduler::TaskId _reportingTask = 0;
+  TrackerScheduler::TaskId _averagesTask = 0;
+  UiFrameSource::ListenerId _frameListener = 0;
+  // Lag attribution state, JS thread only
+  struct PendingLag {
+    double scheduledMs;
+    double latencyMs;
+    long long tickNs;
+    uint64_t heapSample; // JsHeapSampler sample count when the tick ran
+  };
+  std::optional<PendingLag> _pendingLag;
+  int64_t _gcCountBaseline = -1;
+  bool _heapSamplerStarted = false;
+};
+
+} // namespace margelo::nitro::performancetoolkit
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <NitroModules/ArrayBuffer.hpp>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <new>
+
+namespace margelo::nitro::performancetoolkit {
+
+using namespace margelo::nitro;
+
+// Single-producer/single-consumer ring of per-tick JS timing records, stored directly
+// inside an ArrayBuffer so JS and worklets can read it zero-copy with a DataView.
+//
+// Layout (little-endian, see src/jsFrameTimeline.ts for the reader):
+//
+//   Header (16 bytes)
+//     0  uint32   capacity     - number of record slots
+//     4  uint32   recordSize   - size of one record in bytes
+//     8  uint32   writeIndex   - total records ever written, published with release semantics
+//    12  uint32   reserved
+//   Records (capacity * 24 bytes), record N lives in slot N % capacity
+//     0  float64  scheduledMs  - when the tick was posted to the JS thread
+//     8  float64  ranMs        - when the tick started running on the JS thread
+//    16  float64  latencyMs    - ranMs - scheduledMs
+//
+// Timestamps are steady clock milliseconds, the same timebase as `performance.now()`.
+// The producer is the JS thread itself (the tick task), so writes never contend.
+class JsFrameTimeline {
+public:
+  static constexpr uint32_t DEFAULT_CAPACITY = 512; // ~8.5 seconds of ticks at 60 Hz
+
+  struct Header {
+    uint32_t capacity;
+    uint32_t recordSize;
+    std::atomic<uint32_t> writeIndex;
+    uint32_t reserved;
+  };
+
+  struct Record {
+    double scheduledMs;
+    double ranMs;
+    double latencyMs;
+  };
+
+  static_assert(sizeof(Header) == 16, "Header layout is shared with JS");
+  static_assert(sizeof(Record) == 24, "Record layout is shared with JS");
+  static_assert(std::atomic<uint32_t>::is_always_lock_free, "writeIndex must be lock-free to be shared with JS");
+
+  explicit JsFrameTimeline(uint32_t capacity = DEFAULT_CAPACITY)
+      : _buffer(ArrayBuffer::allocate(sizeof(Header) + sizeof(Record) * capacity)) {
+    auto* bytes = _buffer->data();
+    _header = new (bytes) Header{capacity, static_cast<uint32_t>(sizeof(Record)), {0}, 0};
+    _records = reinterpret_cast<Record*>(bytes + sizeof(Header));
+    for (uint32_t i = 0; i < capacity; i++) {
+      new (&_records[i]) Record{0.0, 0.0, 0.0};
+    }
+  }
+
+  // Called on the producer thread only
+  void push(double scheduledMs, double ranMs) {
+    const uint32_t index = _header->writeIndex.load(std::memory_order_relaxed);
+    Record& record = _records[index % _header->capacity];
+    record.scheduledMs = scheduledMs;
+    record.ranMs = ranMs;
+    record.latencyMs = ranMs - scheduledMs;
+    // Publish only after the record is fully written
+    _header->writeIndex.store(index + 1, std::memory_order_release);
+  }
+
+  uint32_t getWriteIndex() const {
+    return _header->writeIndex.load(std::memory_order_acquire);
+  }
+
+  const std::shared_ptr<ArrayBuffer>& getBuffer() const {
+    return _buffer;
+  }
+
+private:
+  std::shared_ptr<ArrayBuffer> _buffer;
+  Header* _header;
+  Record* _records;
+};
+
+} // namespace margelo::nitro::performancetoolkit
@@ -0,0 +1,72 @@
+#include "JsHeapSampler.hpp"
+#include "MetricsBlock.hpp"
+#include "RuntimeBridge.hpp"
+#include "SamplerRates.hpp"
+#include "ToolkitOverhead.hpp"
+
+#include <chrono>
+#include <string>
+#include <unordered_map>
+
+namespace margelo::nitro::performancetoolkit {
+
+// Keys reported by Hermes, see hermes/API/hermes/hermes.cpp (HermesRuntimeImpl::instrumentation)
+static constexpr auto ALLOCATED_BYTES_KEY = "hermes_allocatedBytes";
+static constexpr auto HEAP_SIZE_KEY = "hermes_heapSize";
+static constexpr auto NUM_COLLECTIONS_KEY = "hermes_numCollections";
+
+JsHeapSampler& JsHeapSampler::get() {
+  static JsHeapSampler instance;
+  return instance;
+}
+
+bool JsHeapSampler::start() {
+  std::lock_guard<std::mutex> lock(_mutex);
+  if (_task != 0) {
+    return true;
+  }
+
+  if (RuntimeBridgeState::get().getRegistrationId(RuntimeBridgeState::MAIN_RUNTIME_NAME) == 0) {
+    return false;
+  }
+
+  RuntimeExecutor executor = RuntimeBridgeState::get().getBoundExecutor(RuntimeBridgeState::MAIN_RUNTIME_NAME);
+  _task = SamplerRates::get().schedule(SamplerKind::JsHeap, [this, executor]() {
+    const uint64_t registrationId = RuntimeBridgeState::get().getRegistrationId(RuntimeBridgeState::MAIN_RUNTIME_NAME);
+    if (registrationId != _registrationId) {
+      // Reloaded: the sample pending in the old runtime may never run, and GC counts start over
+      _registrationId = registrationId;
+      _samplePending = false;
+      _collectionCount = -1;
+    }
+    bool expected = false;
+    if (_samplePending.compare_exchange_strong(expected, true)) {
+      ToolkitOverhead::get().addJsTask();
+      executor([this, registrationId](jsi::Runtime& runtime) {
+        if (registrationId != RuntimeBridgeState::get().getRegistrationId(RuntimeBridgeState::MAIN_RUNTIME_NAME)) {
+          return; // Ran in a runtime that was replaced since
+        }
+        ToolkitOverhead::ScopedTimer timer(ToolkitOverhead::TimedWork::JsTask);
+        ToolkitOverhead::get().addJsiCalls();
+        // includeExpensive = false, only counters Hermes keeps anyway
+        const std::unordered_map<std::string, int64_t> heapInfo = runtime.instrumentation().getHeapInfo(false);
+        const auto allocatedBytes = heapInfo.find(ALLOCATED_BYTES_KEY);
+        const auto heapSize = heapInfo.find(HEAP_SIZE_KEY);
+        const auto numCollections = heapInfo.find(NUM_COLLECTIONS_KEY);
+        if (allocatedBytes != heapInfo.end() && heapSize != heapInfo.end() && numCollections != heapInfo.end()) {
+          _collectionCount.store(numCollections->second, std::memory_order_release);
+          MetricsBlock::get().publish({
+            {MetricSlot::JsHeapAllocatedBytes, static_cast<double>(allocatedBytes->second)},
+            {MetricSlot::JsHeapSizeBytes, static_cast<double>(heapSize->second)},
+            {MetricSlot::JsGcCount, static_cast<double>(numCollections->second)},
+          });
+        }
+        _sampleCount.fetch_add(1, std::memory_order_release);
+        _samplePending = false;
+      });
+    }
+  }, std::chrono::milliseconds(0));
+  return true;
+}
+
+} // namespace margelo::nitro::performancetoolkit
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "TrackerScheduler.hpp"
+
+#include <jsi/jsi.h>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+namespace margelo::nitro::performancetoolkit {
+
+// Periodically reads the JS engine heap statistics on the JS thread (jsi::Instrumentation::getHeapInfo)
+// and publishes allocated bytes, heap size and GC count to the metrics block, next to the process
+// memory, so JS heap growth can be told apart from native leaks and GCs matched with JS FPS dips.
+//
+// Only the cheap statistics are requested and at most once per sampling period, a sample is
+// skipped while the previous one is still waiting for the JS thread. Engines that don't report
+// Hermes' keys (e.g. JSC) leave the slots untouched. Samples follow the main runtime across
+// reloads, a new runtime restarts the GC count baseline. Started by the metrics block readers and
+// by the main JS FPS tracker, which attributes late ticks to GCs from the cached count.
+class JsHeapSampler {
+public:
+  static constexpr uint32_t SAMPLE_INTERVAL_MS = 1000; // Default period, see SamplerRates
+
+  static JsHeapSampler& get();
+
+  // Starts sampling, returns false (and can be called again later) while the runtime isn't ready
+  bool start();
+
+  // Total number of GCs reported by the last sample, -1 if the engine doesn't report it. Lag
+  // attribution compares this cached count instead of asking the engine on every late tick
+  int64_t getCollectionCount() const {
+    return _collectionCount.load(std::memory_order_acquire);
+  }
+
+  // Number of samples taken so far, tells readers of the GC count whether it was refreshed since
+  uint64_t getSampleCount() const {
+    return _sampleCount.load(std::memory_order_acquire);
+  }
+
+private:
+  JsHeapSampler() = default;
+
+  std::mutex _mutex;
+  TrackerScheduler::TaskId _task = 0;
+  std::atomic<bool> _samplePending{false};
+  uint64_t _registrationId = 0; // Main runtime registration sampled last, scheduler thread only
+  std::atomic<int64_t> _collectionCount{-1};
+  std::atomic<uint64_t> _sampleCount{0};
+};
+
+} // namespace margelo::nitro::performancetoolkit
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <NitroModules/ArrayBuffer.hpp>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <new>
+
+namespace margelo::nitro::performancetoolkit {
+
+using namespace margelo::nitro;
+
+// Why a JS tick ran later than one frame after it was posted
+enum class JsLagCause : uint32_t {
+  GcPause = 0, // The JS engine collected garbage while the tick was waiting
+  LongTask,    // No GC, but the tick waited longer than LONG_TASK_MS for synchronous JS work
+  Backlog,     // Short delay behind other tasks queued on the JS thread
+  Count,
+};
+
+// Per-cause counters plus a ring of the most recent late JS ticks, stored directly inside an
+// ArrayBuffer so JS and worklets can read it zero-copy with a DataView (same scheme as JsFrameTimeline).
+//
+// Layout (little-endian, see src/jsLagEvents.ts for the reader):
+//
+//   Header (32 bytes)
+//     0  uint32   capacity      - number of event slots
+//     4  uint32   recordSize    - size of one event in bytes
+//     8  uint32   writeIndex    - total events ever written, published with release semantics
+//    12  uint32   gcPauseCount  - late ticks per cause since start, updated before writeIndex
+//    16  uint32   longTaskCount
+//    20  uint32   backlogCount
+//    24  reserved
+//   Events (capacity * 24 bytes), event N lives in slot N % capacity
+//     0  float64  scheduledMs   - when the tick was posted to the JS thread
+//     8  float64  latencyMs     - how long it waited
+//    16  uint32   cause         - JsLagCause
+//    20  uint32   gcCount       - garbage collections that happened while it waited
+//
+// The producer is the JS thread itself (the tick task), so writes never contend.
+class JsLagEvents {
+public:
+  static constexpr uint32_t DEFAULT_CAPACITY = 128;
+  static constexpr double LONG_TASK_MS = 50.0; // Long task threshold used by browsers (RAIL)
+
+  struct Header {
+    uint32_t capacity;
+    uint32_t recordSize;
+    std::atomic<uint32_t> writeIndex;
+    std::atomic<uint32_t> causeCounts[static_cast<uint32_t>(JsLagCause::Count)];
+    uint32_t reserved[2];
+  };
+
+  struct Record {
+    double scheduledMs;
+    double latencyMs;
+    uint32_t cause;
+    uint32_t gcCount;
+  };
+
+  static_assert(sizeof(Header) == 32, "Header layout is shared with JS");
+  static_assert(sizeof(Record) == 24, "Record layout is shared with JS");
+
+  explicit JsLagEvents(uint32_t capacity = DEFAULT_CAPACITY)
+      : _buffer(ArrayBuffer::allocate(sizeof(Header) + sizeof(Record) * capacity)) {
+    auto* bytes = _buffer->data();
+    _header = new (bytes) Header{capacity, static_cast<uint32_t>(sizeof(Record)), {0}, {}, {}};
+    _records = reinterpret_cast<Record*>(bytes + sizeof(Header));
+    for (uint32_t i = 0; i < capacity; i++) {
+      new (&_records[i]) Record{0.0, 0.0, 0, 0};
+    }
+  }
+
+  static JsLagCause classify(double latencyMs, int64_t gcCount) {
+    if (gcCount > 0) {
+      return JsLagCause::GcPause;
+    }
+    return latencyMs > LONG_TASK_MS ? JsLagCause::LongTask : JsLagCause::Backlog;
+  }
+
+  // Called on the producer thread only
+  void push(double scheduledMs, double latencyMs, JsLagCause cause, uint32_t gcCount) {
+    const uint32_t index = _header->writeIndex.load(std::memory_order_relaxed);
+    Record& record = _records[index % _header->capacity];
+    record.scheduledMs = scheduledMs;
+    record.latencyMs = latencyMs;
+    record.cause = static_cast<uint32_t>(cause);
+    record.gcCount = gcCount;
+    _header->causeCounts[static_cast<uint32_t>(cause)].fetch_add(1, std::memory_order_relaxed);
+    // Publish only after the record and the counter are written
+    _header->writeIndex.store(index + 1, std::memory_order_release);
+  }
+
+  uint32_t getCount(JsLagCause cause) const {
+    return _header->causeCounts[static_cast<uint32_t>(cause)].load(std::memory_order_relaxed);
+  }
+
+  const std::shared_ptr<ArrayBuffer>& getBuffer() const {
+    return _buffer;
+  }
+
+private:
+  std::shared_ptr<ArrayBuffer> _buffer;
+  Header* _header;
+  Record* _records;
+};
+
+} // namespace margelo::nitro::performancetoolkit
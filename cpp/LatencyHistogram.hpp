@@ -0,0 +1,154 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+
+namespace margelo::nitro::performancetoolkit {
+
+// Log-linear bucketing (HDR histogram style) for non-negative integer values.
+// Values below 2^SUB_BUCKET_BITS get an exact bucket each, above that every power of two is split
+// into 2^SUB_BUCKET_BITS linear sub-buckets, so the relative error is at most 1 / 2^SUB_BUCKET_BITS (~3%).
+struct HistogramBuckets {
+  static constexpr uint32_t SUB_BUCKET_BITS = 5;
+  static constexpr uint32_t SUB_BUCKET_COUNT = 1u << SUB_BUCKET_BITS;
+  static constexpr uint32_t VALUE_BITS = 32; // Values are clamped to uint32_t
+  static constexpr uint32_t COUNT = SUB_BUCKET_COUNT + (VALUE_BITS - SUB_BUCKET_BITS) * SUB_BUCKET_COUNT;
+
+  static constexpr uint32_t indexOf(uint32_t value) {
+    if (value < SUB_BUCKET_COUNT) {
+      return value;
+    }
+    const uint32_t exponent = 31 - static_cast<uint32_t>(__builtin_clz(value)); // floor(log2(value)), >= SUB_BUCKET_BITS
+    const uint32_t shift = exponent - SUB_BUCKET_BITS;
+    const uint32_t mantissa = (value >> shift) - SUB_BUCKET_COUNT;
+    return SUB_BUCKET_COUNT + shift * SUB_BUCKET_COUNT + mantissa;
+  }
+
+  // Lowest value that falls into the bucket
+  static constexpr uint64_t lowerBoundOf(uint32_t index) {
+    if (index < SUB_BUCKET_COUNT) {
+      return index;
+    }
+    const uint32_t shift = (index - SUB_BUCKET_COUNT) / SUB_BUCKET_COUNT;
+    const uint32_t mantissa = (index - SUB_BUCKET_COUNT) % SUB_BUCKET_COUNT;
+    return static_cast<uint64_t>(SUB_BUCKET_COUNT + mantissa) << shift;
+  }
+
+  // Highest value that falls into the bucket
+  static constexpr uint64_t upperBoundOf(uint32_t index) {
+    if (index < SUB_BUCKET_COUNT) {
+      return index;
+    }
+    const uint32_t shift = (index - SUB_BUCKET_COUNT) / SUB_BUCKET_COUNT;
+    return lowerBoundOf(index) + (uint64_t(1) << shift) - 1;
+  }
+
+  static constexpr uint32_t clamp(double value) {
+    if (!(value > 0.0)) {
+      return 0; // also catches NaN
+    }
+    if (value >= static_cast<double>(std::numeric_limits<uint32_t>::max())) {
+      return std::numeric_limits<uint32_t>::max();
+    }
+    return static_cast<uint32_t>(value + 0.5);
+  }
+};
+
+// Plain (non-atomic) copy of histogram counts. Snapshots of different histograms or time slots
+// can be merged, percentiles are computed from the merged counts.
+class HistogramSnapshot {
+public:
+  void merge(const HistogramSnapshot& other) {
+    for (uint32_t i = 0; i < HistogramBuckets::COUNT; i++) {
+      _counts[i] += other._counts[i];
+    }
+    _totalCount += other._totalCount;
+    _max = std::max(_max, other._max);
+  }
+
+  void add(uint32_t bucketIndex, uint64_t count) {
+    _counts[bucketIndex] += count;
+    _totalCount += count;
+  }
+
+  void updateMax(uint32_t value) {
+    _max = std::max(_max, value);
+  }
+
+  uint64_t getTotalCount() const {
+    return _totalCount;
+  }
+
+  // Exact maximum recorded value (not bucketed)
+  uint32_t getMax() const {
+    return _max;
+  }
+
+  // Value at the given percentile (0-100), reported as the upper bound of its bucket and never above max
+  uint64_t getValueAtPercentile(double percentile) const {
+    if (_totalCount == 0) {
+      return 0;
+    }
+    const double clamped = std::clamp(percentile, 0.0, 100.0);
+    const uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(clamped / 100.0 * static_cast<double>(_totalCount) + 0.5));
+    uint64_t seen = 0;
+    for (uint32_t i = 0; i < HistogramBuckets::COUNT; i++) {
+      seen += _counts[i];
+      if (seen >= rank) {
+        return std::min<uint64_t>(HistogramBuckets::upperBoundOf(i), _max);
+      }
+    }
+    return _max;
+  }
+
+private:
+  std::array<uint64_t, HistogramBuckets::COUNT> _counts{};
+  uint64_t _totalCount = 0;
+  uint32_t _max = 0;
+};
+
+// Fixed-size histogram with O(1), allocation-free and lock-free recording.
+// Safe to record from any number of threads while another thread takes snapshots.
+class LatencyHistogram {
+public:
+  LatencyHistogram() {
+    reset();
+  }
+
+  LatencyHistogram(const LatencyHistogram&) = delete;
+  LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+  void record(uint32_t value) {
+    _counts[HistogramBuckets::indexOf(value)].fetch_add(1, std::memory_order_relaxed);
+    uint32_t currentMax = _max.load(std::memory_order_relaxed);
+    while (value > currentMax && !_max.compare_exchange_weak(currentMax, value, std::memory_order_relaxed)) {
+    }
+  }
+
+  void reset() {
+    for (auto& count : _counts) {
+      count.store(0, std::memory_order_relaxed);
+    }
+    _max.store(0, std::memory_order_relaxed);
+  }
+
+  // Adds this histogram's counts to `snapshot`
+  void snapshotInto(HistogramSnapshot& snapshot) const {
+    for (uint32_t i = 0; i < HistogramBuckets::COUNT; i++) {
+      const uint32_t count = _counts[i].load(std::memory_order_relaxed);
+      if (count != 0) {
+        snapshot.add(i, count);
+      }
+    }
+    snapshot.updateMax(_max.load(std::memory_order_relaxed));
+  }
+
+private:
+  std::array<std::atomic<uint32_t>, HistogramBuckets::COUNT> _counts;
+  std::atomic<uint32_t> _max;
+};
+
+} // namespace margelo::nitro::performancetoolkit
@@ -0,0 +1,79 @@
+#include "LongTaskRecorder.hpp"
+
+#include <iterator>
+#include <sstream>
+
+#if PERFORMANCE_TOOLKIT_HERMES_PROFILER
+#include <hermes/hermes.h>
+#endif
+
+namespace margelo::nitro::performancetoolkit {
+
+static constexpr double PROFILER_SAMPLING_HZ = 1000.0; // ~1 ms resolution, only runs during a freeze
+
+static void startProfiler() {
+#if PERFORMANCE_TOOLKIT_HERMES_PROFILER
+  facebook::hermes::HermesRuntime::enableSamplingProfiler(PROFILER_SAMPLING_HZ);
+#endif
+}
+
+static std::optional<std::string> stopProfiler() {
+#if PERFORMANCE_TOOLKIT_HERMES_PROFILER
+  facebook::hermes::HermesRuntime::disableSamplingProfiler();
+  std::ostringstream stream;
+  facebook::hermes::HermesRuntime::dumpSampledTraceToStream(stream);
+  std::string trace = stream.str();
+  if (trace.empty() || trace.size() > LongTaskRecorder::MAX_TRACE_BYTES) {
+    return std::nullopt;
+  }
+  return trace;
+#else
+  return std::nullopt;
+#endif
+}
+
+void LongTaskRecorder::setThresholdMs(double thresholdMs) {
+  _thresholdMs = thresholdMs > 0.0 ? thresholdMs : 0.0;
+}
+
+double LongTaskRecorder::getThresholdMs() const {
+  return _thresholdMs.load();
+}
+
+void LongTaskRecorder::onTickPending(double scheduledMs, double nowMs) {
+  const double thresholdMs = _thresholdMs.load();
+  if (thresholdMs <= 0.0 || nowMs - scheduledMs < thresholdMs) {
+    return;
+  }
+  bool expected = false;
+  if (_profiling.compare_exchange_strong(expected, true)) {
+    startProfiler();
+  }
+}
+
+void LongTaskRecorder::onTickRan(double scheduledMs, double latencyMs) {
+  std::optional<std::string> sampledTrace;
+  if (_profiling.exchange(false)) {
+    // Runs on the JS thread, but only right after a freeze
+    sampledTrace = stopProfiler();
+  }
+
+  const double thresholdMs = _thresholdMs.load();
+  if (thresholdMs <= 0.0 || latencyMs < thresholdMs) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(_mutex);
+  if (_records.size() >= MAX_RECORDS) {
+    _records.pop_front();
+  }
+  _records.push_back(Record{scheduledMs, latencyMs, std::move(sampledTrace)});
+}
+
+std::vector<LongTaskRecorder::Record> LongTaskRecorder::drain() {
+  std::lock_guard<std::mutex> lock(_mutex);
+  std::vector<Record> records(std::make_move_iterator(_records.begin()), std::make_move_iterator(_records.end()));
+  _records.clear();
+  return records;
+}
+
+} // namespace margelo::nitro::performancetoolkit
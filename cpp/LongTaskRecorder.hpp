@@ -0,0 +1,59 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+// The Hermes sampling profiler is used where the Hermes headers are available (and, on Android,
+// libhermes is linked, see android/CMakeLists.txt)
+#if __has_include(<hermes/hermes.h>) && !defined(PERFORMANCE_TOOLKIT_DISABLE_HERMES_PROFILER)
+#define PERFORMANCE_TOOLKIT_HERMES_PROFILER 1
+#else
+#define PERFORMANCE_TOOLKIT_HERMES_PROFILER 0
+#endif
+
+namespace margelo::nitro::performancetoolkit {
+
+// Watchdog for JS thread freezes. The tracker reports every probe that is still waiting for the
+// JS thread; once one is overdue by the threshold the Hermes sampling profiler is started, so the
+// rest of the freeze gets sampled. When the overdue tick finally runs, the freeze is recorded
+// (start, duration and the sampled trace) into a bounded queue that JS drains.
+class LongTaskRecorder {
+public:
+  static constexpr size_t MAX_RECORDS = 32;
+  static constexpr size_t MAX_TRACE_BYTES = 1024 * 1024; // Larger traces are dropped, not truncated (JSON)
+
+  struct Record {
+    double startMs;    // When the late tick was posted (steady clock, same timebase as `performance.now()`)
+    double durationMs; // How long it waited for the JS thread
+    std::optional<std::string> sampledTrace; // Chrome trace JSON from the Hermes sampling profiler
+  };
+
+  // 0 disables the watchdog
+  void setThresholdMs(double thresholdMs);
+  double getThresholdMs() const;
+
+  // Called from the scheduler thread whenever a probe is still pending
+  void onTickPending(double scheduledMs, double nowMs);
+  // Called on the JS thread when a probe ran
+  void onTickRan(double scheduledMs, double latencyMs);
+
+  // Returns and removes all records, oldest first
+  std::vector<Record> drain();
+
+  static bool isProfilerSupported() {
+    return PERFORMANCE_TOOLKIT_HERMES_PROFILER;
+  }
+
+private:
+  std::atomic<double> _thresholdMs{0.0};
+  std::atomic<bool> _profiling{false};
+  std::mutex _mutex;
+  std::deque<Record> _records;
+};
+
+} // namespace margelo::nitro::performancetoolkit
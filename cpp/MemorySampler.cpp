@@ -0,0 +1,188 @@
+#include "MemorySampler.hpp"
+#include "MetricsBlock.hpp"
+#include "PlatformBridge.hpp"
+#include "SamplerRates.hpp"
+
+#include <chrono>
+#include <cstring>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <unistd.h>
+#elif defined(__APPLE__)
+#include <mach/mach.h>
+#endif
+
+namespace margelo::nitro::performancetoolkit {
+
+static const char* skipSpaces(const char* cursor, const char* end) {
+  while (cursor < end && (*cursor == ' ' || *cursor == '\t')) {
+    cursor++;
+  }
+  return cursor;
+}
+
+static uint64_t parseNumber(const char* cursor, const char* end) {
+  uint64_t value = 0;
+  while (cursor < end && *cursor >= '0' && *cursor <= '9') {
+    value = value * 10 + static_cast<uint64_t>(*cursor - '0');
+    cursor++;
+  }
+  return value;
+}
+
+MemorySampler& MemorySampler::get() {
+  static MemorySampler instance;
+  return instance;
+}
+
+MemorySampler::~MemorySampler() {
+#if defined(__linux__)
+  if (_smapsRollupFd >= 0) {
+    close(_smapsRollupFd);
+  }
+  if (_statmFd >= 0) {
+    close(_statmFd);
+  }
+#endif
+}
+
+bool MemorySampler::parseSmapsRollup(const char* data, size_t length, MemoryStats& out) {
+  // Lines look like "Pss_Anon:   123 kB", keys are matched on their exact length so prefixes
+  // like Pss_Dirty or SwapPss don't match Pss / Swap
+  struct Field {
+    const char* key;
+    size_t keyLength;
+    uint64_t MemoryStats::*target;
+  };
+  static constexpr Field FIELDS[] = {
+    {"Rss", 3, &MemoryStats::rssKb},
+    {"Pss", 3, &MemoryStats::pssKb},
+    {"Private_Dirty", 13, &MemoryStats::privateDirtyKb},
+    {"Swap", 4, &MemoryStats::swapKb},
+    {"Anonymous", 9, &MemoryStats::anonymousKb},
+  };
+
+  bool found = false;
+  const char* end = data + length;
+  const char* line = data;
+  while (line < end) {
+    const char* lineEnd = static_cast<const char*>(std::memchr(line, '\n', static_cast<size_t>(end - line)));
+    if (lineEnd == nullptr) {
+      lineEnd = end;
+    }
+    const char* colon = static_cast<const char*>(std::memchr(line, ':', static_cast<size_t>(lineEnd - line)));
+    if (colon != nullptr) {
+      const auto keyLength = static_cast<size_t>(colon - line);
+      for (const Field& field : FIELDS) {
+        if (keyLength == field.keyLength && std::memcmp(line, field.key, keyLength) == 0) {
+          out.*field.target = parseNumber(skipSpaces(colon + 1, lineEnd), lineEnd);
+          found = true;
+          break;
+        }
+      }
+    }
+    line = lineEnd + 1;
+  }
+  return found;
+}
+
+bool MemorySampler::parseStatmResidentPages(const char* data, size_t length, uint64_t& residentPages) {
+  // "<size> <resident> <shared> <text> <lib> <data> <dt>", all in pages
+  const char* end = data + length;
+  const char* separator = static_cast<const char*>(std::memchr(data, ' ', length));
+  if (separator == nullptr) {
+    return false;
+  }
+  const char* cursor = skipSpaces(separator, end);
+  if (cursor == end || *cursor < '0' || *cursor > '9') {
+    return false;
+  }
+  residentPages = parseNumber(cursor, end);
+  return true;
+}
+
+#if defined(__linux__)
+
+bool MemorySampler::start() {
+  std::call_once(_started, [this]() {
+    _smapsRollupFd = open("/proc/self/smaps_rollup", O_RDONLY | O_CLOEXEC);
+    _statmFd = open("/proc/self/statm", O_RDONLY | O_CLOEXEC);
+    if (_smapsRollupFd < 0 && _statmFd < 0) {
+      return;
+    }
+    _supported = true;
+    const long pageSize = sysconf(_SC_PAGESIZE);
+    if (pageSize > 0) {
+      _pageSizeKb = static_cast<uint64_t>(pageSize) / 1024;
+    }
+
+    sample();
+    SamplerRates::get().schedule(SamplerKind::Memory, [this]() { sample(); });
+  });
+  return _supported;
+}
+
+void MemorySampler::sample() {
+  MemoryStats stats;
+  bool hasSmapsRollup = false;
+  if (_smapsRollupFd >= 0) {
+    const ssize_t length = pread(_smapsRollupFd, _readBuffer.data(), _readBuffer.size(), 0);
+    hasSmapsRollup = length > 0 && parseSmapsRollup(_readBuffer.data(), static_cast<size_t>(length), stats);
+  }
+  if (!hasSmapsRollup && _statmFd >= 0) {
+    const ssize_t length = pread(_statmFd, _readBuffer.data(), _readBuffer.size(), 0);
+    uint64_t residentPages = 0;
+    if (length > 0 && parseStatmResidentPages(_readBuffer.data(), static_cast<size_t>(length), residentPages)) {
+      stats.rssKb = residentPages * _pageSizeKb;
+    }
+  }
+
+  const uint64_t usageKb = hasSmapsRollup ? stats.pssKb : stats.rssKb;
+  const auto usageMb = static_cast<int32_t>(usageKb / 1024);
+  _memoryUsageCell = usageMb;
+  PlatformBridge::recordMemoryUsage(static_cast<double>(usageMb));
+  MetricsBlock::get().publish({
+    {MetricSlot::MemoryPssKb, static_cast<double>(stats.pssKb)},
+    {MetricSlot::MemoryRssKb, static_cast<double>(stats.rssKb)},
+    {MetricSlot::MemoryPrivateDirtyKb, static_cast<double>(stats.privateDirtyKb)},
+    {MetricSlot::MemorySwapKb, static_cast<double>(stats.swapKb)},
+    {MetricSlot::MemoryAnonymousKb, static_cast<double>(stats.anonymousKb)},
+  });
+}
+
+#elif defined(__APPLE__)
+
+// No procfs: the legacy value is the physical footprint (what Xcode's memory gauge shows), plus RSS
+bool MemorySampler::start() {
+  std::call_once(_started, [this]() {
+    _supported = true;
+    sample();
+    SamplerRates::get().schedule(SamplerKind::Memory, [this]() { sample(); });
+  });
+  return _supported;
+}
+
+void MemorySampler::sample() {
+  task_vm_info_data_t info{};
+  mach_msg_type_number_t count = TASK_VM_INFO_COUNT;
+  if (task_info(mach_task_self(), TASK_VM_INFO, reinterpret_cast<task_info_t>(&info), &count) != KERN_SUCCESS) {
+    return;
+  }
+  const auto usageMb = static_cast<int32_t>(info.phys_footprint / (1024 * 1024));
+  _memoryUsageCell = usageMb;
+  PlatformBridge::recordMemoryUsage(static_cast<double>(usageMb));
+  MetricsBlock::get().publish(MetricSlot::MemoryRssKb, static_cast<double>(info.resident_size / 1024));
+}
+
+#else
+
+bool MemorySampler::start() {
+  return false; // Unsupported platform, the memory buffer stays at 0
+}
+
+void MemorySampler::sample() {}
+
+#endif
+
+} // namespace margelo::nitro::performancetoolkit
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+namespace margelo::nitro::performancetoolkit {
+
+// Process memory breakdown from procfs (Linux/Android). On Apple platforms the physical footprint
+// and RSS come from task_info, elsewhere this is a no-op.
+//
+// Samples run on the TrackerScheduler thread. `/proc/self/smaps_rollup` and `/proc/self/statm`
+// stay open and are re-read with pread into a reused buffer, then parsed in a single pass that
+// jumps between lines with memchr, so a sample doesn't allocate.
+// All fields are published to the metrics block in KB, the legacy memory usage value is PSS in MB
+// (RSS where smaps_rollup isn't available, it needs kernel 4.14+ / Android 10+).
+class MemorySampler {
+public:
+  static constexpr uint32_t SAMPLE_INTERVAL_MS = 500; // Default period, see SamplerRates
+  static constexpr size_t READ_BUFFER_SIZE = 4096; // smaps_rollup is ~800 bytes
+
+  struct MemoryStats {
+    uint64_t pssKb = 0;
+    uint64_t rssKb = 0;
+    uint64_t privateDirtyKb = 0;
+    uint64_t swapKb = 0;
+    uint64_t anonymousKb = 0;
+  };
+
+  static MemorySampler& get();
+
+  // Starts sampling on the first call, returns false where procfs isn't available
+  bool start();
+
+  // Parses the contents of `smaps_rollup`, returns false if no known field was found
+  static bool parseSmapsRollup(const char* data, size_t length, MemoryStats& out);
+  // Parses the resident size (second field, in pages) of `statm`
+  static bool parseStatmResidentPages(const char* data, size_t length, uint64_t& residentPages);
+
+  // Process memory usage in MB as int32, the legacy 4 byte buffer layout
+  int32_t* getMemoryUsageCell() {
+    return &_memoryUsageCell;
+  }
+
+private:
+  MemorySampler() = default;
+  ~MemorySampler();
+
+  void sample();
+
+  std::once_flag _started;
+  bool _supported = false;
+  int _smapsRollupFd = -1;
+  int _statmFd = -1;
+  uint64_t _pageSizeKb = 4;
+  std::array<char, READ_BUFFER_SIZE> _readBuffer{};
+  alignas(4) int32_t _memoryUsageCell = 0;
+};
+
+} // namespace margelo::nitro::performancetoolkit
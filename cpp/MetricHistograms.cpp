@@ -0,0 +1,59 @@
+#include "MetricHistograms.hpp"
+#include "SamplerRates.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+namespace margelo::nitro::performancetoolkit {
+
+MetricHistograms& MetricHistograms::get() {
+  static MetricHistograms instance;
+  return instance;
+}
+
+double MetricHistograms::scaleOf(HistogramMetric metric) {
+  switch (metric) {
+    case HistogramMetric::JsLatency:
+    case HistogramMetric::UiFrameTime:
+      return 1000.0; // ms -> us
+    default:
+      return 1.0;
+  }
+}
+
+void MetricHistograms::record(HistogramMetric metric, double value) {
+  ensureRotation();
+  const uint32_t slot = _currentSlot.load(std::memory_order_relaxed);
+  _metrics[static_cast<size_t>(metric)].slots[slot].record(HistogramBuckets::clamp(value * scaleOf(metric)));
+}
+
+HistogramSnapshot MetricHistograms::snapshot(HistogramMetric metric, uint32_t windowSeconds) const {
+  HistogramSnapshot snapshot;
+  const auto& slots = _metrics[static_cast<size_t>(metric)].slots;
+  const uint32_t current = _currentSlot.load(std::memory_order_relaxed);
+  const uint32_t slotCount = std::clamp<uint32_t>(windowSeconds, 1, MAX_WINDOW_SECONDS);
+  for (uint32_t i = 0; i < slotCount; i++) {
+    slots[(current + SLOT_COUNT - i) % SLOT_COUNT].snapshotInto(snapshot);
+  }
+  return snapshot;
+}
+
+void MetricHistograms::ensureRotation() {
+  std::call_once(_rotationStarted, [this]() {
+    TrackerScheduler::get().schedule(std::chrono::milliseconds(SLOT_DURATION_MS), [this]() -> std::optional<TrackerScheduler::Clock::duration> {
+      rotate();
+      return std::chrono::milliseconds(SLOT_DURATION_MS);
+    }, std::chrono::milliseconds(SamplerRates::GRID_MS));
+  });
+}
+
+void MetricHistograms::rotate() {
+  const uint32_t next = (_currentSlot.load(std::memory_order_relaxed) + 1) % SLOT_COUNT;
+  // The next slot is the oldest one and outside of any readable window, clear it before publishing
+  for (auto& metric : _metrics) {
+    metric.slots[next].reset();
+  }
+  _currentSlot.store(next, std::memory_order_relaxed);
+}
+
+} // namespace margelo::nitro::performancetoolkit
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "LatencyHistogram.hpp"
+#include "TrackerScheduler.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+namespace margelo::nitro::performancetoolkit {
+
+enum class HistogramMetric : uint32_t {
+  JsLatency = 0, // JS tick latency, recorded in microseconds
+  JsFps,
+  UiFps,
+  CpuUsage,      // percent
+  MemoryUsage,   // MB
+  UiFrameTime,   // UI frame duration, recorded in microseconds
+  Count,
+};
+
+// One histogram per metric, split into 1 second slots so percentiles can be computed over any
+// window up to MAX_WINDOW_SECONDS. Recording only touches the current slot (O(1), no allocation);
+// slots are rotated and cleared by a TrackerScheduler task, off the recording path.
+class MetricHistograms {
+public:
+  static constexpr uint32_t SLOT_DURATION_MS = 1000;
+  static constexpr uint32_t MAX_WINDOW_SECONDS = 10;
+
+  static MetricHistograms& get();
+
+  void record(HistogramMetric metric, double value);
+
+  // Merged snapshot of the last `windowSeconds` (including the slot currently being filled)
+  HistogramSnapshot snapshot(HistogramMetric metric, uint32_t windowSeconds) const;
+
+  // Scale applied to values before they are bucketed, e.g. ms -> us for latencies
+  static double scaleOf(HistogramMetric metric);
+
+private:
+  MetricHistograms() = default;
+
+  // Extra slot is the one being cleared for reuse while the others are readable
+  static constexpr uint32_t SLOT_COUNT = MAX_WINDOW_SECONDS + 1;
+
+  struct MetricSlots {
+    std::array<LatencyHistogram, SLOT_COUNT> slots;
+  };
+
+  void ensureRotation();
+  void rotate();
+
+  std::array<MetricSlots, static_cast<size_t>(HistogramMetric::Count)> _metrics;
+  std::atomic<uint32_t> _currentSlot{0};
+  std::once_flag _rotationStarted;
+};
+
+} // namespace margelo::nitro::performancetoolkit
@@ -0,0 +1,62 @@
+#include "MetricsBlock.hpp"
+#include "AlertRules.hpp"
+#include "MetricsSubscriptions.hpp"
+
+#include <chrono>
+#include <new>
+
+namespace margelo::nitro::performancetoolkit {
+
+static constexpr size_t BLOCK_SIZE = sizeof(MetricsBlock::Header) + sizeof(MetricsBlock::Slot) * MetricsBlock::MAX_SLOTS;
+
+static double nowMs() {
+  const auto now = std::chrono::steady_clock::now().time_since_epoch();
+  return std::chrono::duration<double, std::milli>(now).count();
+}
+
+MetricsBlock& MetricsBlock::get() {
+  static MetricsBlock instance;
+  return instance;
+}
+
+MetricsBlock::MetricsBlock() {
+  constexpr std::align_val_t alignment{CACHE_LINE_SIZE};
+  auto* bytes = static_cast<uint8_t*>(::operator new(BLOCK_SIZE, alignment));
+  _buffer = ArrayBuffer::wrap(bytes, BLOCK_SIZE, [bytes]() { ::operator delete(bytes, alignment); });
+
+  _header = new (bytes) Header{{0}, LAYOUT_VERSION, static_cast<uint32_t>(MetricSlot::Count), static_cast<uint32_t>(sizeof(Slot)), {}};
+  _slots = reinterpret_cast<Slot*>(bytes + sizeof(Header));
+  for (uint32_t i = 0; i < MAX_SLOTS; i++) {
+    new (&_slots[i]) Slot{{0.0}, {0.0}};
+  }
+}
+
+void MetricsBlock::publish(std::initializer_list<std::pair<MetricSlot, double>> values) {
+  const double updatedAtMs = nowMs();
+
+  uint32_t changedSlots = 0;
+  {
+    std::lock_guard<std::mutex> lock(_writeMutex);
+    const uint32_t sequence = _header->sequence.load(std::memory_order_relaxed);
+    _header->sequence.store(sequence + 1, std::memory_order_relaxed);
+    // Readers that see any of the slot writes below must also see the odd sequence
+    std::atomic_thread_fence(std::memory_order_release);
+
+    for (const auto& [slot, value] : values) {
+      Slot& target = _slots[static_cast<uint32_t>(slot)];
+      if (target.value.load(std::memory_order_relaxed) != value || target.updatedAtMs.load(std::memory_order_relaxed) == 0.0) {
+        changedSlots |= 1u << static_cast<uint32_t>(slot);
+      }
+      target.value.store(value, std::memory_order_relaxed);
+      target.updatedAtMs.store(updatedAtMs, std::memory_order_relaxed);
+    }
+
+    _header->sequence.store(sequence + 2, std::memory_order_release);
+  }
+  // Outside the write lock, subscriptions only merge the mask and alert rules only queue the
+  // values, both maybe schedule a task that does the work
+  MetricsSubscriptions::get().onChanged(changedSlots);
+  AlertRules::get().onSamples(values, updatedAtMs);
+}
+
+} // namespace margelo::nitro::performancetoolkit
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <NitroModules/ArrayBuffer.hpp>
+#include <atomic>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+namespace margelo::nitro::performancetoolkit {
+
+using namespace margelo::nitro;
+
+enum class MetricSlot : uint32_t {
+  JsFps = 0,
+  JsDroppedFrames,
+  UiFps,
+  CpuUsage,         // percent
+  MemoryUsage,      // MB
+  JsThreadCpuUsage, // percent of one core, only where per-thread sampling is supported (Android)
+  UiThreadCpuUsage, // percent of one core, same as above
+  MemoryPssKb,      // Memory breakdown, only where procfs is available (Android)
+  MemoryRssKb,
+  MemoryPrivateDirtyKb,
+  MemorySwapKb,
+  MemoryAnonymousKb,
+  JsHeapAllocatedBytes, // JS engine heap, only where the engine reports it (Hermes)
+  JsHeapSizeBytes,
+  JsGcCount,
+  UiDroppedFrames, // UI frame analysis (cpp/UiFrameAnalyzer.hpp), dropped frames in the last window
+  UiMaxFrameTimeMs, // ms, longest frame in the last window
+  UiStutterCount,   // frames of each class since start
+  UiJankCount,
+  UiBigJankCount,
+  UiFrozenFrameCount,
+  ToolkitCpuUsage,      // percent of one core used by the toolkit itself (cpp/ToolkitOverhead.hpp)
+  ToolkitJsThreadUsage, // percent of one core spent in toolkit tasks on JS runtimes
+  JsFpsInstant, // JS FPS sliding averages (cpp/SlidingFpsWindow.hpp), main runtime, updated every 250 ms
+  JsFps1s,
+  JsFps5s,
+  JsFpsSession, // since tracking started or the tracking mode changed
+  CounterUpdateIntervalMs, // sampling profile's refresh period of the UI counter hooks, 0 = off
+  Count,
+};
+
+// All latest metric values in a single ArrayBuffer, so JS and worklets can read every metric
+// with one DataView instead of one Nitro call (and one ArrayBuffer) per metric.
+// Writers are serialized and publish through a seqlock, readers never block and retry if they
+// raced with a write, so a snapshot never mixes values from two different updates.
+//
+// Layout (little-endian, see src/metricsBlock.ts for the reader):
+//
+//   Header (64 bytes, one cache line)
+//     0  uint32   sequence      - seqlock, odd while a write is in progress
+//     4  uint32   layoutVersion - bumped whenever the layout changes
+//     8  uint32   slotCount     - number of metric slots that are defined
+//    12  uint32   slotSize      - size of one slot in bytes
+//    16  reserved
+//   Slots (MAX_SLOTS * 16 bytes), slot N is MetricSlot N
+//     0  float64  value
+//     8  float64  updatedAtMs   - steady clock ms (same timebase as `performance.now()`), 0 = never written
+//
+// The buffer is cache line aligned and the header has its own line, so the sequence counter
+// doesn't share a line with the slots being written.
+class MetricsBlock {
+public:
+  static constexpr uint32_t LAYOUT_VERSION = 2; // 2: MAX_SLOTS grew from 16 to 32
+  // Slots reserved in the buffer. Metrics can be added up to it without a layout change, growing
+  // it changes the buffer size and needs a LAYOUT_VERSION bump
+  static constexpr uint32_t MAX_SLOTS = 32;
+  static constexpr size_t CACHE_LINE_SIZE = 64;
+
+  struct Header {
+    std::atomic<uint32_t> sequence;
+    uint32_t layoutVersion;
+    uint32_t slotCount;
+    uint32_t slotSize;
+    uint8_t reserved[CACHE_LINE_SIZE - 16];
+  };
+
+  struct Slot {
+    std::atomic<double> value;
+    std::atomic<double> updatedAtMs;
+  };
+
+  static_assert(sizeof(Header) == CACHE_LINE_SIZE, "Header layout is shared with JS");
+  static_assert(sizeof(Slot) == 16, "Slot layout is shared with JS");
+  static_assert(std::atomic<uint32_t>::is_always_lock_free, "sequence must be lock-free to be shared with JS");
+  static_assert(std::atomic<double>::is_always_lock_free, "slots must be lock-free to be shared with JS");
+  static_assert(static_cast<uint32_t>(MetricSlot::Count) <= MAX_SLOTS, "Too many metric slots");
+
+  static MetricsBlock& get();
+
+  // Publishes several values as one consistent update
+  void publish(std::initializer_list<std::pair<MetricSlot, double>> values);
+
+  void publish(MetricSlot slot, double value) {
+    publish({{slot, value}});
+  }
+
+  // Latest value of one slot, for native consumers (MetricsSubscriptions)
+  double read(MetricSlot slot) const {
+    return _slots[static_cast<uint32_t>(slot)].value.load(std::memory_order_relaxed);
+  }
+
+  const std::shared_ptr<ArrayBuffer>& getBuffer() const {
+    return _buffer;
+  }
+
+private:
+  MetricsBlock();
+
+  std::shared_ptr<ArrayBuffer> _buffer;
+  Header* _header;
+  Slot* _slots;
+  std::mutex _writeMutex;
+};
+
+} // namespace margelo::nitro::performancetoolkit
@@ -0,0 +1,106 @@
+#include "MetricsSubscriptions.hpp"
+#include "RuntimeBridge.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+
+namespace margelo::nitro::performancetoolkit {
+
+MetricsSubscriptions& MetricsSubscriptions::get() {
+  static MetricsSubscriptions instance;
+  return instance;
+}
+
+MetricsSubscriptions::ListenerId MetricsSubscriptions::add(Listener listener, std::vector<double> minChanges) {
+  auto entry = std::make_shared<Entry>();
+  entry->listener = std::move(listener);
+  entry->minChanges.fill(0.0);
+  for (size_t slot = 0; slot < minChanges.size() && slot < MetricsBlock::MAX_SLOTS; slot++) {
+    entry->minChanges[slot] = std::max(minChanges[slot], 0.0);
+  }
+  // NaN never compares equal, so the first change of every slot is delivered
+  entry->lastDelivered.fill(std::numeric_limits<double>::quiet_NaN());
+
+  std::lock_guard<std::mutex> lock(_mutex);
+  entry->id = _nextListenerId++;
+  auto entries = std::make_shared<std::vector<std::shared_ptr<Entry>>>(*_entries);
+  entries->push_back(entry);
+  _entryCount.store(entries->size(), std::memory_order_relaxed);
+  _entries = std::move(entries);
+  return entry->id;
+}
+
+void MetricsSubscriptions::remove(ListenerId id) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  auto entries = std::make_shared<std::vector<std::shared_ptr<Entry>>>(*_entries);
+  entries->erase(
+    std::remove_if(entries->begin(), entries->end(), [id](const auto& entry) { return entry->id == id; }),
+    entries->end()
+  );
+  _entryCount.store(entries->size(), std::memory_order_relaxed);
+  _entries = std::move(entries);
+}
+
+void MetricsSubscriptions::onChanged(uint32_t changedSlots) {
+  // Called on every publish, nobody listening costs one relaxed load
+  if (changedSlots == 0 || _entryCount.load(std::memory_order_relaxed) == 0) {
+    return;
+  }
+  _pendingSlots.fetch_or(changedSlots, std::memory_order_relaxed);
+  bool expected = false;
+  if (!_deliveryScheduled.compare_exchange_strong(expected, true)) {
+    return; // Merged into the delivery that is already scheduled
+  }
+  // Delivered on the next frame interval boundary of the scheduler clock, at most one delivery per
+  // interval, and a change published by a grid-aligned sampler lands on the same wakeup
+  const auto frameInterval = std::chrono::nanoseconds(static_cast<int64_t>(RuntimeBridgeState::get().getFrameIntervalMs() * 1'000'000.0));
+  TrackerScheduler::get().schedule(TrackerScheduler::Clock::duration::zero(), [this]() -> std::optional<TrackerScheduler::Clock::duration> {
+    deliver();
+    return std::nullopt;
+  }, frameInterval);
+}
+
+void MetricsSubscriptions::deliver() {
+  // Changes published from here on schedule the next delivery
+  _deliveryScheduled.store(false);
+  const uint32_t pending = _pendingSlots.exchange(0, std::memory_order_relaxed);
+
+  std::shared_ptr<const std::vector<std::shared_ptr<Entry>>> entries;
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    entries = _entries;
+  }
+  if (entries->empty()) {
+    return;
+  }
+
+  std::array<double, MetricsBlock::MAX_SLOTS> values{};
+  for (uint32_t slot = 0; slot < MetricsBlock::MAX_SLOTS; slot++) {
+    if ((pending & (1u << slot)) != 0) {
+      values[slot] = MetricsBlock::get().read(static_cast<MetricSlot>(slot));
+    }
+  }
+
+  for (const auto& entry : *entries) {
+    uint32_t changed = 0;
+    for (uint32_t slot = 0; slot < MetricsBlock::MAX_SLOTS; slot++) {
+      if ((pending & (1u << slot)) == 0) {
+        continue;
+      }
+      const double last = entry->lastDelivered[slot];
+      const double delta = std::abs(values[slot] - last);
+      // NaN delta means nothing was delivered for the slot yet
+      if (std::isnan(delta) || (delta > 0.0 && delta >= entry->minChanges[slot])) {
+        entry->lastDelivered[slot] = values[slot];
+        changed |= 1u << slot;
+      }
+    }
+    if (changed != 0) {
+      entry->listener(changed);
+    }
+  }
+}
+
+} // namespace margelo::nitro::performancetoolkit
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "MetricsBlock.hpp"
+#include "TrackerScheduler.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace margelo::nitro::performancetoolkit {
+
+// Push-based change notifications for the metrics block, replacing per-widget polling timers.
+//
+// MetricsBlock reports which slots changed value on every publish. Changes are collected into a
+// pending mask and delivered in one batch per listener, at most once per frame interval: the
+// first change after a quiet period schedules a delivery on the TrackerScheduler, aligned to the
+// next frame interval boundary of its clock, later changes before it runs are merged into it.
+// While nobody listens changes are dropped without touching the scheduler. A listener only sees slots whose value moved by at least
+// its `minChanges` entry since the value it was last given (any change by default).
+//
+// Listeners are called on the scheduler thread with a bitmask of changed MetricSlots and must
+// not block. Nitro callbacks from JS are dispatched to their runtime asynchronously, so the
+// JS side reads the values from the shared buffer itself.
+class MetricsSubscriptions {
+public:
+  using ListenerId = uint64_t;
+  using Listener = std::function<void(uint32_t changedSlots)>;
+
+  static MetricsSubscriptions& get();
+
+  // `minChanges[slot]`, missing entries mean any change
+  ListenerId add(Listener listener, std::vector<double> minChanges);
+  void remove(ListenerId id);
+
+  // Called by MetricsBlock after a publish, with the slots whose value changed
+  void onChanged(uint32_t changedSlots);
+
+private:
+  MetricsSubscriptions() = default;
+
+  struct Entry {
+    ListenerId id;
+    Listener listener;
+    std::array<double, MetricsBlock::MAX_SLOTS> minChanges;
+    std::array<double, MetricsBlock::MAX_SLOTS> lastDelivered; // Writer: delivery task only
+  };
+
+  void deliver();
+
+  std::mutex _mutex;
+  // Copy-on-write, so a delivery never holds the lock while calling listeners
+  std::shared_ptr<const std::vector<std::shared_ptr<Entry>>> _entries = std::make_shared<const std::vector<std::shared_ptr<Entry>>>();
+  ListenerId _nextListenerId = 1;
+
+  std::atomic<uint32_t> _pendingSlots{0};
+  std::atomic<bool> _deliveryScheduled{false};
+  std::atomic<size_t> _entryCount{0}; // Size of _entries, read without the lock on every publish
+};
+
+} // namespace margelo::nitro::performancetoolkit
@@ -0,0 +1,81 @@
+#include "PlatformBridge.hpp"
+#include "CpuSampler.hpp"
+#include "MemorySampler.hpp"
+#include "MetricHistograms.hpp"
+#include "MetricsBlock.hpp"
+#include "RuntimeBridge.hpp"
+#include "SessionRecorder.hpp"
+#include "StartupTracer.hpp"
+#include "ToolkitOverhead.hpp"
+#include "UiFrameAnalyzer.hpp"
+#include "UiFrameSource.hpp"
+
+#include <chrono>
+
+namespace margelo::nitro::performancetoolkit {
+
+static int64_t nowNs() {
+  const auto now = std::chrono::steady_clock::now().time_since_epoch();
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+}
+
+void PlatformBridge::notifyUiFrame(int64_t frameTimeNs, int64_t targetFrameTimeNs, int64_t platformNowNs) {
+  ToolkitOverhead::ScopedTimer timer(ToolkitOverhead::TimedWork::UiFrame);
+  // Keeps the vsync times (not when the callback ran), off by the few ns between the two clock reads
+  const int64_t toSteadyNs = nowNs() - platformNowNs;
+  const int64_t steadyFrameTimeNs = frameTimeNs + toSteadyNs;
+  const int64_t steadyTargetTimeNs = targetFrameTimeNs != 0 ? targetFrameTimeNs + toSteadyNs : 0;
+  UiFrameAnalyzer::get().onFrame(steadyFrameTimeNs, steadyTargetTimeNs);
+  UiFrameSource::get().onFrame(steadyFrameTimeNs);
+  StartupTracer::get().mark(StartupMilestone::FirstUiFrame);
+}
+
+void PlatformBridge::notifyNativeLibraryLoaded() {
+  StartupTracer::get().mark(StartupMilestone::NativeLibraryLoaded);
+}
+
+void PlatformBridge::notifyBindingsInstalled() {
+  StartupTracer::get().mark(StartupMilestone::BindingsInstalled);
+}
+
+void PlatformBridge::notifyFirstUiFrame() {
+  StartupTracer::get().mark(StartupMilestone::FirstUiFrame);
+}
+
+void PlatformBridge::setCacheDirectory(const char* path) {
+  SessionRecorder::get().setDirectory(path);
+}
+
+void PlatformBridge::notifyRefreshRateChanged(double refreshRate) {
+  RuntimeBridgeState::get().setDeviceRefreshRate(refreshRate);
+}
+
+int32_t* PlatformBridge::getUiFpsCell() {
+  return UiFrameAnalyzer::get().getUiFpsCell();
+}
+
+int32_t* PlatformBridge::getCpuUsageCell() {
+  CpuSampler& sampler = CpuSampler::get();
+  sampler.start();
+  return sampler.getCpuUsageCell();
+}
+
+int32_t* PlatformBridge::getMemoryUsageCell() {
+  MemorySampler& sampler = MemorySampler::get();
+  sampler.start();
+  return sampler.getMemoryUsageCell();
+}
+
+void PlatformBridge::recordCpuUsage(double percent) {
+  MetricHistograms::get().record(HistogramMetric::CpuUsage, percent);
+  MetricsBlock::get().publish(MetricSlot::CpuUsage, percent);
+  SessionRecorder::get().record(SessionRecordType::CpuUsage, nowNs(), percent);
+}
+
+void PlatformBridge::recordMemoryUsage(double megabytes) {
+  MetricHistograms::get().record(HistogramMetric::MemoryUsage, megabytes);
+  MetricsBlock::get().publish(MetricSlot::MemoryUsage, megabytes);
+  SessionRecorder::get().record(SessionRecordType::MemoryUsage, nowNs(), megabytes);
+}
+
+} // namespace margelo::nitro::performancetoolkit
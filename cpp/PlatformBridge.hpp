@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdint>
+
+namespace margelo::nitro::performancetoolkit {
+
+// Entry points for the platform (Kotlin via JNI, Swift via C++ interop) to push native
+// events into the shared C++ core. Keep this header free of JSI/Nitro includes so it can
+// be imported from Swift.
+struct PlatformBridge {
+  // Called from the UI frame callback (Choreographer.doFrame / CADisplayLink) on every frame.
+  // `targetFrameTimeNs` is when the next frame is due (CADisplayLink.targetTimestamp), 0 if unknown.
+  // Both are in the platform's frame timebase, `platformNowNs` is that clock read in the same
+  // callback (System.nanoTime, CACurrentMediaTime), so they can be moved to the steady clock every
+  // other sample uses. The timebases differ on iOS (mach absolute time stops during sleep)
+  static void notifyUiFrame(int64_t frameTimeNs, int64_t targetFrameTimeNs, int64_t platformNowNs);
+  // Called when the display switches its refresh rate (ProMotion, Android adaptive refresh rate)
+  static void notifyRefreshRateChanged(double refreshRate);
+
+  // Startup milestones only the platform sees (cpp/StartupTracer.hpp), each is recorded once per
+  // process. A forwarded UI frame also counts as the first one
+  static void notifyNativeLibraryLoaded();
+  static void notifyBindingsInstalled();
+  static void notifyFirstUiFrame();
+
+  // App cache directory, session recordings are written there by default
+  static void setCacheDirectory(const char* path);
+
+  // UI FPS of the last window as int32 (the legacy 4 byte buffer layout), computed from the forwarded frames
+  static int32_t* getUiFpsCell();
+  // Start the shared C++ samplers (on the TrackerScheduler thread, never the UI thread) and return
+  // their legacy int32 cells: process CPU usage in percent, memory usage in MB. The samplers are
+  // process-wide singletons, the cells outlive any buffer wrapping them
+  static int32_t* getCpuUsageCell();
+  static int32_t* getMemoryUsageCell();
+
+  // Called whenever the samplers publish a new value, feeds the metric histograms and the metrics block
+  static void recordCpuUsage(double percent);
+  static void recordMemoryUsage(double megabytes);
+};
+
+} // namespace margelo::nitro::performancetoolkit
@@ -1,4 +1,8 @@
 #include "RuntimeBridge.hpp"
+#include "StartupTracer.hpp"
+
+#include <algorithm>
+#include <stdexcept>
 
 namespace margelo::nitro::performancetoolkit {
 
@@ -8,15 +12,139 @@ RuntimeBridgeState& RuntimeBridgeState::get() {
   return instance;
 }
 
-void RuntimeBridgeState::setRuntimeExecutor(RuntimeExecutor executor) {
-  _runtimeExecutor = std::make_unique<RuntimeExecutor>(executor);
+uint64_t RuntimeBridgeState::setRuntimeExecutor(RuntimeExecutor executor) {
+  std::vector<RuntimeExecutor> retired; // Destroyed after the lock is released
+  uint64_t registrationId;
+  {
+    std::lock_guard<std::mutex> lock(_runtimesMutex);
+    for (const auto& runtime : _runtimes) {
+      if (runtime.name != MAIN_RUNTIME_NAME) {
+        retired.push_back(rebind(*bindingFor(runtime.name), nullptr, 0));
+      }
+    }
+    _runtimes.clear();
+    registrationId = addRuntime(MAIN_RUNTIME_NAME, std::move(executor), retired);
+  }
+  StartupTracer::get().onMainRuntimeRegistered(getBoundExecutor(MAIN_RUNTIME_NAME));
+  return registrationId;
+}
+
+RuntimeExecutor RuntimeBridgeState::getRuntimeExecutor() {
+  std::lock_guard<std::mutex> lock(_runtimesMutex);
+  for (const auto& runtime : _runtimes) {
+    if (runtime.name == MAIN_RUNTIME_NAME) {
+      return runtime.executor;
+    }
+  }
+  throw std::runtime_error("RuntimeExecutor not initialized in RuntimeBridgeState!");
+}
+
+uint64_t RuntimeBridgeState::registerRuntime(const std::string& name, RuntimeExecutor executor) {
+  if (name == MAIN_RUNTIME_NAME) {
+    return setRuntimeExecutor(std::move(executor));
+  }
+  std::vector<RuntimeExecutor> retired;
+  std::lock_guard<std::mutex> lock(_runtimesMutex);
+  return addRuntime(name, std::move(executor), retired);
+}
+
+void RuntimeBridgeState::unregisterRuntime(const std::string& name) {
+  unregisterRuntime(name, getRegistrationId(name));
+}
+
+void RuntimeBridgeState::unregisterRuntime(const std::string& name, uint64_t registrationId) {
+  RuntimeExecutor retired;
+  std::lock_guard<std::mutex> lock(_runtimesMutex);
+  const auto end = std::remove_if(_runtimes.begin(), _runtimes.end(), [&](const RegisteredRuntime& runtime) {
+    return runtime.name == name && runtime.registrationId == registrationId;
+  });
+  if (end != _runtimes.end()) {
+    _runtimes.erase(end, _runtimes.end());
+    retired = rebind(*bindingFor(name), nullptr, 0);
+    _runtimesVersion.fetch_add(1);
+  }
+}
+
+void RuntimeBridgeState::resetForTesting() {
+  std::vector<RuntimeExecutor> retired; // Destroyed after the lock is released
+  std::lock_guard<std::mutex> lock(_runtimesMutex);
+  for (const auto& runtime : _runtimes) {
+    retired.push_back(rebind(*bindingFor(runtime.name), nullptr, 0));
+  }
+  if (!_runtimes.empty()) {
+    _runtimes.clear();
+    _runtimesVersion.fetch_add(1);
+  }
+}
+
+std::vector<RuntimeBridgeState::RegisteredRuntime> RuntimeBridgeState::getRuntimes() {
+  std::lock_guard<std::mutex> lock(_runtimesMutex);
+  return _runtimes;
 }
 
-const RuntimeExecutor& RuntimeBridgeState::getRuntimeExecutor() {
-  if (_runtimeExecutor == nullptr) {
-    throw std::runtime_error("RuntimeExecutor not initialized in RuntimeBridgeState!");
+uint64_t RuntimeBridgeState::getRegistrationId(const std::string& name) {
+  std::lock_guard<std::mutex> lock(_runtimesMutex);
+  for (const auto& runtime : _runtimes) {
+    if (runtime.name == name) {
+      return runtime.registrationId;
+    }
   }
-  return *_runtimeExecutor;
+  return 0;
+}
+
+uint64_t RuntimeBridgeState::getRuntimesVersion() const {
+  return _runtimesVersion.load();
+}
+
+RuntimeExecutor RuntimeBridgeState::getBoundExecutor(const std::string& name) {
+  std::shared_ptr<Binding> binding;
+  {
+    std::lock_guard<std::mutex> lock(_runtimesMutex);
+    binding = bindingFor(name);
+  }
+  return [binding](std::function<void(jsi::Runtime&)>&& task) {
+    std::shared_lock<std::shared_mutex> lock(binding->mutex);
+    if (binding->executor) {
+      binding->executor(std::move(task));
+    }
+  };
+}
+
+std::shared_ptr<RuntimeBridgeState::Binding> RuntimeBridgeState::bindingFor(const std::string& name) {
+  auto& binding = _bindings[name];
+  if (binding == nullptr) {
+    binding = std::make_shared<Binding>();
+  }
+  return binding;
+}
+
+uint64_t RuntimeBridgeState::addRuntime(const std::string& name, RuntimeExecutor executor, std::vector<RuntimeExecutor>& retired) {
+  _runtimes.erase(
+    std::remove_if(_runtimes.begin(), _runtimes.end(), [&name](const RegisteredRuntime& runtime) { return runtime.name == name; }),
+    _runtimes.end()
+  );
+  const uint64_t registrationId = _nextRegistrationId++;
+  auto binding = bindingFor(name);
+  retired.push_back(rebind(*binding, std::move(executor), registrationId));
+  _runtimes.push_back(RegisteredRuntime{name, registrationId, guardedExecutor(binding, registrationId)});
+  _runtimesVersion.fetch_add(1);
+  return registrationId;
+}
+
+RuntimeExecutor RuntimeBridgeState::rebind(Binding& binding, RuntimeExecutor executor, uint64_t registrationId) {
+  std::unique_lock<std::shared_mutex> lock(binding.mutex);
+  std::swap(binding.executor, executor);
+  binding.registrationId = registrationId;
+  return executor;
+}
+
+RuntimeExecutor RuntimeBridgeState::guardedExecutor(std::shared_ptr<Binding> binding, uint64_t registrationId) {
+  return [binding = std::move(binding), registrationId](std::function<void(jsi::Runtime&)>&& task) {
+    std::shared_lock<std::shared_mutex> lock(binding->mutex);
+    if (binding->registrationId == registrationId && binding->executor) {
+      binding->executor(std::move(task));
+    }
+  };
 }
 
 void RuntimeBridgeState::setDeviceRefreshRate(double fps) {
@@ -30,11 +158,10 @@ double RuntimeBridgeState::getDeviceRefreshRate() const {
 }
 
 double RuntimeBridgeState::getFrameIntervalMs() const {
-  return 1000.0 / _deviceRefreshRate;
+  return 1000.0 / _deviceRefreshRate.load();
 }
 
 // Android-specific RuntimeBridge has been moved to NativePerformanceToolkitModule
 // iOS uses PerformanceToolkitModule.mm to capture the CallInvoker
 
 } // namespace margelo::nitro::performancetoolkit
-
@@ -2,7 +2,14 @@
 
 #include <jsi/jsi.h>
 #include <ReactCommon/RuntimeExecutor.h>
+#include <atomic>
+#include <cstdint>
 #include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace margelo::nitro::performancetoolkit {
 
@@ -14,23 +21,87 @@ using namespace facebook::react;
 // 
 // On Android: Initialized by NativePerformanceToolkitModule (TurboModule)
 // On iOS: Initialized by PerformanceToolkitModule.mm (TurboModule)
+//
+// Besides the main JS runtime, other runtimes (the worklets UI runtime, worker runtimes) can be
+// registered by name with an executor that runs tasks on their thread, trackers pick them up
+// through `getRuntimes` and watch `getRuntimesVersion` for changes.
+//
+// Every registration of a name is a new generation (registrationId). Executors handed out by the
+// registry never call into a replaced or unregistered executor: a registration's own executor
+// drops tasks once it is retired, a bound executor (`getBoundExecutor`) follows the name to its
+// current registration. Retiring waits for posts already inside the old executor to return, which
+// only enqueue, so it never waits on a JS thread. Executors must not run tasks inline.
 class RuntimeBridgeState {
 public:
+  static constexpr const char* MAIN_RUNTIME_NAME = "main";
+  static constexpr const char* UI_RUNTIME_NAME = "ui"; // Worklets runtime on the UI thread
+
+  struct RegisteredRuntime {
+    std::string name;
+    uint64_t registrationId; // Generation of the name, changes when it is registered again, e.g. after a reload
+    RuntimeExecutor executor; // Posts to this registration only, drops tasks once it is retired
+  };
+
   static RuntimeBridgeState& get();
 
-  void setRuntimeExecutor(RuntimeExecutor executor);
-  const RuntimeExecutor& getRuntimeExecutor();
+  // Registers the main JS runtime (MAIN_RUNTIME_NAME) and returns its registrationId. A new main
+  // runtime means the app reloaded, so runtimes created alongside the old one are unregistered
+  uint64_t setRuntimeExecutor(RuntimeExecutor executor);
+  // Executor of the main JS runtime's current registration, throws if it wasn't set yet
+  RuntimeExecutor getRuntimeExecutor();
+
+  // Registers or replaces the runtime called `name` and returns its registrationId, the executor
+  // must be callable from any thread
+  uint64_t registerRuntime(const std::string& name, RuntimeExecutor executor);
+  void unregisterRuntime(const std::string& name);
+  // Unregisters `name` only while `registrationId` is its current registration, for owners tearing
+  // down a runtime that may already have been replaced by a reload
+  void unregisterRuntime(const std::string& name, uint64_t registrationId);
+  std::vector<RegisteredRuntime> getRuntimes();
+  // Current registrationId of `name`, 0 while it isn't registered
+  uint64_t getRegistrationId(const std::string& name);
+  // Incremented on every (un)registration
+  uint64_t getRuntimesVersion() const;
+
+  // Executor that posts to whatever runtime is registered as `name` at the time of the post, tasks
+  // posted while the name isn't registered are dropped. Valid for the lifetime of the process, so
+  // long-lived trackers keep it across reloads instead of re-fetching executors
+  RuntimeExecutor getBoundExecutor(const std::string& name);
+
+  // Unregisters every runtime, the registry is left as a new process has it. Tests only
+  void resetForTesting();
 
   // Device capabilities
+  // The refresh rate can change at runtime (ProMotion, Android adaptive refresh rate), the platform
+  // pushes updates through PlatformBridge, so readers should re-read it instead of caching it
   void setDeviceRefreshRate(double fps);
   double getDeviceRefreshRate() const;
   double getFrameIntervalMs() const;
 
 private:
   RuntimeBridgeState() = default;
-  std::unique_ptr<RuntimeExecutor> _runtimeExecutor;
-  double _deviceRefreshRate = 60.0; // Default to 60 FPS
+
+  // One per name ever registered, never removed so bound executors can hold on to it
+  struct Binding {
+    std::shared_mutex mutex; // Shared while posting, exclusive while swapping the executor
+    RuntimeExecutor executor; // Empty while the name isn't registered
+    uint64_t registrationId = 0;
+  };
+
+  // Both called with _runtimesMutex held
+  std::shared_ptr<Binding> bindingFor(const std::string& name);
+  uint64_t addRuntime(const std::string& name, RuntimeExecutor executor, std::vector<RuntimeExecutor>& retired);
+  // Swaps the binding's executor. The old one is handed back to be destroyed once no lock is held,
+  // releasing it can take locks of its own (UiThreadExecutor removes its frame listener)
+  static RuntimeExecutor rebind(Binding& binding, RuntimeExecutor executor, uint64_t registrationId);
+  static RuntimeExecutor guardedExecutor(std::shared_ptr<Binding> binding, uint64_t registrationId);
+
+  std::mutex _runtimesMutex;
+  std::vector<RegisteredRuntime> _runtimes;
+  std::unordered_map<std::string, std::shared_ptr<Binding>> _bindings;
+  uint64_t _nextRegistrationId = 1;
+  std::atomic<uint64_t> _runtimesVersion{0};
+  std::atomic<double> _deviceRefreshRate = 60.0; // Default to 60 FPS
 };
 
 } // namespace margelo::nitro::performancetoolkit
-
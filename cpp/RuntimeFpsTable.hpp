@@ -0,0 +1,119 @@
+#pragma once
+
+#include <NitroModules/ArrayBuffer.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace margelo::nitro::performancetoolkit {
+
+using namespace margelo::nitro;
+
+// FPS of every tracked JS runtime (main, worklets UI runtime, workers), one fixed slot per runtime
+// stored directly inside an ArrayBuffer so JS and worklets can read it zero-copy with a DataView.
+// Slot 0 is always the main runtime, names of the other slots come from `getNames`.
+//
+// Layout (little-endian, see src/runtimeFps.ts for the reader):
+//
+//   Header (16 bytes)
+//     0  uint32   capacity      - number of runtime slots
+//     4  uint32   recordSize    - size of one slot in bytes
+//     8  reserved
+//   Slots (capacity * 32 bytes)
+//     0  uint32   active        - 1 while a runtime is tracked in this slot
+//     4  int32    fps
+//     8  int32    droppedFrames - relative to the current refresh rate, in the last window
+//    12  reserved
+//    16  float64  maxLatencyMs  - longest wait of a probe in the last window
+//    24  float64  updatedAtMs   - steady clock ms (same timebase as `performance.now()`), 0 = never written
+//
+// Each slot has a single writer (its tracker's report on the scheduler thread). Fields are
+// written one by one like the per-metric FPS buffers, a reader may see a slot mid-update.
+class RuntimeFpsTable {
+public:
+  static constexpr uint32_t CAPACITY = 8;
+  static constexpr uint32_t MAIN_SLOT = 0;
+
+  struct Header {
+    uint32_t capacity;
+    uint32_t recordSize;
+    uint32_t reserved[2];
+  };
+
+  struct Record {
+    std::atomic<uint32_t> active;
+    std::atomic<int32_t> fps;
+    std::atomic<int32_t> droppedFrames;
+    uint32_t reserved;
+    std::atomic<double> maxLatencyMs;
+    std::atomic<double> updatedAtMs;
+  };
+
+  static_assert(sizeof(Header) == 16, "Header layout is shared with JS");
+  static_assert(sizeof(Record) == 32, "Record layout is shared with JS");
+
+  RuntimeFpsTable() : _buffer(ArrayBuffer::allocate(sizeof(Header) + sizeof(Record) * CAPACITY)), _names(CAPACITY) {
+    auto* bytes = _buffer->data();
+    new (bytes) Header{CAPACITY, static_cast<uint32_t>(sizeof(Record)), {}};
+    _records = reinterpret_cast<Record*>(bytes + sizeof(Header));
+    for (uint32_t i = 0; i < CAPACITY; i++) {
+      new (&_records[i]) Record{{0}, {0}, {0}, 0, {0.0}, {0.0}};
+    }
+    _names[MAIN_SLOT] = "main";
+    _records[MAIN_SLOT].active.store(1, std::memory_order_relaxed);
+  }
+
+  // Reserves a slot for the runtime `name`, nullopt if all slots are taken
+  std::optional<uint32_t> acquire(const std::string& name) {
+    std::lock_guard<std::mutex> lock(_namesMutex);
+    for (uint32_t i = MAIN_SLOT + 1; i < CAPACITY; i++) {
+      if (_names[i].empty()) {
+        _names[i] = name;
+        write(i, 0, 0, 0.0);
+        _records[i].updatedAtMs.store(0.0, std::memory_order_relaxed);
+        _records[i].active.store(1, std::memory_order_release);
+        return i;
+      }
+    }
+    return std::nullopt;
+  }
+
+  void release(uint32_t slot) {
+    std::lock_guard<std::mutex> lock(_namesMutex);
+    _records[slot].active.store(0, std::memory_order_release);
+    _names[slot].clear();
+  }
+
+  void write(uint32_t slot, int32_t fps, int32_t droppedFrames, double maxLatencyMs) {
+    Record& record = _records[slot];
+    record.fps.store(fps, std::memory_order_relaxed);
+    record.droppedFrames.store(droppedFrames, std::memory_order_relaxed);
+    record.maxLatencyMs.store(maxLatencyMs, std::memory_order_relaxed);
+    const auto now = std::chrono::steady_clock::now().time_since_epoch();
+    record.updatedAtMs.store(std::chrono::duration<double, std::milli>(now).count(), std::memory_order_release);
+  }
+
+  // Runtime name per slot, empty for free slots
+  std::vector<std::string> getNames() {
+    std::lock_guard<std::mutex> lock(_namesMutex);
+    return _names;
+  }
+
+  const std::shared_ptr<ArrayBuffer>& getBuffer() const {
+    return _buffer;
+  }
+
+private:
+  std::shared_ptr<ArrayBuffer> _buffer;
+  Record* _records;
+  std::mutex _namesMutex;
+  std::vector<std::string> _names;
+};
+
+} // namespace margelo::nitro::performancetoolkit
@@ -0,0 +1,242 @@
+#include "RuntimeTrackers.hpp"
+#include "JsFpsTracker.hpp"
+#include "JsFrameTimeline.hpp"
+#include "JsLagEvents.hpp"
+#include "LongTaskRecorder.hpp"
+#include "MetricsBlock.hpp"
+#include "RuntimeBridge.hpp"
+#include "RuntimeFpsTable.hpp"
+#include "SamplerRates.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+namespace margelo::nitro::performancetoolkit {
+
+RuntimeTrackers& RuntimeTrackers::get() {
+  static RuntimeTrackers instance(TrackerScheduler::get());
+  return instance;
+}
+
+RuntimeTrackers::RuntimeTrackers(TrackerScheduler& scheduler)
+    : _scheduler(scheduler),
+      _fpsBuffer(ArrayBuffer::allocate(sizeof(int32_t))),
+      _droppedFramesBuffer(ArrayBuffer::allocate(sizeof(int32_t))),
+      _timeline(std::make_shared<JsFrameTimeline>()),
+      _lagEvents(std::make_shared<JsLagEvents>()),
+      _longTasks(std::make_shared<LongTaskRecorder>()),
+      _runtimeTable(std::make_shared<RuntimeFpsTable>()),
+      _windowMs(static_cast<uint32_t>(JsFpsTracker::FPS_WINDOW_MS)) {
+  // Owning, 4 bytes for one Int32 value each. Dropped frames are relative to the current refresh rate
+  *reinterpret_cast<int32_t*>(_fpsBuffer->data()) = 0;
+  *reinterpret_cast<int32_t*>(_droppedFramesBuffer->data()) = 0;
+}
+
+RuntimeTrackers::~RuntimeTrackers() {
+  stop();
+}
+
+void RuntimeTrackers::start() {
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _started = true;
+    if (_paused) {
+      return;
+    }
+    startLocked();
+  }
+  sync();
+}
+
+void RuntimeTrackers::stop() {
+  std::lock_guard<std::mutex> lock(_mutex);
+  _started = false;
+  stopLocked();
+}
+
+void RuntimeTrackers::setPaused(bool paused) {
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (paused == _paused) {
+      return;
+    }
+    _paused = paused;
+    if (paused) {
+      stopLocked();
+      return;
+    }
+    if (!_started) {
+      return;
+    }
+    startLocked();
+  }
+  sync();
+}
+
+bool RuntimeTrackers::isPaused() const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _paused;
+}
+
+void RuntimeTrackers::startLocked() {
+  if (_syncTask == 0) {
+    // The sync task only runs while this object exists, stop() cancels it
+    _syncTask = _scheduler.schedule(std::chrono::milliseconds(RUNTIME_SYNC_INTERVAL_MS), [this]() -> std::optional<TrackerScheduler::Clock::duration> {
+      sync();
+      return std::chrono::milliseconds(RUNTIME_SYNC_INTERVAL_MS);
+    }, std::chrono::milliseconds(SamplerRates::GRID_MS)); // Shares the samplers' wakeups
+  }
+}
+
+void RuntimeTrackers::stopLocked() {
+  if (_syncTask != 0) {
+    _scheduler.cancel(_syncTask);
+    _syncTask = 0;
+  }
+  for (auto& entry : _trackers) {
+    entry.tracker->stop();
+    if (entry.slot != RuntimeFpsTable::MAIN_SLOT) {
+      _runtimeTable->release(entry.slot);
+    }
+  }
+  _trackers.clear();
+  _syncedVersion = 0;
+}
+
+void RuntimeTrackers::setWindowMs(uint32_t windowMs) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  _windowMs = windowMs;
+  for (auto& entry : _trackers) {
+    entry.tracker->setWindowMs(windowMs);
+  }
+}
+
+uint32_t RuntimeTrackers::getWindowMs() const {
+  return _windowMs;
+}
+
+void RuntimeTrackers::setTimelineEnabled(bool enabled) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  _timelineEnabled = enabled;
+  for (auto& entry : _trackers) {
+    entry.tracker->setTimelineEnabled(enabled);
+  }
+}
+
+bool RuntimeTrackers::isTimelineEnabled() const {
+  return _timelineEnabled;
+}
+
+void RuntimeTrackers::setMode(JsFpsTrackingMode mode) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  _mode = mode;
+  for (auto& entry : _trackers) {
+    entry.tracker->setMode(mode);
+  }
+}
+
+JsFpsTrackingMode RuntimeTrackers::getMode() const {
+  return _mode;
+}
+
+void RuntimeTrackers::sync() {
+  const uint64_t version = RuntimeBridgeState::get().getRuntimesVersion();
+  std::lock_guard<std::mutex> lock(_mutex);
+  if (_syncTask == 0 || version == _syncedVersion) {
+    return;
+  }
+  _syncedVersion = version;
+  const auto runtimes = RuntimeBridgeState::get().getRuntimes();
+
+  // Re-bind trackers of runtimes registered again, stop those of runtimes that are gone. The main
+  // tracker is never stopped, without a main runtime its probes are dropped and it reports a stall
+  _trackers.erase(std::remove_if(_trackers.begin(), _trackers.end(), [&](Entry& entry) {
+    const auto runtime = std::find_if(runtimes.begin(), runtimes.end(), [&entry](const auto& runtime) {
+      return runtime.name == entry.name;
+    });
+    if (runtime == runtimes.end()) {
+      if (entry.slot == RuntimeFpsTable::MAIN_SLOT) {
+        return false;
+      }
+      entry.tracker->stop();
+      _runtimeTable->release(entry.slot);
+      return true;
+    }
+    if (runtime->registrationId != entry.registrationId) {
+      entry.registrationId = runtime->registrationId;
+      entry.tracker->onRuntimeReplaced();
+    }
+    return false;
+  }), _trackers.end());
+
+  for (const auto& runtime : runtimes) {
+    const bool tracked = std::any_of(_trackers.begin(), _trackers.end(), [&runtime](const Entry& entry) {
+      return entry.name == runtime.name;
+    });
+    if (tracked) {
+      continue;
+    }
+    uint32_t slot = RuntimeFpsTable::MAIN_SLOT;
+    if (runtime.name != RuntimeBridgeState::MAIN_RUNTIME_NAME) {
+      const std::optional<uint32_t> acquired = _runtimeTable->acquire(runtime.name);
+      if (!acquired.has_value()) {
+        continue; // Table is full, the runtime stays untracked
+      }
+      slot = *acquired;
+    }
+    auto tracker = createTracker(runtime.name, slot);
+    tracker->setWindowMs(_windowMs);
+    tracker->setTimelineEnabled(_timelineEnabled);
+    tracker->start();
+    _trackers.push_back(Entry{runtime.name, runtime.registrationId, slot, std::move(tracker)});
+  }
+}
+
+std::shared_ptr<JsFpsTracker> RuntimeTrackers::createTracker(const std::string& name, uint32_t slot) {
+  RuntimeExecutor executor = RuntimeBridgeState::get().getBoundExecutor(name);
+  auto table = _runtimeTable;
+  if (slot != RuntimeFpsTable::MAIN_SLOT) {
+    auto writer = [table, slot](int32_t fps, int32_t droppedFrames, double maxLatencyMs) {
+      table->write(slot, fps, droppedFrames, maxLatencyMs);
+    };
+    return std::make_shared<JsFpsTracker>(writer, nullptr, nullptr, nullptr, executor, _mode, false, _scheduler);
+  }
+
+  // Owns what it writes to, reports can outlive whoever handed the buffers to JS
+  auto writer = [fpsBuffer = _fpsBuffer, droppedFramesBuffer = _droppedFramesBuffer, table](int32_t fps, int32_t droppedFrames, double maxLatencyMs) {
+    *reinterpret_cast<int32_t*>(fpsBuffer->data()) = fps;
+    *reinterpret_cast<int32_t*>(droppedFramesBuffer->data()) = droppedFrames;
+    MetricsBlock::get().publish({
+      {MetricSlot::JsFps, static_cast<double>(fps)},
+      {MetricSlot::JsDroppedFrames, static_cast<double>(droppedFrames)},
+    });
+    table->write(RuntimeFpsTable::MAIN_SLOT, fps, droppedFrames, maxLatencyMs);
+  };
+  return std::make_shared<JsFpsTracker>(writer, _timeline, _lagEvents, _longTasks, executor, _mode, true, _scheduler);
+}
+
+const std::shared_ptr<ArrayBuffer>& RuntimeTrackers::getFpsBuffer() const {
+  return _fpsBuffer;
+}
+
+const std::shared_ptr<ArrayBuffer>& RuntimeTrackers::getDroppedFramesBuffer() const {
+  return _droppedFramesBuffer;
+}
+
+const std::shared_ptr<JsFrameTimeline>& RuntimeTrackers::getTimeline() const {
+  return _timeline;
+}
+
+const std::shared_ptr<JsLagEvents>& RuntimeTrackers::getLagEvents() const {
+  return _lagEvents;
+}
+
+const std::shared_ptr<LongTaskRecorder>& RuntimeTrackers::getLongTasks() const {
+  return _longTasks;
+}
+
+const std::shared_ptr<RuntimeFpsTable>& RuntimeTrackers::getRuntimeTable() const {
+  return _runtimeTable;
+}
+
+} // namespace margelo::nitro::performancetoolkit
@@ -0,0 +1,110 @@
+#pragma once
+
+#include "JsFpsTrackingMode.hpp"
+#include "TrackerScheduler.hpp"
+
+#include <NitroModules/ArrayBuffer.hpp>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace margelo::nitro::performancetoolkit {
+
+using namespace margelo::nitro;
+
+class JsFpsTracker;
+class JsFrameTimeline;
+class JsLagEvents;
+class LongTaskRecorder;
+class RuntimeFpsTable;
+
+// Process-wide owner of the JS FPS trackers: one for the main runtime, writing the main FPS buffers,
+// timeline, lag events and long tasks, and one for every other runtime registered in
+// RuntimeBridgeState, each reporting into its own RuntimeFpsTable slot.
+//
+// Trackers are keyed by runtime name and post through the registry's bound executors, so they
+// outlive the runtimes and Nitro objects that started them. A name registered again (reload, dev
+// hot reload) keeps its tracker, slot and buffers, the tracker only drops the probe that was pending
+// in the old runtime. Registry changes are picked up by a low frequency check of the registry
+// version, so registering a runtime never calls back into trackers. Nothing here waits for a JS
+// thread: stopping a tracker cancels its scheduler tasks, probes still queued in a runtime keep their
+// tracker alive until they run or the runtime drops them.
+class RuntimeTrackers {
+public:
+  static constexpr uint32_t RUNTIME_SYNC_INTERVAL_MS = 1000;
+
+  static RuntimeTrackers& get();
+
+  // Tests run their own instance, e.g. on a simulated scheduler
+  explicit RuntimeTrackers(TrackerScheduler& scheduler);
+  ~RuntimeTrackers();
+
+  RuntimeTrackers(const RuntimeTrackers&) = delete;
+  RuntimeTrackers& operator=(const RuntimeTrackers&) = delete;
+
+  // Starts the periodic registry check and picks up the runtimes registered so far. While paused
+  // this only records that the trackers should run once resumed
+  void start();
+  void stop();
+
+  // Stops every tracker (and the registry check) without forgetting that they were started,
+  // resuming creates them again for the runtimes registered by then. Buffers keep their values
+  void setPaused(bool paused);
+  bool isPaused() const;
+  // FPS window of every tracker, changed ones end their current window right away
+  void setWindowMs(uint32_t windowMs);
+  uint32_t getWindowMs() const;
+  // Whether the main tracker writes per-tick records to the frame timeline
+  void setTimelineEnabled(bool enabled);
+  bool isTimelineEnabled() const;
+
+  void setMode(JsFpsTrackingMode mode);
+  JsFpsTrackingMode getMode() const;
+
+  // Picks up registry changes right away instead of at the next periodic check
+  void sync();
+
+  // Main runtime outputs, they stay the same across reloads
+  const std::shared_ptr<ArrayBuffer>& getFpsBuffer() const;
+  const std::shared_ptr<ArrayBuffer>& getDroppedFramesBuffer() const;
+  const std::shared_ptr<JsFrameTimeline>& getTimeline() const;
+  const std::shared_ptr<JsLagEvents>& getLagEvents() const;
+  const std::shared_ptr<LongTaskRecorder>& getLongTasks() const;
+  const std::shared_ptr<RuntimeFpsTable>& getRuntimeTable() const;
+
+private:
+  struct Entry {
+    std::string name;
+    uint64_t registrationId;
+    uint32_t slot;
+    std::shared_ptr<JsFpsTracker> tracker;
+  };
+
+  // Called with _mutex held
+  std::shared_ptr<JsFpsTracker> createTracker(const std::string& name, uint32_t slot);
+  void startLocked();
+  void stopLocked();
+
+  TrackerScheduler& _scheduler;
+  std::shared_ptr<ArrayBuffer> _fpsBuffer;
+  std::shared_ptr<ArrayBuffer> _droppedFramesBuffer;
+  std::shared_ptr<JsFrameTimeline> _timeline;
+  std::shared_ptr<JsLagEvents> _lagEvents;
+  std::shared_ptr<LongTaskRecorder> _longTasks;
+  std::shared_ptr<RuntimeFpsTable> _runtimeTable;
+
+  mutable std::mutex _mutex;
+  std::atomic<JsFpsTrackingMode> _mode{JsFpsTrackingMode::CONTINUOUS};
+  std::atomic<uint32_t> _windowMs;
+  std::atomic<bool> _timelineEnabled{true};
+  bool _started = false;
+  bool _paused = false;
+  std::vector<Entry> _trackers;
+  uint64_t _syncedVersion = 0;
+  TrackerScheduler::TaskId _syncTask = 0;
+};
+
+} // namespace margelo::nitro::performancetoolkit
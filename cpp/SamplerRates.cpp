@@ -0,0 +1,131 @@
+#include "SamplerRates.hpp"
+#include "CpuSampler.hpp"
+#include "JsHeapSampler.hpp"
+#include "MemorySampler.hpp"
+#include "ToolkitOverhead.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+namespace margelo::nitro::performancetoolkit {
+
+SamplerRates& SamplerRates::get() {
+  static SamplerRates instance;
+  return instance;
+}
+
+SamplerRates::SamplerRates() {
+  for (size_t i = 0; i < _intervalsMs.size(); i++) {
+    _intervalsMs[i] = defaultIntervalMs(static_cast<SamplerKind>(i));
+    _paused[i] = false;
+  }
+}
+
+SamplerRates::RegistrationGuard::~RegistrationGuard() {
+  std::lock_guard<std::mutex> lock(registry->mutex);
+  auto& registrations = registry->registrations;
+  registrations.erase(std::remove_if(registrations.begin(), registrations.end(), [this](const Registration& registration) {
+    return registration.id == id;
+  }), registrations.end());
+}
+
+uint32_t SamplerRates::defaultIntervalMs(SamplerKind sampler) {
+  switch (sampler) {
+    case SamplerKind::Cpu:
+      return CpuSampler::SAMPLE_INTERVAL_MS;
+    case SamplerKind::Memory:
+      return MemorySampler::SAMPLE_INTERVAL_MS;
+    case SamplerKind::JsHeap:
+      return JsHeapSampler::SAMPLE_INTERVAL_MS;
+    case SamplerKind::ToolkitOverhead:
+      return ToolkitOverhead::SAMPLE_INTERVAL_MS;
+    case SamplerKind::Count:
+      break;
+  }
+  return MIN_INTERVAL_MS;
+}
+
+void SamplerRates::setIntervalMs(SamplerKind sampler, uint32_t intervalMs) {
+  const uint32_t gridTicks = (intervalMs + GRID_MS / 2) / GRID_MS;
+  const uint32_t rounded = std::clamp(gridTicks * GRID_MS, MIN_INTERVAL_MS, MAX_INTERVAL_MS);
+  if (_intervalsMs[static_cast<size_t>(sampler)].exchange(rounded) != rounded) {
+    rescheduleAll(sampler);
+  }
+}
+
+uint32_t SamplerRates::getIntervalMs(SamplerKind sampler) const {
+  return _intervalsMs[static_cast<size_t>(sampler)].load(std::memory_order_relaxed);
+}
+
+void SamplerRates::reset(SamplerKind sampler) {
+  const uint32_t interval = _intervalsMs[static_cast<size_t>(sampler)].exchange(defaultIntervalMs(sampler));
+  const bool paused = _paused[static_cast<size_t>(sampler)].exchange(false);
+  if (interval != defaultIntervalMs(sampler) || paused) {
+    rescheduleAll(sampler);
+  }
+}
+
+void SamplerRates::setPaused(SamplerKind sampler, bool paused) {
+  if (_paused[static_cast<size_t>(sampler)].exchange(paused) != paused) {
+    rescheduleAll(sampler);
+  }
+}
+
+bool SamplerRates::isPaused(SamplerKind sampler) const {
+  return _paused[static_cast<size_t>(sampler)].load(std::memory_order_relaxed);
+}
+
+void SamplerRates::rescheduleAll(SamplerKind sampler) {
+  std::vector<Registration> registrations;
+  {
+    std::lock_guard<std::mutex> lock(_registry->mutex);
+    std::copy_if(_registry->registrations.begin(), _registry->registrations.end(), std::back_inserter(registrations), [sampler](const Registration& registration) {
+      return registration.sampler == sampler;
+    });
+  }
+  // Outside the lock, a task destroyed by its scheduler takes the lock to unregister itself
+  for (const auto& registration : registrations) {
+    registration.scheduler->reschedule(registration.task, nextRunDelay(sampler, *registration.scheduler));
+  }
+}
+
+TrackerScheduler::Clock::duration SamplerRates::nextRunDelay(SamplerKind sampler, TrackerScheduler& scheduler) const {
+  if (isPaused(sampler)) {
+    return PAUSED_DELAY;
+  }
+  // Next run on a multiple of the period, so samplers whose periods divide each other share wakeups
+  const TrackerScheduler::Clock::duration period = std::chrono::milliseconds(getIntervalMs(sampler));
+  return period - scheduler.now().time_since_epoch() % period;
+}
+
+TrackerScheduler::TaskId SamplerRates::schedule(SamplerKind sampler, std::function<void()> sample,
+                                                std::optional<TrackerScheduler::Clock::duration> firstDelay, TrackerScheduler& scheduler) {
+  TrackerScheduler::Clock::duration delay = firstDelay.value_or(std::chrono::milliseconds(getIntervalMs(sampler)));
+  if (isPaused(sampler)) {
+    delay = PAUSED_DELAY;
+  }
+
+  uint64_t id;
+  {
+    std::lock_guard<std::mutex> lock(_registry->mutex);
+    id = _registry->nextId++;
+    _registry->registrations.push_back(Registration{id, sampler, &scheduler, 0});
+  }
+  auto guard = std::shared_ptr<RegistrationGuard>(new RegistrationGuard{_registry, id});
+  const TrackerScheduler::TaskId task = scheduler.schedule(delay, [this, sampler, sample = std::move(sample), &scheduler, guard]() -> std::optional<TrackerScheduler::Clock::duration> {
+    if (!isPaused(sampler)) {
+      sample();
+    }
+    return nextRunDelay(sampler, scheduler);
+  }, std::chrono::milliseconds(GRID_MS));
+
+  std::lock_guard<std::mutex> lock(_registry->mutex);
+  for (auto& registration : _registry->registrations) {
+    if (registration.id == id) {
+      registration.task = task;
+    }
+  }
+  return task;
+}
+
+} // namespace margelo::nitro::performancetoolkit
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "TrackerScheduler.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace margelo::nitro::performancetoolkit {
+
+enum class SamplerKind : uint32_t {
+  Cpu = 0,         // CpuSampler
+  Memory,          // MemorySampler
+  JsHeap,          // JsHeapSampler
+  ToolkitOverhead, // ToolkitOverhead
+  Count,
+};
+
+// Sampling periods of the periodic samplers, all driven by the one TrackerScheduler thread.
+//
+// Periods are multiples of GRID_MS and sampler runs land on multiples of their period on the
+// steady clock, so samplers whose periods divide each other (the defaults, 500 and 1000 ms) share
+// wakeups whenever they were started, and any two samplers at least meet on the grid. A changed
+// period or a paused sampler applies right away: its scheduled runs are moved to the new period, a
+// paused sampler keeps its task but neither samples nor wakes the thread until it is resumed.
+// Nothing here runs on (or posts to) the UI thread.
+class SamplerRates {
+public:
+  static constexpr uint32_t GRID_MS = 250;
+  static constexpr uint32_t MIN_INTERVAL_MS = GRID_MS;
+  static constexpr uint32_t MAX_INTERVAL_MS = 60'000;
+
+  static SamplerRates& get();
+
+  // Rounded to the nearest multiple of GRID_MS and clamped to [MIN_INTERVAL_MS, MAX_INTERVAL_MS]
+  void setIntervalMs(SamplerKind sampler, uint32_t intervalMs);
+  uint32_t getIntervalMs(SamplerKind sampler) const;
+  // Back to the sampler's built-in period, resumed
+  void reset(SamplerKind sampler);
+  void setPaused(SamplerKind sampler, bool paused);
+  bool isPaused(SamplerKind sampler) const;
+
+  // Runs `sample` on `scheduler` at the sampler's current period, first after `firstDelay` (one
+  // period by default), rounded up to the grid. Cancel the returned task to stop, `scheduler` must
+  // not be destroyed while the sampler's period changes
+  TrackerScheduler::TaskId schedule(SamplerKind sampler, std::function<void()> sample,
+                                    std::optional<TrackerScheduler::Clock::duration> firstDelay = std::nullopt,
+                                    TrackerScheduler& scheduler = TrackerScheduler::get());
+
+  static uint32_t defaultIntervalMs(SamplerKind sampler);
+
+private:
+  SamplerRates();
+
+  // How long a paused sampler's task sleeps, resuming reschedules it anyway
+  static constexpr auto PAUSED_DELAY = std::chrono::hours(1);
+
+  struct Registration {
+    uint64_t id;
+    SamplerKind sampler;
+    TrackerScheduler* scheduler;
+    TrackerScheduler::TaskId task;
+  };
+
+  // Shared with the tasks, a scheduler may destroy its tasks after this singleton is gone
+  struct Registry {
+    std::mutex mutex;
+    std::vector<Registration> registrations;
+    uint64_t nextId = 1;
+  };
+
+  // Removes a task's registration once the scheduler destroys the task (cancelled, or the
+  // scheduler itself is gone), so changing a period never touches a task that doesn't exist
+  struct RegistrationGuard {
+    std::shared_ptr<Registry> registry;
+    uint64_t id;
+    ~RegistrationGuard();
+  };
+
+  // Moves the next run of every task of `sampler` to its current period
+  void rescheduleAll(SamplerKind sampler);
+  TrackerScheduler::Clock::duration nextRunDelay(SamplerKind sampler, TrackerScheduler& scheduler) const;
+
+  std::array<std::atomic<uint32_t>, static_cast<size_t>(SamplerKind::Count)> _intervalsMs;
+  std::array<std::atomic<bool>, static_cast<size_t>(SamplerKind::Count)> _paused;
+  std::shared_ptr<Registry> _registry = std::make_shared<Registry>();
+};
+
+} // namespace margelo::nitro::performancetoolkit
@@ -0,0 +1,103 @@
+#include "SamplingProfiles.hpp"
+#include "JsFpsTracker.hpp"
+#include "MetricsBlock.hpp"
+#include "RuntimeTrackers.hpp"
+#include "SamplerRates.hpp"
+#include "UiFrameAnalyzer.hpp"
+
+#include <algorithm>
+
+namespace margelo::nitro::performancetoolkit {
+
+static constexpr uint32_t DEFAULT_COUNTER_UPDATE_INTERVAL_MS = 1000;
+
+// Returns the period the sampler runs at, 0 if paused
+static uint32_t applySampler(SamplerKind sampler, uint32_t intervalMs) {
+  auto& rates = SamplerRates::get();
+  if (intervalMs == 0) {
+    rates.setPaused(sampler, true);
+    return 0;
+  }
+  // Period first, resuming reschedules at the new one
+  rates.setIntervalMs(sampler, intervalMs);
+  rates.setPaused(sampler, false);
+  return rates.getIntervalMs(sampler);
+}
+
+SamplingProfiles& SamplingProfiles::get() {
+  static SamplingProfiles instance;
+  return instance;
+}
+
+// The built-in defaults are already in effect, nothing to apply
+SamplingProfiles::SamplingProfiles() : _settings(defaults(SamplingProfile::QA)) {
+  MetricsBlock::get().publish(MetricSlot::CounterUpdateIntervalMs, static_cast<double>(_settings.counterUpdateIntervalMs));
+}
+
+SamplingProfiles::Settings SamplingProfiles::defaults(SamplingProfile profile) {
+  switch (profile) {
+    case SamplingProfile::OFF:
+      return Settings{profile, 0, 0, 0, 0, 0, 0, false};
+    case SamplingProfile::PRODUCTION:
+      return Settings{profile, 2000, 2000, 2000, 5000, 5000, 2000, false};
+    case SamplingProfile::QA:
+      return Settings{
+        profile,
+        static_cast<uint32_t>(JsFpsTracker::FPS_WINDOW_MS),
+        UiFrameAnalyzer::WINDOW_MS,
+        SamplerRates::defaultIntervalMs(SamplerKind::Cpu),
+        SamplerRates::defaultIntervalMs(SamplerKind::Memory),
+        SamplerRates::defaultIntervalMs(SamplerKind::JsHeap),
+        DEFAULT_COUNTER_UPDATE_INTERVAL_MS,
+        true,
+      };
+    case SamplingProfile::PROFILING:
+      return Settings{
+        profile,
+        500,
+        MIN_WINDOW_MS,
+        SamplerRates::MIN_INTERVAL_MS,
+        SamplerRates::MIN_INTERVAL_MS,
+        SamplerRates::MIN_INTERVAL_MS,
+        MIN_WINDOW_MS,
+        true,
+      };
+  }
+  return defaults(SamplingProfile::QA);
+}
+
+uint32_t SamplingProfiles::clampWindow(uint32_t windowMs) {
+  return windowMs == 0 ? 0 : std::clamp(windowMs, MIN_WINDOW_MS, MAX_WINDOW_MS);
+}
+
+SamplingProfiles::Settings SamplingProfiles::apply(const Settings& settings) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  Settings applied = settings;
+
+  applied.jsFpsWindowMs = clampWindow(settings.jsFpsWindowMs);
+  auto& trackers = RuntimeTrackers::get();
+  if (applied.jsFpsWindowMs != 0) {
+    trackers.setWindowMs(applied.jsFpsWindowMs);
+  }
+  trackers.setTimelineEnabled(applied.frameTimeline);
+  trackers.setPaused(applied.jsFpsWindowMs == 0);
+
+  applied.uiFpsWindowMs = clampWindow(settings.uiFpsWindowMs);
+  UiFrameAnalyzer::get().setWindowMs(applied.uiFpsWindowMs);
+
+  applied.cpuIntervalMs = applySampler(SamplerKind::Cpu, settings.cpuIntervalMs);
+  applied.memoryIntervalMs = applySampler(SamplerKind::Memory, settings.memoryIntervalMs);
+  applied.jsHeapIntervalMs = applySampler(SamplerKind::JsHeap, settings.jsHeapIntervalMs);
+  applied.counterUpdateIntervalMs = clampWindow(settings.counterUpdateIntervalMs);
+  MetricsBlock::get().publish(MetricSlot::CounterUpdateIntervalMs, static_cast<double>(applied.counterUpdateIntervalMs));
+
+  _settings = applied;
+  return applied;
+}
+
+SamplingProfiles::Settings SamplingProfiles::getSettings() const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _settings;
+}
+
+} // namespace margelo::nitro::performancetoolkit
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "SamplingProfile.hpp"
+
+#include <cstdint>
+#include <mutex>
+
+namespace margelo::nitro::performancetoolkit {
+
+// How much the toolkit measures, switchable at runtime so an app can ship with a cheap profile and
+// escalate detail for a single session. Applying settings reaches every sampler, window and writer
+// right away, nothing is restarted and every shared buffer stays the one JS already holds:
+//
+//   - JS FPS window of every runtime tracker (RuntimeTrackers), 0 stops the trackers
+//   - UI FPS window (UiFrameAnalyzer), 0 drops the forwarded frames
+//   - CPU, memory and JS heap sampling periods (SamplerRates), 0 pauses the sampler
+//   - per-tick records of the JS frame timeline
+//   - refresh period of the UI thread counter hooks, published in the metrics block
+//     (MetricSlot::CounterUpdateIntervalMs) so the hooks read it without a Nitro call
+//
+// Built-in profiles:
+//   Off        nothing is measured
+//   Production 2 s windows and slow samplers, no per-tick records
+//   Qa         the built-in defaults, with the per-tick timeline (the initial profile)
+//   Profiling  every sampler at its fastest period, short windows
+class SamplingProfiles {
+public:
+  static constexpr uint32_t MIN_WINDOW_MS = 250;
+  static constexpr uint32_t MAX_WINDOW_MS = 10'000;
+
+  struct Settings {
+    SamplingProfile profile;
+    uint32_t jsFpsWindowMs;    // 0 = off
+    uint32_t uiFpsWindowMs;    // 0 = off
+    uint32_t cpuIntervalMs;    // 0 = off
+    uint32_t memoryIntervalMs; // 0 = off
+    uint32_t jsHeapIntervalMs; // 0 = off
+    uint32_t counterUpdateIntervalMs; // 0 = counters don't update
+    bool frameTimeline;
+  };
+
+  static SamplingProfiles& get();
+
+  static Settings defaults(SamplingProfile profile);
+
+  // Windows are clamped to [MIN_WINDOW_MS, MAX_WINDOW_MS], sampling periods rounded by SamplerRates.
+  // Returns what was applied
+  Settings apply(const Settings& settings);
+  Settings getSettings() const;
+
+private:
+  SamplingProfiles();
+
+  static uint32_t clampWindow(uint32_t windowMs);
+
+  mutable std::mutex _mutex;
+  Settings _settings;
+};
+
+} // namespace margelo::nitro::performancetoolkit
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace margelo::nitro::performancetoolkit {
+
+// Binary session file format written by SessionRecorder and read by SessionReader.
+// Kept free of JSI/Nitro includes so host tools can be built from the same sources.
+//
+// File layout (little-endian):
+//
+//   Header (64 bytes)
+//     0  char[8]  magic             - "RNPTSES\0"
+//     8  uint32   version
+//    12  uint32   headerSize
+//    16  int64    startTimeNs       - steady clock ns when the session started
+//    24  float64  startWallTimeMs   - unix time ms when the session started
+//    32  uint64   dataEnd           - file offset after the last complete record, updated after every drain
+//    40  uint64   lastIndexOffset   - file offset of the most recent index record
+//    48  uint64   droppedSamples    - samples lost because the recorder's queue was full
+//    56  float64  refreshRate       - display refresh rate when the session started
+//   Records, starting with an index record
+//     uint8 type (SessionRecordType), then
+//     Index:    int64 timeNs, uint64 previousIndexOffset (0 for the first), uint64 recordCount (fixed width)
+//     NameDef:  varint nameId, varint length, UTF-8 bytes
+//     UserMark: varint zigzag(time delta in us), varint nameId, varint thread
+//     UserSpan: varint zigzag(time delta in us), varint nameId, varint thread, varint duration in us
+//     Others:   varint zigzag(time delta in us), varint zigzag(quantized value delta)
+//
+// Time deltas are relative to the previous record, value deltas to the previous record of the
+// same type (quantized with `sessionValueScale`). Both start from zero after every index record,
+// which is written at least once per second, so decoding can start at any index and a file cut
+// off by a crash stays readable up to `dataEnd`. A NameDef is written once, before the first
+// record using its id, so resolving user timing names requires decoding from the start.
+enum class SessionRecordType : uint8_t {
+  Index = 0,   // Resync point, see above
+  JsTick,      // value: latency of a JS tick in ms, time is when it ran
+  UiFrame,     // value: UI frame duration in ms, time is the vsync that ended it
+  CpuUsage,    // value: process CPU usage in percent
+  MemoryUsage, // value: process memory usage in MB
+  LongTask,    // value: duration in ms of a JS tick that waited for synchronous JS work, time is when it was posted
+  GcPause,     // value: same as LongTask, but the JS engine collected garbage while the tick waited
+  NameDef,     // Name of a user mark / span id, no time (version 2)
+  UserMark,    // User mark, time is when it was set (version 2)
+  UserSpan,    // User span, time is when it began (version 2)
+  Count,
+};
+
+struct SessionFileHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t headerSize;
+  int64_t startTimeNs;
+  double startWallTimeMs;
+  uint64_t dataEnd;
+  uint64_t lastIndexOffset;
+  uint64_t droppedSamples;
+  double refreshRate;
+};
+
+static_assert(sizeof(SessionFileHeader) == 64, "Header layout is part of the file format");
+
+static constexpr char SESSION_FILE_MAGIC[8] = {'R', 'N', 'P', 'T', 'S', 'E', 'S', '\0'};
+static constexpr uint32_t SESSION_FILE_VERSION = 2;          // 2 added user timing records
+static constexpr uint32_t SESSION_FILE_MIN_READ_VERSION = 1; // Version 1 files are a subset of version 2
+static constexpr size_t SESSION_INDEX_RECORD_SIZE = 1 + 3 * sizeof(uint64_t);
+static constexpr size_t SESSION_MAX_SAMPLE_RECORD_SIZE = 1 + 2 * 10; // Type + two varints of at most 10 bytes
+static constexpr size_t SESSION_MAX_USER_RECORD_SIZE = 1 + 10 + 5 + 5 + 10; // Type + time, name, thread, duration
+static constexpr size_t SESSION_MAX_NAME_LENGTH = 256;
+static constexpr size_t SESSION_MAX_NAME_RECORD_SIZE = 1 + 5 + 5 + SESSION_MAX_NAME_LENGTH;
+
+// Multiplier applied to a value before it is rounded to an integer
+inline double sessionValueScale(SessionRecordType type) {
+  switch (type) {
+    case SessionRecordType::CpuUsage:
+      return 10.0; // 0.1%
+    case SessionRecordType::MemoryUsage:
+      return 1024.0; // MB -> KB
+    default:
+      return 1000.0; // ms -> us
+  }
+}
+
+inline uint64_t zigzagEncode(int64_t value) {
+  return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+inline int64_t zigzagDecode(uint64_t value) {
+  return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+} // namespace margelo::nitro::performancetoolkit
@@ -0,0 +1,136 @@
+#include "SessionReader.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace margelo::nitro::performancetoolkit {
+
+SessionReader::SessionReader(const std::string& path) : _buffer(READ_BUFFER_SIZE) {
+  _file = std::fopen(path.c_str(), "rb");
+  if (_file == nullptr) {
+    throw std::runtime_error("Cannot open session file " + path);
+  }
+  if (std::fread(&_header, sizeof(_header), 1, _file) != 1 ||
+      std::memcmp(_header.magic, SESSION_FILE_MAGIC, sizeof(SESSION_FILE_MAGIC)) != 0) {
+    std::fclose(_file);
+    throw std::runtime_error(path + " is not a session file");
+  }
+  if (_header.version < SESSION_FILE_MIN_READ_VERSION || _header.version > SESSION_FILE_VERSION) {
+    std::fclose(_file);
+    throw std::runtime_error(path + " has unsupported session file version " + std::to_string(_header.version));
+  }
+  // Skip header fields added by newer minor revisions
+  std::fseek(_file, static_cast<long>(_header.headerSize), SEEK_SET);
+  _remaining = _header.dataEnd > _header.headerSize ? _header.dataEnd - _header.headerSize : 0;
+}
+
+SessionReader::~SessionReader() {
+  if (_file != nullptr) {
+    std::fclose(_file);
+  }
+}
+
+bool SessionReader::fill(size_t bytes) {
+  if (_length - _position >= bytes) {
+    return true;
+  }
+  // Keep the unread tail and append the next chunk after it
+  std::memmove(_buffer.data(), _buffer.data() + _position, _length - _position);
+  _length -= _position;
+  _position = 0;
+  const size_t wanted = static_cast<size_t>(std::min<uint64_t>(_buffer.size() - _length, _remaining));
+  const size_t read = std::fread(_buffer.data() + _length, 1, wanted, _file);
+  _length += read;
+  _remaining -= read;
+  return _length >= bytes;
+}
+
+uint64_t SessionReader::readVarint() {
+  uint64_t value = 0;
+  for (uint32_t shift = 0; shift < 64; shift += 7) {
+    const uint8_t byte = _buffer[_position++];
+    value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0) {
+      return value;
+    }
+  }
+  throw std::runtime_error("Corrupt varint in session file");
+}
+
+bool SessionReader::next(SessionSample& out) {
+  while (fill(1)) {
+    const auto type = static_cast<SessionRecordType>(_buffer[_position]);
+    if (type == SessionRecordType::Index) {
+      if (!fill(SESSION_INDEX_RECORD_SIZE)) {
+        return false;
+      }
+      int64_t timeNs = 0;
+      std::memcpy(&timeNs, _buffer.data() + _position + 1, sizeof(timeNs));
+      _position += SESSION_INDEX_RECORD_SIZE;
+      _lastTimeUs = timeNs / 1000;
+      _lastValues.fill(0);
+      continue;
+    }
+    if (type >= SessionRecordType::Count) {
+      throw std::runtime_error("Unknown record type " + std::to_string(static_cast<uint32_t>(type)) + " in session file");
+    }
+    if (type == SessionRecordType::NameDef) {
+      readName();
+      continue;
+    }
+    if (type == SessionRecordType::UserMark || type == SessionRecordType::UserSpan) {
+      fill(SESSION_MAX_USER_RECORD_SIZE);
+      _position++;
+      _lastTimeUs += zigzagDecode(readVarint());
+      out.type = type;
+      out.timeNs = _lastTimeUs * 1000;
+      out.nameId = static_cast<uint32_t>(readVarint());
+      out.thread = static_cast<uint32_t>(readVarint());
+      out.value = type == SessionRecordType::UserSpan ? static_cast<double>(readVarint()) / 1000.0 : 0.0;
+      if (_position > _length) {
+        throw std::runtime_error("Truncated record in session file");
+      }
+      return true;
+    }
+    // Records are at most SESSION_MAX_SAMPLE_RECORD_SIZE, the last one may be shorter
+    fill(SESSION_MAX_SAMPLE_RECORD_SIZE);
+    _position++;
+    _lastTimeUs += zigzagDecode(readVarint());
+    int64_t& value = _lastValues[static_cast<size_t>(type)];
+    value += zigzagDecode(readVarint());
+    if (_position > _length) {
+      throw std::runtime_error("Truncated record in session file");
+    }
+
+    out.type = type;
+    out.timeNs = _lastTimeUs * 1000;
+    out.value = static_cast<double>(value) / sessionValueScale(type);
+    out.nameId = 0;
+    out.thread = 0;
+    return true;
+  }
+  return false;
+}
+
+void SessionReader::readName() {
+  fill(SESSION_MAX_NAME_RECORD_SIZE);
+  _position++;
+  const auto id = static_cast<uint32_t>(readVarint());
+  const auto length = static_cast<size_t>(readVarint());
+  if (id == 0 || length > SESSION_MAX_NAME_LENGTH || _position + length > _length) {
+    throw std::runtime_error("Corrupt name record in session file");
+  }
+  if (_names.size() < id) {
+    _names.resize(id);
+  }
+  _names[id - 1].assign(reinterpret_cast<const char*>(_buffer.data() + _position), length);
+  _position += length;
+}
+
+const std::string& SessionReader::nameOf(uint32_t nameId) const {
+  static const std::string unknown;
+  return nameId > 0 && nameId <= _names.size() ? _names[nameId - 1] : unknown;
+}
+
+} // namespace margelo::nitro::performancetoolkit
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "SessionFormat.hpp"
+
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace margelo::nitro::performancetoolkit {
+
+struct SessionSample {
+  SessionRecordType type;
+  int64_t timeNs; // Steady clock, same timebase as SessionFileHeader::startTimeNs
+  double value;       // UserSpan: duration in ms, UserMark: 0
+  uint32_t nameId;    // UserMark / UserSpan only, see SessionReader::nameOf
+  uint32_t thread;    // UserMark / UserSpan only, index of the recording thread
+};
+
+// Streaming decoder for session files (see SessionFormat.hpp), reads the file through a fixed
+// size buffer so sessions of any length can be decoded in constant memory.
+// Free of JSI/Nitro includes, shared by the native exporter and the host tools.
+class SessionReader {
+public:
+  static constexpr size_t READ_BUFFER_SIZE = 64 * 1024;
+
+  // Throws std::runtime_error if the file can't be opened or isn't a session file
+  explicit SessionReader(const std::string& path);
+  ~SessionReader();
+
+  SessionReader(const SessionReader&) = delete;
+  SessionReader& operator=(const SessionReader&) = delete;
+
+  const SessionFileHeader& header() const {
+    return _header;
+  }
+
+  // Decodes the next sample, index records are consumed transparently.
+  // Returns false at the end of the recorded data, throws if a record is corrupt
+  bool next(SessionSample& out);
+
+  // Name of a user mark / span id, empty if its NameDef hasn't been read yet
+  const std::string& nameOf(uint32_t nameId) const;
+
+private:
+  bool fill(size_t bytes);
+  uint64_t readVarint();
+  void readName();
+
+  std::FILE* _file = nullptr;
+  SessionFileHeader _header{};
+  uint64_t _remaining = 0; // Bytes of record data not yet read from the file
+  std::vector<uint8_t> _buffer;
+  size_t _position = 0;
+  size_t _length = 0;
+
+  int64_t _lastTimeUs = 0;
+  std::array<int64_t, static_cast<size_t>(SessionRecordType::Count)> _lastValues{};
+  std::vector<std::string> _names; // Index is the name id - 1
+};
+
+} // namespace margelo::nitro::performancetoolkit
@@ -0,0 +1,390 @@
+#include "SessionRecorder.hpp"
+#include "RuntimeBridge.hpp"
+#include "ToolkitOverhead.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace margelo::nitro::performancetoolkit {
+
+static int64_t nowNs() {
+  const auto now = std::chrono::steady_clock::now().time_since_epoch();
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+}
+
+static double wallTimeMs() {
+  const auto now = std::chrono::system_clock::now().time_since_epoch();
+  return std::chrono::duration<double, std::milli>(now).count();
+}
+
+// Allocates the blocks of [offset, offset + length) and extends the file over them, returns 0 or
+// an errno value. Mapping a sparse range instead would turn a full disk into a SIGBUS on write
+static int allocateFileRange(int fd, size_t offset, size_t length) {
+#if defined(__APPLE__)
+  fstore_t store{F_ALLOCATECONTIG | F_ALLOCATEALL, F_PEOFPOSMODE, 0, static_cast<off_t>(length), 0};
+  if (fcntl(fd, F_PREALLOCATE, &store) == -1) {
+    store.fst_flags = F_ALLOCATEALL;
+    if (fcntl(fd, F_PREALLOCATE, &store) == -1) {
+      return errno;
+    }
+  }
+  return ftruncate(fd, static_cast<off_t>(offset + length)) == 0 ? 0 : errno;
+#else
+  const int error = posix_fallocate(fd, static_cast<off_t>(offset), static_cast<off_t>(length));
+  if (error != EOPNOTSUPP && error != EINVAL) {
+    return error;
+  }
+  // The filesystem can't preallocate, writing zeros allocates the blocks just as well
+  static constexpr size_t ZEROS_SIZE = 64 * 1024;
+  static const uint8_t zeros[ZEROS_SIZE] = {};
+  for (size_t written = 0; written < length;) {
+    const ssize_t result = pwrite(fd, zeros, std::min(ZEROS_SIZE, length - written), static_cast<off_t>(offset + written));
+    if (result < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return errno;
+    }
+    written += static_cast<size_t>(result);
+  }
+  return 0;
+#endif
+}
+
+static size_t writeVarint(uint8_t* out, uint64_t value) {
+  size_t length = 0;
+  while (value >= 0x80) {
+    out[length++] = static_cast<uint8_t>(value | 0x80);
+    value >>= 7;
+  }
+  out[length++] = static_cast<uint8_t>(value);
+  return length;
+}
+
+SessionRecorder& SessionRecorder::get() {
+  static SessionRecorder instance;
+  return instance;
+}
+
+SessionRecorder::~SessionRecorder() {
+  stop();
+}
+
+void SessionRecorder::setDirectory(std::string directory) {
+  std::lock_guard<std::mutex> lock(_lifecycleMutex);
+  _directory = std::move(directory);
+}
+
+std::string SessionRecorder::start(const std::optional<std::string>& path) {
+  std::lock_guard<std::mutex> lifecycleLock(_lifecycleMutex);
+  if (_writer.joinable()) {
+    throw std::runtime_error("A session recording is already running");
+  }
+  if (path.has_value()) {
+    _path = *path;
+  } else if (!_directory.empty()) {
+    _path = _directory + "/performance-" + std::to_string(static_cast<int64_t>(wallTimeMs())) + FILE_EXTENSION;
+  } else {
+    throw std::runtime_error("No directory to record sessions into, pass a path");
+  }
+
+  _fd = open(_path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+  if (_fd < 0) {
+    throw std::runtime_error("Cannot create session file " + _path + ": " + std::strerror(errno));
+  }
+  _writeOffset = sizeof(SessionFileHeader);
+  _failure.clear();
+  if (!reserve(SESSION_INDEX_RECORD_SIZE)) {
+    unlink(_path.c_str());
+    throw std::runtime_error(_failure + " " + _path);
+  }
+
+  const int64_t startTimeNs = nowNs();
+  SessionFileHeader header{};
+  std::memcpy(header.magic, SESSION_FILE_MAGIC, sizeof(SESSION_FILE_MAGIC));
+  header.version = SESSION_FILE_VERSION;
+  header.headerSize = sizeof(SessionFileHeader);
+  header.startTimeNs = startTimeNs;
+  header.startWallTimeMs = wallTimeMs();
+  header.refreshRate = RuntimeBridgeState::get().getDeviceRefreshRate();
+  std::memcpy(_mapping, &header, sizeof(header));
+  _recordCount = 0;
+  _lastIndexOffset = 0;
+  _writtenNames = 0;
+  writeIndex(startTimeNs);
+
+  if (_queue == nullptr) {
+    _queue = std::make_unique<Cell[]>(QUEUE_CAPACITY);
+    for (uint32_t i = 0; i < QUEUE_CAPACITY; i++) {
+      _queue[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+  // Leftovers pushed while the previous session was stopping belong to no session
+  Sample leftover{};
+  while (pop(leftover)) {
+  }
+  _droppedSamples.store(0, std::memory_order_relaxed);
+  UserTimings::get().discard();
+  _userTimingsDroppedAtStart = UserTimings::get().getDroppedCount();
+
+  _stopping = false;
+  _writer = std::thread([this]() { runWriter(); });
+  _recording.store(true, std::memory_order_release);
+  return _path;
+}
+
+std::optional<std::string> SessionRecorder::stop() {
+  std::lock_guard<std::mutex> lifecycleLock(_lifecycleMutex);
+  if (!_writer.joinable()) {
+    return std::nullopt;
+  }
+  _recording.store(false, std::memory_order_release);
+  {
+    std::lock_guard<std::mutex> lock(_writerMutex);
+    _stopping = true;
+  }
+  _writerWakeup.notify_one();
+  _writer.join();
+  if (!_failure.empty()) {
+    throw std::runtime_error("Session recording stopped early (" + _failure + "), " + _path + " only holds the samples written before");
+  }
+  return _path;
+}
+
+void SessionRecorder::push(SessionRecordType type, int64_t timeNs, double value) {
+  // Bounded MPMC queue (Vyukov), each cell's sequence tells whose turn it is
+  uint64_t position = _enqueuePosition.load(std::memory_order_relaxed);
+  for (;;) {
+    Cell& cell = _queue[position & (QUEUE_CAPACITY - 1)];
+    const uint64_t sequence = cell.sequence.load(std::memory_order_acquire);
+    const auto difference = static_cast<int64_t>(sequence) - static_cast<int64_t>(position);
+    if (difference == 0) {
+      if (_enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+        cell.sample = Sample{timeNs, value, type};
+        cell.sequence.store(position + 1, std::memory_order_release);
+        return;
+      }
+    } else if (difference < 0) {
+      _droppedSamples.fetch_add(1, std::memory_order_relaxed); // Full, the writer is behind
+      return;
+    } else {
+      position = _enqueuePosition.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+bool SessionRecorder::pop(Sample& out) {
+  uint64_t position = _dequeuePosition.load(std::memory_order_relaxed);
+  for (;;) {
+    Cell& cell = _queue[position & (QUEUE_CAPACITY - 1)];
+    const uint64_t sequence = cell.sequence.load(std::memory_order_acquire);
+    const auto difference = static_cast<int64_t>(sequence) - static_cast<int64_t>(position + 1);
+    if (difference == 0) {
+      if (_dequeuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+        out = cell.sample;
+        cell.sequence.store(position + QUEUE_CAPACITY, std::memory_order_release);
+        return true;
+      }
+    } else if (difference < 0) {
+      return false; // Empty
+    } else {
+      position = _dequeuePosition.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+void SessionRecorder::runWriter() {
+  int64_t lastCpuNs = ToolkitOverhead::threadCpuNs();
+  const auto accountCpu = [&lastCpuNs]() {
+    const int64_t cpuNs = ToolkitOverhead::threadCpuNs();
+    ToolkitOverhead::get().addSessionWriterCpu(cpuNs - lastCpuNs);
+    lastCpuNs = cpuNs;
+  };
+
+  std::unique_lock<std::mutex> lock(_writerMutex);
+  while (!_stopping) {
+    _writerWakeup.wait_for(lock, std::chrono::milliseconds(DRAIN_INTERVAL_MS), [this]() { return _stopping; });
+    lock.unlock();
+    ToolkitOverhead::get().addWakeup();
+    drain();
+    accountCpu();
+    lock.lock();
+  }
+  lock.unlock();
+  // A session stopped before this thread got to run never entered the loop
+  drain();
+  closeFile();
+  accountCpu();
+}
+
+void SessionRecorder::drain() {
+  if (_mapping == nullptr) {
+    return; // The file couldn't grow, the session only keeps what was written so far
+  }
+  Sample sample{};
+  while (pop(sample)) {
+    if (sample.timeNs - _lastIndexTimeNs >= static_cast<int64_t>(INDEX_INTERVAL_MS) * 1'000'000) {
+      writeIndex(sample.timeNs);
+    }
+    writeSample(sample);
+    if (_mapping == nullptr) {
+      return;
+    }
+  }
+  UserTimings::get().drain([this](const UserTimingEvent& event) {
+    if (_mapping == nullptr) {
+      return; // Keep draining so the rings don't fill up, the events are lost either way
+    }
+    if (event.nameId > _writtenNames) {
+      UserTimings::get().forEachNameAfter(_writtenNames, [this](uint32_t id, const std::string& name) { writeName(id, name); });
+    }
+    if (event.timeNs - _lastIndexTimeNs >= static_cast<int64_t>(INDEX_INTERVAL_MS) * 1'000'000) {
+      writeIndex(event.timeNs);
+    }
+    writeUserTiming(event);
+  });
+  if (_mapping == nullptr) {
+    return;
+  }
+
+  // Header fields are only read after the session, or by a reader of a crashed session
+  auto* header = reinterpret_cast<SessionFileHeader*>(_mapping);
+  header->dataEnd = _writeOffset;
+  header->lastIndexOffset = _lastIndexOffset;
+  header->droppedSamples = droppedSamples();
+}
+
+void SessionRecorder::writeIndex(int64_t timeNs) {
+  if (!reserve(SESSION_INDEX_RECORD_SIZE)) {
+    return;
+  }
+  const uint64_t offset = _writeOffset;
+  uint8_t* out = _mapping + _writeOffset;
+  out[0] = static_cast<uint8_t>(SessionRecordType::Index);
+  const uint64_t fields[3] = {static_cast<uint64_t>(timeNs), _lastIndexOffset, _recordCount};
+  std::memcpy(out + 1, fields, sizeof(fields));
+  _writeOffset += SESSION_INDEX_RECORD_SIZE;
+
+  _lastIndexOffset = offset;
+  _lastIndexTimeNs = timeNs;
+  _lastTimeUs = timeNs / 1000;
+  _lastValues.fill(0);
+}
+
+void SessionRecorder::writeSample(const Sample& sample) {
+  if (!reserve(SESSION_MAX_SAMPLE_RECORD_SIZE)) {
+    return;
+  }
+  const int64_t timeUs = sample.timeNs / 1000;
+  const auto typeIndex = static_cast<size_t>(sample.type);
+  const auto value = static_cast<int64_t>(std::llround(sample.value * sessionValueScale(sample.type)));
+
+  uint8_t* out = _mapping + _writeOffset;
+  size_t length = 0;
+  out[length++] = static_cast<uint8_t>(sample.type);
+  length += writeVarint(out + length, zigzagEncode(timeUs - _lastTimeUs));
+  length += writeVarint(out + length, zigzagEncode(value - _lastValues[typeIndex]));
+  _writeOffset += length;
+  _recordCount++;
+
+  _lastTimeUs = timeUs;
+  _lastValues[typeIndex] = value;
+}
+
+void SessionRecorder::writeUserTiming(const UserTimingEvent& event) {
+  if (!reserve(SESSION_MAX_USER_RECORD_SIZE)) {
+    return;
+  }
+  const bool isSpan = event.kind == UserTimingKind::Span;
+  const int64_t timeUs = event.timeNs / 1000;
+
+  uint8_t* out = _mapping + _writeOffset;
+  size_t length = 0;
+  out[length++] = static_cast<uint8_t>(isSpan ? SessionRecordType::UserSpan : SessionRecordType::UserMark);
+  length += writeVarint(out + length, zigzagEncode(timeUs - _lastTimeUs));
+  length += writeVarint(out + length, event.nameId);
+  length += writeVarint(out + length, event.thread);
+  if (isSpan) {
+    length += writeVarint(out + length, static_cast<uint64_t>(std::max<int64_t>(event.durationNs / 1000, 0)));
+  }
+  _writeOffset += length;
+  _recordCount++;
+  _lastTimeUs = timeUs;
+}
+
+void SessionRecorder::writeName(uint32_t id, const std::string& name) {
+  const size_t nameLength = std::min(name.size(), SESSION_MAX_NAME_LENGTH);
+  if (!reserve(SESSION_MAX_NAME_RECORD_SIZE)) {
+    return;
+  }
+  uint8_t* out = _mapping + _writeOffset;
+  size_t length = 0;
+  out[length++] = static_cast<uint8_t>(SessionRecordType::NameDef);
+  length += writeVarint(out + length, id);
+  length += writeVarint(out + length, nameLength);
+  std::memcpy(out + length, name.data(), nameLength);
+  _writeOffset += length + nameLength;
+  _writtenNames = id;
+}
+
+uint64_t SessionRecorder::droppedSamples() const {
+  return _droppedSamples.load(std::memory_order_relaxed) + UserTimings::get().getDroppedCount() - _userTimingsDroppedAtStart;
+}
+
+bool SessionRecorder::reserve(size_t bytes) {
+  if (_writeOffset + bytes <= _mappedSize) {
+    return true;
+  }
+  const size_t newSize = _mappedSize + GROWTH_BYTES;
+  const int error = allocateFileRange(_fd, _mappedSize, GROWTH_BYTES);
+  if (error != 0) {
+    fail("cannot grow the session file", error);
+    return false;
+  }
+  void* mapping = mmap(nullptr, newSize, PROT_READ | PROT_WRITE, MAP_SHARED, _fd, 0);
+  if (mapping == MAP_FAILED) {
+    fail("cannot map the session file", errno);
+    return false;
+  }
+  if (_mapping != nullptr) {
+    munmap(_mapping, _mappedSize);
+  }
+  _mapping = static_cast<uint8_t*>(mapping);
+  _mappedSize = newSize;
+  return true;
+}
+
+void SessionRecorder::fail(const char* what, int error) {
+  // Producers stop right away, stop() reports the failure once the writer is done
+  _recording.store(false, std::memory_order_release);
+  _failure = std::string(what) + ": " + std::strerror(error);
+  closeFile();
+}
+
+void SessionRecorder::closeFile() {
+  if (_mapping != nullptr) {
+    auto* header = reinterpret_cast<SessionFileHeader*>(_mapping);
+    header->dataEnd = _writeOffset;
+    header->lastIndexOffset = _lastIndexOffset;
+    header->droppedSamples = droppedSamples();
+    munmap(_mapping, _mappedSize);
+    _mapping = nullptr;
+  }
+  if (_fd >= 0) {
+    // Drop the unused tail of the last growth step
+    ftruncate(_fd, static_cast<off_t>(_writeOffset));
+    close(_fd);
+    _fd = -1;
+  }
+  _mappedSize = 0;
+}
+
+} // namespace margelo::nitro::performancetoolkit
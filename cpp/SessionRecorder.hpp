@@ -0,0 +1,123 @@
+#pragma once
+
+#include "SessionFormat.hpp"
+#include "UserTimings.hpp"
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+
+namespace margelo::nitro::performancetoolkit {
+
+// Records every sample into an append-only binary file while a session is running, so perf
+// regressions from QA runs can be analyzed afterwards without a debugger attached.
+// See SessionFormat.hpp for the file format.
+//
+// Producers (JS thread, UI thread, samplers) push fixed size samples into a lock-free bounded
+// queue and never block, a full queue drops the sample and counts it. A writer thread owned by
+// the session drains the queue every DRAIN_INTERVAL_MS and appends the encoded samples to a
+// memory-mapped file that grows in GROWTH_BYTES steps, then truncates it to its length on stop.
+// Every step is allocated on disk before it is mapped. If that fails (storage full) the session
+// ends right there with what it holds so far, and stop() throws with the reason.
+// User marks and spans (UserTimings) are drained from their per-thread rings on the same writer.
+// start() and stop() do file I/O and join the writer, they are called off the JS thread
+// (HybridPerformanceMetrics runs them through Promise::async).
+class SessionRecorder {
+public:
+  static constexpr const char* FILE_EXTENSION = ".rnptsession";
+  static constexpr uint32_t QUEUE_CAPACITY = 8192; // Power of two, ~30 s of samples at 120 Hz
+  static constexpr uint32_t DRAIN_INTERVAL_MS = 200;
+  static constexpr uint32_t INDEX_INTERVAL_MS = 1000;
+  static constexpr size_t GROWTH_BYTES = 1024 * 1024;
+
+  static SessionRecorder& get();
+
+  // Where sessions are written when no explicit path is given, set by the platform (app cache dir)
+  void setDirectory(std::string directory);
+
+  // Starts a session writing to `path` (or a new file in the directory), returns the file path.
+  // Throws if a session is already running or the file can't be created
+  std::string start(const std::optional<std::string>& path);
+  // Flushes and closes the current session, returns its path or nullopt if none was running.
+  // Waits for the writer thread to finish its last drain. Throws if the session ended early because
+  // the file couldn't grow, the file then stays readable up to that point
+  std::optional<std::string> stop();
+
+  bool isRecording() const {
+    return _recording.load(std::memory_order_acquire);
+  }
+
+  // Called by the producers on any thread, never blocks, a no-op while no session is running
+  void record(SessionRecordType type, int64_t timeNs, double value) {
+    if (isRecording()) {
+      push(type, timeNs, value);
+    }
+  }
+
+private:
+  SessionRecorder() = default;
+  ~SessionRecorder();
+
+  struct Sample {
+    int64_t timeNs;
+    double value;
+    SessionRecordType type;
+  };
+
+  struct Cell {
+    std::atomic<uint64_t> sequence;
+    Sample sample;
+  };
+
+  void push(SessionRecordType type, int64_t timeNs, double value);
+  bool pop(Sample& out);
+
+  void runWriter();
+  void drain();
+  void writeIndex(int64_t timeNs);
+  void writeSample(const Sample& sample);
+  void writeUserTiming(const UserTimingEvent& event);
+  void writeName(uint32_t id, const std::string& name);
+  bool reserve(size_t bytes);
+  void fail(const char* what, int error);
+  void closeFile();
+  uint64_t droppedSamples() const; // Queue and user timing events lost during this session
+
+  std::unique_ptr<Cell[]> _queue;
+  alignas(64) std::atomic<uint64_t> _enqueuePosition{0};
+  alignas(64) std::atomic<uint64_t> _dequeuePosition{0};
+  alignas(64) std::atomic<uint64_t> _droppedSamples{0};
+  std::atomic<bool> _recording{false};
+
+  // Neither mutex is ever taken by producers
+  std::mutex _lifecycleMutex; // Serializes start / stop
+  std::string _directory;
+  std::string _path;
+  std::thread _writer;
+  std::mutex _writerMutex;
+  std::condition_variable _writerWakeup;
+  bool _stopping = false;
+
+  // Writer thread state
+  int _fd = -1;
+  uint8_t* _mapping = nullptr;
+  size_t _mappedSize = 0;
+  size_t _writeOffset = 0;
+  uint64_t _recordCount = 0;
+  uint64_t _lastIndexOffset = 0;
+  int64_t _lastIndexTimeNs = 0;
+  int64_t _lastTimeUs = 0;
+  std::array<int64_t, static_cast<size_t>(SessionRecordType::Count)> _lastValues{};
+  uint32_t _writtenNames = 0;         // User timing names with id <= this are in the file
+  uint64_t _userTimingsDroppedAtStart = 0;
+  std::string _failure; // Why the session ended early, read by stop() after joining the writer
+};
+
+} // namespace margelo::nitro::performancetoolkit
@@ -0,0 +1,109 @@
+#include "SlidingFpsWindow.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace margelo::nitro::performancetoolkit {
+
+static double toFps(double frames, long long stallNs, long long durationNs, bool stallBased, double maxFps) {
+  if (durationNs <= 0) {
+    return 0.0;
+  }
+  const double fps = stallBased
+    ? maxFps * (1.0 - static_cast<double>(std::min(stallNs, durationNs)) / static_cast<double>(durationNs))
+    : frames * 1'000'000'000.0 / static_cast<double>(durationNs);
+  return std::clamp(fps, 0.0, maxFps);
+}
+
+SlidingFpsWindow::SlidingFpsWindow() : _sessionStartNs(0), _sessionFrames(0), _sessionStallNs(0) {
+  for (auto& slot : _slots) {
+    slot.index = -1;
+    slot.frames = 0;
+    slot.stallNs = 0;
+  }
+}
+
+void SlidingFpsWindow::reset(long long nowNs) {
+  _sessionFrames = 0;
+  _sessionStallNs = 0;
+  _sessionStartNs = nowNs;
+}
+
+SlidingFpsWindow::Slot& SlidingFpsWindow::claim(long long index) {
+  Slot& slot = _slots[static_cast<size_t>(index % SLOT_COUNT)];
+  if (slot.index.load(std::memory_order_acquire) != index) {
+    // Still holds a slot from one or more turns ago
+    slot.frames.store(0, std::memory_order_relaxed);
+    slot.stallNs.store(0, std::memory_order_relaxed);
+    slot.index.store(index, std::memory_order_release);
+  }
+  return slot;
+}
+
+void SlidingFpsWindow::addFrame(long long tickNs) {
+  claim(tickNs / SLOT_NS).frames.fetch_add(1, std::memory_order_relaxed);
+  _sessionFrames.fetch_add(1, std::memory_order_relaxed);
+}
+
+void SlidingFpsWindow::addStall(long long fromNs, long long toNs) {
+  if (toNs <= fromNs) {
+    return;
+  }
+  _sessionStallNs.fetch_add(toNs - fromNs, std::memory_order_relaxed);
+  // Slots older than the ring are gone, a long stall only fills the ones it still covers
+  const long long lastIndex = (toNs - 1) / SLOT_NS;
+  const long long firstIndex = std::max(fromNs / SLOT_NS, lastIndex - static_cast<long long>(SLOT_COUNT) + 1);
+  for (long long index = firstIndex; index <= lastIndex; index++) {
+    const long long slotStartNs = std::max(fromNs, index * SLOT_NS);
+    const long long slotEndNs = std::min(toNs, (index + 1) * SLOT_NS);
+    claim(index).stallNs.fetch_add(slotEndNs - slotStartNs, std::memory_order_relaxed);
+  }
+}
+
+double SlidingFpsWindow::average(long long fromNs, long long toNs, bool stallBased, double maxFps, long long pendingStallFromNs) const {
+  double frames = 0.0;
+  double stallNs = 0.0;
+  for (long long index = fromNs / SLOT_NS; index * SLOT_NS < toNs; index++) {
+    const Slot& slot = _slots[static_cast<size_t>(index % SLOT_COUNT)];
+    if (slot.index.load(std::memory_order_acquire) != index) {
+      continue; // Nothing was added while it was current
+    }
+    // A span clamped to the session start begins mid-slot, it only gets the slot's share after the
+    // start. Activity before it belongs to the previous session
+    const long long slotStartNs = index * SLOT_NS;
+    const long long coveredNs = std::min(toNs, slotStartNs + SLOT_NS) - std::max(fromNs, slotStartNs);
+    const double share = static_cast<double>(coveredNs) / static_cast<double>(SLOT_NS);
+    frames += share * static_cast<double>(slot.frames.load(std::memory_order_relaxed));
+    stallNs += share * static_cast<double>(slot.stallNs.load(std::memory_order_relaxed));
+  }
+  if (stallBased && pendingStallFromNs != 0) {
+    stallNs += static_cast<double>(std::max(0LL, toNs - std::max(pendingStallFromNs, fromNs)));
+  }
+  return toFps(frames, std::llround(stallNs), toNs - fromNs, stallBased, maxFps);
+}
+
+SlidingFpsWindow::Averages SlidingFpsWindow::compute(long long nowNs, bool stallBased, double maxFps, long long pendingStallFromNs) const {
+  const long long sessionStartNs = _sessionStartNs.load();
+  if (sessionStartNs == 0) {
+    return Averages{0.0, 0.0, 0.0, 0.0};
+  }
+  // Spans end where the slot being filled starts
+  const long long endNs = (nowNs / SLOT_NS) * SLOT_NS;
+  const auto span = [&](uint32_t slots) {
+    const long long startNs = std::max(endNs - static_cast<long long>(slots) * SLOT_NS, sessionStartNs);
+    return average(startNs, endNs, stallBased, maxFps, pendingStallFromNs);
+  };
+
+  long long sessionStallNs = _sessionStallNs.load(std::memory_order_relaxed);
+  if (stallBased && pendingStallFromNs != 0) {
+    sessionStallNs += std::max(0LL, nowNs - std::max(pendingStallFromNs, sessionStartNs));
+  }
+  return Averages{
+    span(INSTANT_SLOTS),
+    span(ONE_SECOND_SLOTS),
+    span(FIVE_SECOND_SLOTS),
+    toFps(static_cast<double>(_sessionFrames.load(std::memory_order_relaxed)), sessionStallNs, nowNs - sessionStartNs, stallBased, maxFps),
+  };
+}
+
+} // namespace margelo::nitro::performancetoolkit
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace margelo::nitro::performancetoolkit {
+
+// JS thread activity over the last few seconds in a ring of SLOT_MS slots, so FPS over any span up
+// to FIVE_SECOND_SLOTS slots comes from the same counters without a tumbling window per span.
+// Every probe adds to the slot its tick falls into: a frame (continuous mode) or the part of its
+// wait beyond one frame (on-demand mode, split across the slots it covers). Slots are tagged with
+// the absolute slot number they hold, so a slot nothing was added to since it last came around
+// reads as empty, no task has to clear it.
+//
+// Written by one thread at a time (the JS thread running the probes), read from any thread.
+// A read racing with the write of the slot being filled may miss that one update, which is why
+// averages only cover completed slots.
+class SlidingFpsWindow {
+public:
+  static constexpr long long SLOT_MS = 250; // Resolution, also how often averages are worth publishing
+  static constexpr uint32_t INSTANT_SLOTS = 1;
+  static constexpr uint32_t ONE_SECOND_SLOTS = 4;
+  static constexpr uint32_t FIVE_SECOND_SLOTS = 20;
+
+  struct Averages {
+    double instant;     // Last completed slot
+    double oneSecond;   // Last four completed slots
+    double fiveSeconds; // Last twenty completed slots
+    double session;     // Since reset, up to now
+  };
+
+  SlidingFpsWindow();
+
+  // Starts a new session at `nowNs`, slots before it are left out of every average
+  void reset(long long nowNs);
+  void addFrame(long long tickNs);
+  void addStall(long long fromNs, long long toNs);
+
+  // Frame counts (continuous mode) or stall time (on-demand mode, `stallBased`) as FPS, capped at
+  // `maxFps`. A probe still waiting since `pendingStallFromNs` (0 if none) counts as stalled until now
+  Averages compute(long long nowNs, bool stallBased, double maxFps, long long pendingStallFromNs) const;
+
+private:
+  static constexpr long long SLOT_NS = SLOT_MS * 1'000'000;
+  static constexpr uint32_t SLOT_COUNT = FIVE_SECOND_SLOTS + 1; // Plus the slot being filled
+
+  struct Slot {
+    std::atomic<long long> index; // Absolute slot number (time / SLOT_NS) the counters belong to
+    std::atomic<uint32_t> frames;
+    std::atomic<long long> stallNs;
+  };
+
+  Slot& claim(long long index);
+  double average(long long fromNs, long long toNs, bool stallBased, double maxFps, long long pendingStallFromNs) const;
+
+  std::array<Slot, SLOT_COUNT> _slots;
+  std::atomic<long long> _sessionStartNs;
+  std::atomic<uint64_t> _sessionFrames;
+  std::atomic<long long> _sessionStallNs;
+};
+
+} // namespace margelo::nitro::performancetoolkit
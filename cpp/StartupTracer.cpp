@@ -0,0 +1,124 @@
+#include "StartupTracer.hpp"
+#include "CpuSampler.hpp"
+
+#include <chrono>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+#elif defined(__APPLE__)
+#include <sys/sysctl.h>
+#include <sys/time.h>
+#include <unistd.h>
+#endif
+
+namespace margelo::nitro::performancetoolkit {
+
+#if defined(__linux__)
+static constexpr size_t STAT_BUFFER_SIZE = 1024; // stat lines are ~300 bytes
+#endif
+
+StartupTracer& StartupTracer::get() {
+  static StartupTracer instance;
+  return instance;
+}
+
+StartupTracer::StartupTracer() {
+  for (auto& milestoneMs : _milestonesMs) {
+    milestoneMs = 0.0;
+  }
+  _milestonesMs[static_cast<size_t>(StartupMilestone::ProcessStart)] = readProcessStartMs();
+}
+
+bool StartupTracer::mark(StartupMilestone milestone) {
+  auto& milestoneMs = _milestonesMs[static_cast<size_t>(milestone)];
+  // Marked from every UI frame, skip the clock read once it was recorded
+  if (milestoneMs.load(std::memory_order_relaxed) != 0.0) {
+    return false;
+  }
+  double expected = 0.0;
+  return milestoneMs.compare_exchange_strong(expected, nowMs());
+}
+
+double StartupTracer::getMs(StartupMilestone milestone) const {
+  return _milestonesMs[static_cast<size_t>(milestone)].load();
+}
+
+void StartupTracer::onMainRuntimeRegistered(const RuntimeExecutor& executor) {
+  if (!mark(StartupMilestone::RuntimeCreated)) {
+    return; // A reload, startup is over
+  }
+  // Runs once the JS thread gets to it, which is after the bundle started evaluating
+  executor([](jsi::Runtime&) { StartupTracer::get().mark(StartupMilestone::FirstJsTick); });
+}
+
+void StartupTracer::resetForTesting() {
+  for (size_t milestone = 0; milestone < _milestonesMs.size(); milestone++) {
+    if (milestone != static_cast<size_t>(StartupMilestone::ProcessStart)) {
+      _milestonesMs[milestone] = 0.0;
+    }
+  }
+}
+
+double StartupTracer::nowMs() {
+  const auto now = std::chrono::steady_clock::now().time_since_epoch();
+  return std::chrono::duration<double, std::milli>(now).count();
+}
+
+#if defined(__linux__)
+
+// starttime counts from boot including suspend (CLOCK_BOOTTIME), the steady clock doesn't
+double StartupTracer::readProcessStartMs() {
+  const int fd = open("/proc/self/stat", O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    return 0.0;
+  }
+  char data[STAT_BUFFER_SIZE];
+  const ssize_t length = read(fd, data, sizeof(data));
+  close(fd);
+  if (length <= 0) {
+    return 0.0;
+  }
+
+  CpuSampler::ParsedStat stat{};
+  if (!CpuSampler::parseStat(data, static_cast<size_t>(length), stat) || stat.startTicks == 0) {
+    return 0.0; // Truncated
+  }
+
+  const long ticksPerSecond = sysconf(_SC_CLK_TCK);
+  timespec bootTime{};
+  if (ticksPerSecond <= 0 || clock_gettime(CLOCK_BOOTTIME, &bootTime) != 0) {
+    return 0.0;
+  }
+  const double bootNowMs = static_cast<double>(bootTime.tv_sec) * 1000.0 + static_cast<double>(bootTime.tv_nsec) / 1'000'000.0;
+  const double startMs = static_cast<double>(stat.startTicks) * 1000.0 / static_cast<double>(ticksPerSecond);
+  return nowMs() - (bootNowMs - startMs);
+}
+
+#elif defined(__APPLE__)
+
+// p_starttime is wall clock time, only the elapsed time since then carries over to the steady clock
+double StartupTracer::readProcessStartMs() {
+  int mib[4] = {CTL_KERN, KERN_PROC, KERN_PROC_PID, getpid()};
+  kinfo_proc info{};
+  size_t size = sizeof(info);
+  if (sysctl(mib, 4, &info, &size, nullptr, 0) != 0 || size == 0) {
+    return 0.0;
+  }
+  timeval now{};
+  gettimeofday(&now, nullptr);
+  const timeval& start = info.kp_proc.p_starttime;
+  const double elapsedMs = static_cast<double>(now.tv_sec - start.tv_sec) * 1000.0 + static_cast<double>(now.tv_usec - start.tv_usec) / 1000.0;
+  return nowMs() - elapsedMs;
+}
+
+#else
+
+double StartupTracer::readProcessStartMs() {
+  return 0.0;
+}
+
+#endif
+
+} // namespace margelo::nitro::performancetoolkit
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <jsi/jsi.h>
+#include <ReactCommon/RuntimeExecutor.h>
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace margelo::nitro::performancetoolkit {
+
+using namespace facebook;
+using namespace facebook::react;
+
+enum class StartupMilestone : uint32_t {
+  ProcessStart = 0,    // From the kernel (/proc/self/stat starttime, sysctl KERN_PROC on iOS)
+  NativeLibraryLoaded, // JNI_OnLoad on Android, image initializers on iOS
+  RuntimeCreated,      // First main JS runtime handed to the toolkit's TurboModule
+  BindingsInstalled,   // The TurboModule's JSI bindings installed into that runtime
+  FirstJsTick,         // First task that ran on that runtime's JS thread after it was handed over
+  FirstUiFrame,        // First UI frame after the native library loaded
+  Count,
+};
+
+// When the process got to each startup milestone, for tracking cold start across releases. Every
+// milestone is recorded once per process, the first time it is reached, in steady clock ms (the
+// metrics block's timebase), 0 while it wasn't reached. Reloads don't record anything again.
+//
+// Platforms mark the milestones only they can see (library load, bindings, first UI frame),
+// RuntimeBridgeState marks the runtime and posts the first JS tick. Process start is read from
+// the kernel once, when the tracer is first used, and converted from boot / wall time.
+class StartupTracer {
+public:
+  static StartupTracer& get();
+
+  // Returns whether this call recorded it, false if it was already recorded
+  bool mark(StartupMilestone milestone);
+  double getMs(StartupMilestone milestone) const;
+
+  // The main runtime was registered, the first time also posts the FirstJsTick mark to it
+  void onMainRuntimeRegistered(const RuntimeExecutor& executor);
+
+  // Forgets every milestone except ProcessStart, as if the process just started. Tests only,
+  // nothing else may be marking at the same time
+  void resetForTesting();
+
+private:
+  StartupTracer();
+
+  static double nowMs();
+  static double readProcessStartMs();
+
+  std::array<std::atomic<double>, static_cast<size_t>(StartupMilestone::Count)> _milestonesMs;
+};
+
+} // namespace margelo::nitro::performancetoolkit
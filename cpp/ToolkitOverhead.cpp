@@ -0,0 +1,90 @@
+#include "ToolkitOverhead.hpp"
+#include "MetricsBlock.hpp"
+#include "SamplerRates.hpp"
+#include "TrackerScheduler.hpp"
+
+#include <chrono>
+#include <ctime>
+
+namespace margelo::nitro::performancetoolkit {
+
+static int64_t nowNs() {
+  const auto now = std::chrono::steady_clock::now().time_since_epoch();
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+}
+
+// Whether a ScopedTimer is running on this thread, e.g. a probe run from the UI executor's batch
+static thread_local bool timerRunning = false;
+
+ToolkitOverhead::ScopedTimer::ScopedTimer(TimedWork work) : _work(work), _outermost(!timerRunning) {
+  if (_outermost) {
+    timerRunning = true;
+    _startNs = nowNs();
+  }
+}
+
+ToolkitOverhead::ScopedTimer::~ScopedTimer() {
+  if (_outermost) {
+    timerRunning = false;
+    ToolkitOverhead::get().addTimedWork(_work, nowNs() - _startNs);
+  }
+}
+
+ToolkitOverhead& ToolkitOverhead::get() {
+  static ToolkitOverhead instance;
+  return instance;
+}
+
+void ToolkitOverhead::start() {
+  std::call_once(_started, [this]() {
+    SamplerRates::get().schedule(SamplerKind::ToolkitOverhead, [this]() { sample(); }, std::chrono::milliseconds(0));
+  });
+}
+
+void ToolkitOverhead::addTimedWork(TimedWork work, int64_t durationNs) {
+  _timedNs[static_cast<size_t>(work)].fetch_add(durationNs, std::memory_order_relaxed);
+}
+
+ToolkitOverhead::Totals ToolkitOverhead::totals() const {
+  return Totals{
+    _schedulerCpuNs.load(std::memory_order_relaxed),
+    _sessionWriterCpuNs.load(std::memory_order_relaxed),
+    _timedNs[static_cast<size_t>(TimedWork::JsTask)].load(std::memory_order_relaxed),
+    _timedNs[static_cast<size_t>(TimedWork::UiFrame)].load(std::memory_order_relaxed),
+    _jsTasks.load(std::memory_order_relaxed),
+    TrackerScheduler::get().getWakeupCount() + _wakeups.load(std::memory_order_relaxed),
+    _jsiCalls.load(std::memory_order_relaxed),
+    _measuredSinceNs.load(std::memory_order_relaxed),
+  };
+}
+
+int64_t ToolkitOverhead::threadCpuNs() {
+  timespec time{};
+  if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time) != 0) {
+    return 0;
+  }
+  return static_cast<int64_t>(time.tv_sec) * 1'000'000'000 + time.tv_nsec;
+}
+
+void ToolkitOverhead::sample() {
+  // Runs on the scheduler thread, so this is the scheduler's own CPU time
+  _schedulerCpuNs.store(threadCpuNs(), std::memory_order_relaxed);
+  const int64_t now = nowNs();
+  const Totals current = totals();
+  const int64_t cpuNs = current.schedulerCpuNs + current.sessionWriterCpuNs + current.jsTaskNs + current.uiFrameNs;
+
+  if (_lastSampleNs == 0) {
+    _measuredSinceNs.store(now, std::memory_order_relaxed);
+  } else if (now > _lastSampleNs) {
+    const double intervalNs = static_cast<double>(now - _lastSampleNs);
+    MetricsBlock::get().publish({
+      {MetricSlot::ToolkitCpuUsage, static_cast<double>(cpuNs - _lastCpuNs) / intervalNs * 100.0},
+      {MetricSlot::ToolkitJsThreadUsage, static_cast<double>(current.jsTaskNs - _lastJsTaskNs) / intervalNs * 100.0},
+    });
+  }
+  _lastSampleNs = now;
+  _lastCpuNs = cpuNs;
+  _lastJsTaskNs = current.jsTaskNs;
+}
+
+} // namespace margelo::nitro::performancetoolkit
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+namespace margelo::nitro::performancetoolkit {
+
+// What the toolkit itself costs the app, so it can be kept under budget in production builds.
+//
+// Each part is measured where it runs, with the cheapest clock that is accurate for it:
+//   - TrackerScheduler thread (pacing, reporting, procfs samplers, listener delivery): its thread
+//     CPU clock, read by the publishing task which runs on that thread, so no extra wakeup
+//   - Session writer threads: thread CPU clock after every drain
+//   - Tasks posted to JS runtimes (FPS probes, heap samples) and UI frame callbacks: steady clock
+//     around the work, these run on threads that aren't ours so their CPU clock would include app work
+// Counters: scheduler and writer wakeups, tasks posted to JS runtimes (counted when posted, run or
+// not), calls into a jsi::Runtime (counted at every call site).
+//
+// Every sample (SAMPLE_INTERVAL_MS by default) the share of one core used over the interval is published to the
+// metrics block (ToolkitCpuUsage, ToolkitJsThreadUsage), cumulative totals are read with totals().
+class ToolkitOverhead {
+public:
+  static constexpr uint32_t SAMPLE_INTERVAL_MS = 1000; // Default period, see SamplerRates
+
+  enum class TimedWork : uint32_t {
+    JsTask = 0, // On a JS runtime, summed over all runtimes
+    UiFrame,    // Inside the platform's UI frame callback
+    Count,
+  };
+
+  struct Totals {
+    int64_t schedulerCpuNs;
+    int64_t sessionWriterCpuNs;
+    int64_t jsTaskNs;
+    int64_t uiFrameNs;
+    uint64_t jsTasks;
+    uint64_t wakeups;
+    uint64_t jsiCalls;
+    int64_t measuredSinceNs; // Steady clock, when the first sample was taken, 0 before that
+  };
+
+  // Adds the lifetime of the enclosing scope to `work`, two steady clock reads. A timer nested in
+  // another one on the same thread adds nothing, the outermost one already covers its time
+  class ScopedTimer {
+  public:
+    explicit ScopedTimer(TimedWork work);
+    ~ScopedTimer();
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+  private:
+    TimedWork _work;
+    bool _outermost;
+    int64_t _startNs = 0;
+  };
+
+  static ToolkitOverhead& get();
+
+  // Starts publishing on the first call
+  void start();
+
+  Totals totals() const;
+
+  void addTimedWork(TimedWork work, int64_t durationNs);
+  void addSessionWriterCpu(int64_t cpuNs) {
+    _sessionWriterCpuNs.fetch_add(cpuNs, std::memory_order_relaxed);
+  }
+  void addWakeup() {
+    _wakeups.fetch_add(1, std::memory_order_relaxed);
+  }
+  void addJsTask() {
+    _jsTasks.fetch_add(1, std::memory_order_relaxed);
+  }
+  void addJsiCalls(uint64_t count = 1) {
+    _jsiCalls.fetch_add(count, std::memory_order_relaxed);
+  }
+
+  // CPU time of the calling thread in ns
+  static int64_t threadCpuNs();
+
+private:
+  ToolkitOverhead() = default;
+
+  void sample();
+
+  std::once_flag _started;
+  std::array<std::atomic<int64_t>, static_cast<size_t>(TimedWork::Count)> _timedNs{};
+  std::atomic<uint64_t> _jsTasks{0};
+  std::atomic<int64_t> _schedulerCpuNs{0};
+  std::atomic<int64_t> _sessionWriterCpuNs{0};
+  std::atomic<uint64_t> _wakeups{0};
+  std::atomic<uint64_t> _jsiCalls{0};
+  std::atomic<int64_t> _measuredSinceNs{0};
+
+  // Scheduler thread only, totals at the previous sample
+  int64_t _lastSampleNs = 0;
+  int64_t _lastCpuNs = 0;
+  int64_t _lastJsTaskNs = 0;
+};
+
+} // namespace margelo::nitro::performancetoolkit
@@ -0,0 +1,34 @@
+#include "TrackerClock.hpp"
+
+namespace margelo::nitro::performancetoolkit {
+
+namespace {
+
+class SteadyClock : public TrackerClock {
+public:
+  Clock::time_point now() const override {
+    return Clock::now();
+  }
+};
+
+} // namespace
+
+TrackerClock& TrackerClock::steady() {
+  static SteadyClock instance;
+  return instance;
+}
+
+VirtualClock::VirtualClock(Clock::time_point start) : _now(start.time_since_epoch().count()) {}
+
+TrackerClock::Clock::time_point VirtualClock::now() const {
+  return Clock::time_point(Clock::duration(_now.load(std::memory_order_acquire)));
+}
+
+void VirtualClock::advanceTo(Clock::time_point time) {
+  const Clock::rep target = time.time_since_epoch().count();
+  Clock::rep current = _now.load(std::memory_order_relaxed);
+  while (target > current && !_now.compare_exchange_weak(current, target, std::memory_order_release)) {
+  }
+}
+
+} // namespace margelo::nitro::performancetoolkit
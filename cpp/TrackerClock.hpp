@@ -0,0 +1,40 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+
+namespace margelo::nitro::performancetoolkit {
+
+// Time source of a TrackerScheduler and of the trackers driven by it. Apps run on the steady
+// clock, simulations on a VirtualClock that only moves when its scheduler is advanced, so tracker
+// math can be checked against a load profile without waiting for real time to pass.
+class TrackerClock {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  virtual ~TrackerClock() = default;
+
+  virtual Clock::time_point now() const = 0;
+
+  // The process-wide steady clock
+  static TrackerClock& steady();
+};
+
+// Clock of a simulation, moved forward by TrackerScheduler::advanceTo only
+class VirtualClock : public TrackerClock {
+public:
+  // Trackers treat time 0 as "never happened", so a simulation starts later than that
+  static constexpr Clock::duration DEFAULT_START = std::chrono::hours(1);
+
+  explicit VirtualClock(Clock::time_point start = Clock::time_point(DEFAULT_START));
+
+  Clock::time_point now() const override;
+
+  // Never moves backwards, earlier times are ignored
+  void advanceTo(Clock::time_point time);
+
+private:
+  std::atomic<Clock::rep> _now;
+};
+
+} // namespace margelo::nitro::performancetoolkit
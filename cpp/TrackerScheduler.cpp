@@ -0,0 +1,139 @@
+#include "TrackerScheduler.hpp"
+
+#include <stdexcept>
+
+namespace margelo::nitro::performancetoolkit {
+
+TrackerScheduler& TrackerScheduler::get() {
+  static TrackerScheduler instance;
+  return instance;
+}
+
+TrackerScheduler::TrackerScheduler() : _clock(TrackerClock::steady()), _virtualClock(nullptr) {}
+
+TrackerScheduler::TrackerScheduler(VirtualClock& clock) : _clock(clock), _virtualClock(&clock) {}
+
+TrackerScheduler::~TrackerScheduler() {
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _stopping = true;
+  }
+  _condition.notify_all();
+  if (_thread.joinable()) {
+    _thread.join();
+  }
+}
+
+TrackerScheduler::TaskId TrackerScheduler::schedule(Clock::duration delay, Task task, Clock::duration alignment) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  const TaskId id = _nextTaskId++;
+  _tasks.emplace(id, std::make_shared<Scheduled>(Scheduled{std::move(task), alignment, 0}));
+  _queue.push(Entry{align(_clock.now() + delay, alignment), id, 0});
+
+  // Thread is started lazily so apps that never read a metric don't pay for it
+  if (_virtualClock == nullptr && !_thread.joinable()) {
+    _thread = std::thread([this]() { run(); });
+  }
+  _condition.notify_one();
+  return id;
+}
+
+void TrackerScheduler::cancel(TaskId id) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  // Queue entry is dropped lazily once it becomes due
+  _tasks.erase(id);
+}
+
+void TrackerScheduler::reschedule(TaskId id, Clock::duration delay) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  auto it = _tasks.find(id);
+  if (it == _tasks.end()) {
+    return;
+  }
+  // Like cancel, the entry already queued is dropped once it becomes due
+  Scheduled& scheduled = *it->second;
+  scheduled.generation++;
+  _queue.push(Entry{align(_clock.now() + delay, scheduled.alignment), id, scheduled.generation});
+  _condition.notify_one();
+}
+
+uint64_t TrackerScheduler::getWakeupCount() const {
+  return _wakeups.load(std::memory_order_relaxed);
+}
+
+void TrackerScheduler::advanceTo(Clock::time_point time) {
+  if (_virtualClock == nullptr) {
+    throw std::runtime_error("Only a scheduler on a VirtualClock can be advanced");
+  }
+  std::unique_lock<std::mutex> lock(_mutex);
+  // Jump from one due time to the next, whatever is due at the same time runs in one batch
+  while (!_stopping && !_queue.empty() && _queue.top().due <= time) {
+    _virtualClock->advanceTo(_queue.top().due);
+    runDueTasks(lock);
+  }
+  _virtualClock->advanceTo(time);
+}
+
+void TrackerScheduler::run() {
+  std::unique_lock<std::mutex> lock(_mutex);
+  while (!_stopping) {
+    if (_queue.empty()) {
+      _condition.wait(lock);
+    } else {
+      // Copy, the queue may reallocate while the lock is released during the wait
+      const Clock::time_point due = _queue.top().due;
+      _condition.wait_until(lock, due);
+    }
+    _wakeups.fetch_add(1, std::memory_order_relaxed);
+
+    // Run everything that is due, tasks due at the same time share one wakeup
+    runDueTasks(lock);
+  }
+}
+
+void TrackerScheduler::runDueTasks(std::unique_lock<std::mutex>& lock) {
+  while (!_stopping && !_queue.empty() && _queue.top().due <= _clock.now()) {
+    const Entry entry = _queue.top();
+    _queue.pop();
+
+    auto it = _tasks.find(entry.id);
+    if (it == _tasks.end()) {
+      continue; // cancelled
+    }
+    auto scheduled = it->second;
+    if (entry.generation != scheduled->generation) {
+      continue; // rescheduled, the newer entry runs it
+    }
+
+    lock.unlock();
+    const std::optional<Clock::duration> nextDelay = scheduled->task();
+    lock.lock();
+
+    if (!nextDelay.has_value()) {
+      _tasks.erase(entry.id);
+      continue;
+    }
+    if (_tasks.find(entry.id) == _tasks.end() || scheduled->generation != entry.generation) {
+      continue; // cancelled or rescheduled while running
+    }
+
+    // Fixed-rate scheduling, but never try to catch up on runs we already missed
+    const auto now = _clock.now();
+    auto nextDue = entry.due + *nextDelay;
+    if (nextDue <= now) {
+      nextDue = now + *nextDelay;
+    }
+    _queue.push(Entry{align(nextDue, scheduled->alignment), entry.id, entry.generation});
+  }
+}
+
+TrackerScheduler::Clock::time_point TrackerScheduler::align(Clock::time_point time, Clock::duration alignment) {
+  if (alignment <= Clock::duration::zero()) {
+    return time;
+  }
+  const auto sinceEpoch = time.time_since_epoch();
+  const auto remainder = sinceEpoch % alignment;
+  return remainder == Clock::duration::zero() ? time : time + (alignment - remainder);
+}
+
+} // namespace margelo::nitro::performancetoolkit
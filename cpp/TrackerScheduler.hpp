@@ -0,0 +1,103 @@
+#pragma once
+
+#include "TrackerClock.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <queue>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace margelo::nitro::performancetoolkit {
+
+// Process-wide timer thread shared by all trackers, so N trackers cost one thread
+// and their wakeups can coincide instead of each tracker owning its own sleep loops.
+//
+// Tasks run on the scheduler thread and must stay cheap (post work elsewhere, never block).
+// A task returns the delay until its next run, or std::nullopt to stop. Repeating tasks are
+// fixed-rate: the next run is due `delay` after the previous due time, not after it finished.
+// Tasks scheduled with an alignment have every due time rounded up to a multiple of it on the
+// clock, so periodic samplers started at different moments still wake the thread together.
+//
+// Besides the process-wide instance, simulations create their own scheduler on a VirtualClock.
+// It has no thread: tasks run on the caller of advanceTo, in due order, with the clock set to
+// each task's due time, so minutes of tracker activity replay in milliseconds.
+class TrackerScheduler {
+public:
+  using Clock = TrackerClock::Clock;
+  using TaskId = uint64_t;
+  using Task = std::function<std::optional<Clock::duration>()>;
+
+  static TrackerScheduler& get();
+
+  explicit TrackerScheduler(VirtualClock& clock);
+  ~TrackerScheduler();
+
+  TrackerScheduler(const TrackerScheduler&) = delete;
+  TrackerScheduler& operator=(const TrackerScheduler&) = delete;
+
+  // Current time of this scheduler's clock, what trackers driven by it must measure with
+  Clock::time_point now() const {
+    return _clock.now();
+  }
+
+  // Simulation only: runs every task due up to `time`, including tasks scheduled by them,
+  // then leaves the clock at `time`. Throws on the process-wide scheduler
+  void advanceTo(Clock::time_point time);
+  void advanceBy(Clock::duration duration) {
+    advanceTo(now() + duration);
+  }
+
+  TaskId schedule(Clock::duration delay, Task task, Clock::duration alignment = Clock::duration::zero());
+  // After cancel returns the task will not be started again (it may still be running right now)
+  void cancel(TaskId id);
+  // Moves the next run of a task to `delay` from now (aligned as scheduled), for periods changed
+  // at runtime. A no-op for tasks that were cancelled or finished
+  void reschedule(TaskId id, Clock::duration delay);
+
+  // Number of times the scheduler thread woke up, for measuring tracker overhead
+  uint64_t getWakeupCount() const;
+
+private:
+  TrackerScheduler();
+
+  struct Scheduled {
+    Task task;
+    Clock::duration alignment;
+    uint64_t generation; // Bumped by reschedule, queue entries of older generations are stale
+  };
+
+  struct Entry {
+    Clock::time_point due;
+    TaskId id;
+    uint64_t generation;
+
+    bool operator>(const Entry& other) const {
+      return due > other.due;
+    }
+  };
+
+  void run();
+  // Runs the tasks due by now, `lock` is held on entry and exit but released around each task
+  void runDueTasks(std::unique_lock<std::mutex>& lock);
+  static Clock::time_point align(Clock::time_point time, Clock::duration alignment);
+
+  TrackerClock& _clock;
+  VirtualClock* const _virtualClock; // nullptr for the process-wide scheduler
+  std::mutex _mutex;
+  std::condition_variable _condition;
+  std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> _queue;
+  std::unordered_map<TaskId, std::shared_ptr<Scheduled>> _tasks;
+  TaskId _nextTaskId = 1;
+  bool _stopping = false;
+  std::thread _thread;
+  std::atomic<uint64_t> _wakeups{0};
+};
+
+} // namespace margelo::nitro::performancetoolkit
@@ -0,0 +1,197 @@
+#include "UiFrameAnalyzer.hpp"
+#include "MetricHistograms.hpp"
+#include "MetricsBlock.hpp"
+#include "RuntimeBridge.hpp"
+#include "SamplerRates.hpp"
+#include "SessionRecorder.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace margelo::nitro::performancetoolkit {
+
+static double nsToMs(int64_t ns) {
+  return static_cast<double>(ns) / 1e6;
+}
+
+UiFrameAnalyzer& UiFrameAnalyzer::get() {
+  static UiFrameAnalyzer instance;
+  return instance;
+}
+
+UiFrameClass UiFrameAnalyzer::classify(double durationMs, double recentFrameMs, double frameIntervalMs) {
+  if (durationMs > FROZEN_MIN_MS) {
+    return UiFrameClass::Frozen;
+  }
+  const bool slowerThanRecent = durationMs > recentFrameMs * 2.0;
+  if (slowerThanRecent && durationMs > BIG_JANK_MIN_MS) {
+    return UiFrameClass::BigJank;
+  }
+  if (slowerThanRecent && durationMs > JANK_MIN_MS) {
+    return UiFrameClass::Jank;
+  }
+  if (droppedFrames(durationMs, frameIntervalMs) >= STUTTER_DROPPED_FRAMES) {
+    return UiFrameClass::Stutter;
+  }
+  return UiFrameClass::Smooth;
+}
+
+uint32_t UiFrameAnalyzer::droppedFrames(double durationMs, double frameIntervalMs) {
+  if (frameIntervalMs <= 0.0) {
+    return 0;
+  }
+  // Rounded so vsync jitter around one interval doesn't count as a dropped frame
+  const double intervals = std::round(durationMs / frameIntervalMs);
+  return intervals > 1.0 ? static_cast<uint32_t>(intervals) - 1 : 0;
+}
+
+void UiFrameAnalyzer::setWindowMs(uint32_t windowMs) {
+  _windowMs.store(windowMs, std::memory_order_relaxed);
+}
+
+uint32_t UiFrameAnalyzer::getWindowMs() const {
+  return _windowMs.load(std::memory_order_relaxed);
+}
+
+void UiFrameAnalyzer::onFrame(int64_t frameTimeNs, int64_t targetFrameTimeNs) {
+  const uint32_t windowMs = _windowMs.load(std::memory_order_relaxed);
+  if (windowMs == 0) {
+    _lastFrameNs = 0; // Paused, restart with the first frame after resuming
+    return;
+  }
+  if (_lastFrameNs == 0) {
+    restart(frameTimeNs);
+    _lastTargetNs = targetFrameTimeNs;
+    return;
+  }
+  const double durationMs = nsToMs(frameTimeNs - _lastFrameNs);
+  if (durationMs <= 0.0) {
+    return;
+  }
+  if (durationMs > MAX_FRAME_GAP_MS) {
+    restart(frameTimeNs);
+    _lastTargetNs = targetFrameTimeNs;
+    return;
+  }
+
+  // The budget of this frame is known exactly when the previous callback reported its target
+  const double frameIntervalMs = _lastTargetNs > _lastFrameNs
+    ? nsToMs(_lastTargetNs - _lastFrameNs)
+    : RuntimeBridgeState::get().getFrameIntervalMs();
+  double recentFrameMs = frameIntervalMs;
+  if (_recentCount > 0) {
+    double sum = 0.0;
+    for (uint32_t i = 0; i < _recentCount; i++) {
+      sum += _recentFrameMs[i];
+    }
+    recentFrameMs = sum / _recentCount;
+  }
+
+  const UiFrameClass frameClass = classify(durationMs, recentFrameMs, frameIntervalMs);
+  _classCounts[static_cast<size_t>(frameClass)]++;
+  _windowFrames++;
+  _windowDroppedFrames += droppedFrames(durationMs, frameIntervalMs);
+  _windowMaxFrameMs = std::max(_windowMaxFrameMs, durationMs);
+  MetricHistograms::get().record(HistogramMetric::UiFrameTime, durationMs);
+  SessionRecorder::get().record(SessionRecordType::UiFrame, frameTimeNs, durationMs);
+
+  _recentFrameMs[_recentIndex] = durationMs;
+  _recentIndex = (_recentIndex + 1) % RECENT_FRAMES;
+  _recentCount = std::min(_recentCount + 1, RECENT_FRAMES);
+  _lastFrameNs = frameTimeNs;
+  _lastTargetNs = targetFrameTimeNs;
+
+  if (frameTimeNs - _windowStartNs >= static_cast<int64_t>(windowMs) * 1'000'000) {
+    publishWindow(frameTimeNs, frameIntervalMs);
+  }
+}
+
+void UiFrameAnalyzer::restart(int64_t frameTimeNs) {
+  _lastFrameNs = frameTimeNs;
+  _recentCount = 0;
+  _recentIndex = 0;
+  _windowStartNs = frameTimeNs;
+  _windowFrames = 0;
+  _windowDroppedFrames = 0;
+  _windowMaxFrameMs = 0.0;
+}
+
+void UiFrameAnalyzer::publishWindow(int64_t frameTimeNs, double frameIntervalMs) {
+  const double fps = static_cast<double>(_windowFrames) * 1e9 / static_cast<double>(frameTimeNs - _windowStartNs);
+  const double cappedFps = std::min(std::round(fps), std::round(1000.0 / frameIntervalMs));
+  _uiFpsCell = static_cast<int32_t>(cappedFps);
+
+  MetricHistograms::get().record(HistogramMetric::UiFps, cappedFps);
+
+  const uint32_t sequence = _windowSequence.load(std::memory_order_relaxed);
+  _windowSequence.store(sequence + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  _windowValues[PublishedFps].store(cappedFps, std::memory_order_relaxed);
+  _windowValues[PublishedDroppedFrames].store(static_cast<double>(_windowDroppedFrames), std::memory_order_relaxed);
+  _windowValues[PublishedMaxFrameTimeMs].store(_windowMaxFrameMs, std::memory_order_relaxed);
+  _windowValues[PublishedStutterCount].store(static_cast<double>(_classCounts[static_cast<size_t>(UiFrameClass::Stutter)]), std::memory_order_relaxed);
+  _windowValues[PublishedJankCount].store(static_cast<double>(_classCounts[static_cast<size_t>(UiFrameClass::Jank)]), std::memory_order_relaxed);
+  _windowValues[PublishedBigJankCount].store(static_cast<double>(_classCounts[static_cast<size_t>(UiFrameClass::BigJank)]), std::memory_order_relaxed);
+  _windowValues[PublishedFrozenFrameCount].store(static_cast<double>(_classCounts[static_cast<size_t>(UiFrameClass::Frozen)]), std::memory_order_relaxed);
+  _windowSequence.store(sequence + 2, std::memory_order_release);
+
+  // Only a publisher that went idle has to be scheduled again, which is the one locking call
+  if (!_publisherRunning.exchange(true, std::memory_order_acq_rel)) {
+    TrackerScheduler::get().schedule(std::chrono::milliseconds(0), [this]() { return runPublisher(); }, std::chrono::milliseconds(SamplerRates::GRID_MS));
+  }
+
+  _windowStartNs = frameTimeNs;
+  _windowFrames = 0;
+  _windowDroppedFrames = 0;
+  _windowMaxFrameMs = 0.0;
+}
+
+std::optional<TrackerScheduler::Clock::duration> UiFrameAnalyzer::runPublisher() {
+  const auto step = std::chrono::milliseconds(SamplerRates::GRID_MS);
+  const int64_t nowNs = std::chrono::duration_cast<std::chrono::nanoseconds>(TrackerScheduler::get().now().time_since_epoch()).count();
+
+  std::array<double, PublishedValueCount> values{};
+  uint32_t sequence = 0;
+  for (;;) {
+    sequence = _windowSequence.load(std::memory_order_acquire);
+    if (sequence == _publishedSequence) {
+      break;
+    }
+    for (size_t i = 0; i < PublishedValueCount; i++) {
+      values[i] = _windowValues[i].load(std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if ((sequence & 1) == 0 && _windowSequence.load(std::memory_order_relaxed) == sequence) {
+      break;
+    }
+  }
+
+  if (sequence != _publishedSequence) {
+    _publishedSequence = sequence;
+    _lastWindowSeenNs = nowNs;
+    MetricsBlock::get().publish({
+      {MetricSlot::UiFps, values[PublishedFps]},
+      {MetricSlot::UiDroppedFrames, values[PublishedDroppedFrames]},
+      {MetricSlot::UiMaxFrameTimeMs, values[PublishedMaxFrameTimeMs]},
+      {MetricSlot::UiStutterCount, values[PublishedStutterCount]},
+      {MetricSlot::UiJankCount, values[PublishedJankCount]},
+      {MetricSlot::UiBigJankCount, values[PublishedBigJankCount]},
+      {MetricSlot::UiFrozenFrameCount, values[PublishedFrozenFrameCount]},
+    });
+    return step;
+  }
+
+  const int64_t idleNs = static_cast<int64_t>(std::max(_windowMs.load(std::memory_order_relaxed), SamplerRates::GRID_MS)) * PUBLISHER_IDLE_WINDOWS * 1'000'000;
+  if (nowNs - _lastWindowSeenNs < idleNs) {
+    return step;
+  }
+  // Frames stopped: go idle, unless a window was handed over meanwhile without restarting the task
+  _publisherRunning.store(false);
+  if (_windowSequence.load() != _publishedSequence && !_publisherRunning.exchange(true)) {
+    return step;
+  }
+  return std::nullopt;
+}
+
+} // namespace margelo::nitro::performancetoolkit
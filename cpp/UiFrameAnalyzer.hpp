@@ -0,0 +1,113 @@
+#pragma once
+
+#include "TrackerScheduler.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+namespace margelo::nitro::performancetoolkit {
+
+// Severity of a single UI frame, a frame only counts towards its most severe class
+enum class UiFrameClass : uint32_t {
+  Smooth = 0,
+  Stutter, // 4+ refresh intervals missed
+  Jank,    // Over twice the recent frame time and longer than two film frames (83.3 ms)
+  BigJank, // Same as Jank but longer than three film frames (125 ms)
+  Frozen,  // Longer than 700 ms
+};
+
+// Shared UI frame analysis, both platforms forward raw frame timestamps (Choreographer.doFrame on
+// Android, CADisplayLink on iOS) so UI FPS and jank are computed the same way everywhere.
+//
+// Runs on the UI thread and takes no locks on the per-frame path. Every frame is classified,
+// its duration goes to the frame time histogram, and once per window (WINDOW_MS unless changed
+// with setWindowMs) the UI FPS, the dropped frames of the window, the worst frame time and the
+// running class totals are handed to a TrackerScheduler task through a seqlock. That task
+// publishes them to the metrics block on the sampler grid (so subscriptions and alert rules never
+// run on the UI thread), and stops once windows stop coming until the next one is handed over.
+// Windows shorter than the grid step can replace each other before they are published.
+// Jank / BigJank follow PerfDog's definition, relative to the recent frame time so a game-like
+// steady 30 FPS isn't reported as jank, Stutter keeps the Android tracker's "four plus frames"
+// notion relative to the current refresh rate.
+class UiFrameAnalyzer {
+public:
+  static constexpr uint32_t WINDOW_MS = 500; // Default window
+  static constexpr uint32_t STUTTER_DROPPED_FRAMES = 4;
+  static constexpr double JANK_MIN_MS = 1000.0 / 24.0 * 2.0;
+  static constexpr double BIG_JANK_MIN_MS = 1000.0 / 24.0 * 3.0;
+  static constexpr double FROZEN_MIN_MS = 700.0;
+  // Longer gaps mean the frame source was paused (app in background), not a frozen UI
+  static constexpr double MAX_FRAME_GAP_MS = 5000.0;
+
+  static UiFrameAnalyzer& get();
+
+  // Called by the platform frame callback on the UI thread. `targetFrameTimeNs` is when the
+  // next frame is expected (CADisplayLink.targetTimestamp), 0 to derive it from the refresh rate
+  void onFrame(int64_t frameTimeNs, int64_t targetFrameTimeNs);
+
+  // Takes effect from the next frame, 0 pauses the analysis (frames are dropped right away) and
+  // the first frame after resuming starts a new window
+  void setWindowMs(uint32_t windowMs);
+  uint32_t getWindowMs() const;
+
+  // Classifies a frame of `durationMs`, `recentFrameMs` is the average of the previous frames
+  static UiFrameClass classify(double durationMs, double recentFrameMs, double frameIntervalMs);
+  // Refresh intervals the frame missed, 0 for a frame that made its deadline
+  static uint32_t droppedFrames(double durationMs, double frameIntervalMs);
+
+  // UI FPS of the last window as int32, the legacy 4 byte buffer layout
+  int32_t* getUiFpsCell() {
+    return &_uiFpsCell;
+  }
+
+private:
+  UiFrameAnalyzer() = default;
+
+  static constexpr uint32_t RECENT_FRAMES = 3;
+  static constexpr uint32_t PUBLISHER_IDLE_WINDOWS = 2; // Windows without a new one before the publisher stops
+
+  // Window results in the order they are handed to the publisher
+  enum PublishedValue : size_t {
+    PublishedFps = 0,
+    PublishedDroppedFrames,
+    PublishedMaxFrameTimeMs,
+    PublishedStutterCount,
+    PublishedJankCount,
+    PublishedBigJankCount,
+    PublishedFrozenFrameCount,
+    PublishedValueCount,
+  };
+
+  void restart(int64_t frameTimeNs);
+  void publishWindow(int64_t frameTimeNs, double frameIntervalMs);
+  // Scheduler thread, publishes the last handed over window if it wasn't yet
+  std::optional<TrackerScheduler::Clock::duration> runPublisher();
+
+  std::atomic<uint32_t> _windowMs{WINDOW_MS};
+
+  int64_t _lastFrameNs = 0;
+  int64_t _lastTargetNs = 0;
+  std::array<double, RECENT_FRAMES> _recentFrameMs{};
+  uint32_t _recentCount = 0;
+  uint32_t _recentIndex = 0;
+
+  int64_t _windowStartNs = 0;
+  uint32_t _windowFrames = 0;
+  uint32_t _windowDroppedFrames = 0;
+  double _windowMaxFrameMs = 0.0;
+  std::array<uint64_t, static_cast<size_t>(UiFrameClass::Frozen) + 1> _classCounts{};
+
+  alignas(4) int32_t _uiFpsCell = 0;
+
+  // Handed from the UI thread (single writer) to the publisher task, odd sequence while written
+  std::atomic<uint32_t> _windowSequence{0};
+  std::array<std::atomic<double>, PublishedValueCount> _windowValues{};
+  std::atomic<bool> _publisherRunning{false};
+  uint32_t _publishedSequence = 0; // Publisher task only
+  int64_t _lastWindowSeenNs = 0;   // Publisher task only
+};
+
+} // namespace margelo::nitro::performancetoolkit
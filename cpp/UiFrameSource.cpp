@@ -0,0 +1,59 @@
+#include "UiFrameSource.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+namespace margelo::nitro::performancetoolkit {
+
+UiFrameSource& UiFrameSource::get() {
+  static UiFrameSource instance;
+  return instance;
+}
+
+UiFrameSource::ListenerId UiFrameSource::addListener(Listener listener) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  const ListenerId id = _nextListenerId++;
+  auto listeners = std::make_shared<std::vector<Entry>>(*_listeners);
+  listeners->push_back(Entry{id, std::make_shared<Listener>(std::move(listener))});
+  _listeners = std::move(listeners);
+  _listenersVersion.fetch_add(1, std::memory_order_release);
+  return id;
+}
+
+void UiFrameSource::removeListener(ListenerId id) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  auto listeners = std::make_shared<std::vector<Entry>>(*_listeners);
+  listeners->erase(
+    std::remove_if(listeners->begin(), listeners->end(), [id](const Entry& entry) { return entry.id == id; }),
+    listeners->end()
+  );
+  _listeners = std::move(listeners);
+  _listenersVersion.fetch_add(1, std::memory_order_release);
+}
+
+void UiFrameSource::onFrame(int64_t frameTimeNs) {
+  const auto now = std::chrono::steady_clock::now();
+  _lastFrameNs.store(std::chrono::duration_cast<std::chrono::nanoseconds>(now.time_since_epoch()).count());
+  _uiThreadId.store(std::this_thread::get_id(), std::memory_order_relaxed);
+
+  const uint64_t version = _listenersVersion.load(std::memory_order_acquire);
+  if (_deliveredListeners == nullptr || version != _deliveredVersion) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _deliveredListeners = _listeners;
+    _deliveredVersion = version;
+  }
+  // Removing a listener while invoked only replaces _listeners, the delivered list stays intact
+  for (const auto& entry : *_deliveredListeners) {
+    (*entry.listener)(frameTimeNs);
+  }
+}
+
+int64_t UiFrameSource::getLastFrameNs() const {
+  return _lastFrameNs.load();
+}
+
+bool UiFrameSource::isUiThread() const {
+  return _uiThreadId.load(std::memory_order_relaxed) == std::this_thread::get_id();
+}
+
+} // namespace margelo::nitro::performancetoolkit
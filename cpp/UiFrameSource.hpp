@@ -0,0 +1,60 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace margelo::nitro::performancetoolkit {
+
+// Fan-out of native UI frame callbacks (Choreographer on Android, CADisplayLink on iOS)
+// to C++ consumers. Frames are only delivered while the platform UI FPS tracking is running.
+//
+// Listeners are invoked on the UI thread and must stay cheap. The listener list is copy-on-write,
+// so delivering a frame never allocates and listeners may remove themselves while being invoked.
+// The delivering thread keeps its own reference to the current list and only takes the mutex to
+// pick up a new one after a listener was added or removed, a steady frame takes no lock.
+class UiFrameSource {
+public:
+  using ListenerId = uint64_t;
+  using Listener = std::function<void(int64_t frameTimeNs)>;
+
+  static UiFrameSource& get();
+
+  ListenerId addListener(Listener listener);
+  void removeListener(ListenerId id);
+
+  // Called by the platform frame callback on the UI thread, by one thread at a time
+  void onFrame(int64_t frameTimeNs);
+
+  // Steady clock time of the last delivered frame in ns, 0 if no frame was ever delivered
+  int64_t getLastFrameNs() const;
+
+  // Whether the caller runs on the thread frames are delivered on, false before the first frame
+  bool isUiThread() const;
+
+private:
+  UiFrameSource() = default;
+
+  struct Entry {
+    ListenerId id;
+    std::shared_ptr<Listener> listener;
+  };
+
+  std::mutex _mutex;
+  std::shared_ptr<const std::vector<Entry>> _listeners = std::make_shared<const std::vector<Entry>>();
+  ListenerId _nextListenerId = 1;
+  std::atomic<uint64_t> _listenersVersion{0}; // Bumped after every change of _listeners
+
+  // Delivering thread only
+  std::shared_ptr<const std::vector<Entry>> _deliveredListeners;
+  uint64_t _deliveredVersion = 0;
+
+  std::atomic<int64_t> _lastFrameNs{0};
+  std::atomic<std::thread::id> _uiThreadId{};
+};
+
+} // namespace margelo::nitro::performancetoolkit
@@ -0,0 +1,167 @@
+#include "UiThreadExecutor.hpp"
+#include "RuntimeBridge.hpp"
+#include "ToolkitOverhead.hpp"
+#include "UiFrameSource.hpp"
+
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace margelo::nitro::performancetoolkit {
+
+namespace {
+
+// Global of the UI runtime holding the native state that ties the executor to the runtime
+constexpr const char* RUNTIME_GUARD_PROPERTY = "__performanceToolkitUiExecutor";
+
+class TaskQueue {
+public:
+  using Task = std::function<void(jsi::Runtime&)>;
+
+  explicit TaskQueue(jsi::Runtime& runtime) : _runtime(&runtime) {}
+
+  ~TaskQueue() {
+    if (_listener != 0) {
+      UiFrameSource::get().removeListener(_listener);
+    }
+  }
+
+  void attach(const std::shared_ptr<TaskQueue>& self) {
+    std::weak_ptr<TaskQueue> weakSelf = self;
+    _listener = UiFrameSource::get().addListener([weakSelf](int64_t) {
+      if (auto queue = weakSelf.lock()) {
+        queue->runPending();
+      }
+    });
+  }
+
+  void post(Task&& task) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_runtime != nullptr) {
+      _pending.push_back(std::move(task));
+    }
+  }
+
+  // UI thread only, the runtime is being torn down. Tasks posted after this are dropped
+  void invalidate() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _runtime = nullptr;
+    _pending.clear();
+  }
+
+private:
+  // UI thread only
+  void runPending() {
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      if (_pending.empty() || _runtime == nullptr) {
+        return;
+      }
+      std::swap(_pending, _running); // Both keep their capacity, steady state doesn't allocate
+    }
+    // Only the UI thread clears _runtime, so it stays valid until this returns
+    jsi::Runtime& runtime = *_runtime;
+    ToolkitOverhead::get().addJsiCalls();
+    jsi::Value requestAnimationFrame = runtime.global().getProperty(runtime, "requestAnimationFrame");
+    if (!requestAnimationFrame.isObject() || !requestAnimationFrame.getObject(runtime).isFunction(runtime)) {
+      for (auto& task : _running) {
+        task(runtime);
+      }
+      _running.clear();
+      return;
+    }
+    // The callback gets the runtime it runs on, so a batch still queued when the runtime is torn
+    // down is released with it without ever touching _runtime
+    auto batch = std::make_shared<std::vector<Task>>(std::move(_running));
+    _running.clear();
+    auto callback = jsi::Function::createFromHostFunction(
+      runtime, jsi::PropNameID::forAscii(runtime, "runPerformanceToolkitTasks"), 1,
+      [batch](jsi::Runtime& callbackRuntime, const jsi::Value&, const jsi::Value*, size_t) {
+        // The tasks' own timers are nested in this one, it adds the hand-over on top of them
+        ToolkitOverhead::ScopedTimer timer(ToolkitOverhead::TimedWork::JsTask);
+        for (auto& task : *batch) {
+          task(callbackRuntime);
+        }
+        batch->clear();
+        return jsi::Value::undefined();
+      });
+    ToolkitOverhead::get().addJsiCalls(2); // createFromHostFunction and the call
+    requestAnimationFrame.getObject(runtime).asFunction(runtime).call(runtime, std::move(callback));
+  }
+
+  jsi::Runtime* _runtime; // Cleared on the UI thread when the runtime is torn down
+  std::mutex _mutex;
+  std::vector<Task> _pending;
+  std::vector<Task> _running;
+  UiFrameSource::ListenerId _listener = 0;
+};
+
+// Lives on the runtime's global object, released when the runtime is torn down
+class RuntimeGuard : public jsi::NativeState {
+public:
+  RuntimeGuard(std::shared_ptr<TaskQueue> queue, std::string name) : _queue(std::move(queue)), _name(std::move(name)) {}
+
+  ~RuntimeGuard() override {
+    _queue->invalidate();
+    if (_registrationId != 0) {
+      RuntimeBridgeState::get().unregisterRuntime(_name, _registrationId);
+    }
+  }
+
+  void setRegistrationId(uint64_t registrationId) {
+    _registrationId = registrationId;
+  }
+
+  const std::string& name() const {
+    return _name;
+  }
+
+  uint64_t registrationId() const {
+    return _registrationId;
+  }
+
+private:
+  std::shared_ptr<TaskQueue> _queue;
+  std::string _name;
+  uint64_t _registrationId = 0;
+};
+
+} // namespace
+
+uint64_t UiThreadExecutor::registerRuntime(jsi::Runtime& runtime, const std::string& name) {
+  // Registering again while this runtime's registration is still current keeps it, so FPS tracking
+  // and the UI counters can both register without replacing each other's executor
+  ToolkitOverhead::get().addJsiCalls();
+  jsi::Value existing = runtime.global().getProperty(runtime, RUNTIME_GUARD_PROPERTY);
+  if (existing.isObject()) {
+    jsi::Object existingObject = existing.getObject(runtime);
+    ToolkitOverhead::get().addJsiCalls();
+    if (existingObject.hasNativeState<RuntimeGuard>(runtime)) {
+      ToolkitOverhead::get().addJsiCalls();
+      auto existingGuard = existingObject.getNativeState<RuntimeGuard>(runtime);
+      const uint64_t registrationId = existingGuard->registrationId();
+      if (registrationId != 0 && existingGuard->name() == name && RuntimeBridgeState::get().getRegistrationId(name) == registrationId) {
+        return registrationId;
+      }
+    }
+  }
+
+  auto queue = std::make_shared<TaskQueue>(runtime);
+  queue->attach(queue);
+  // Installed before registering, replacing the guard of an earlier, retired registration on this runtime.
+  // That one unregisters by its own id, which by then is no longer current
+  auto guard = std::make_shared<RuntimeGuard>(queue, name);
+  jsi::Object guardObject(runtime);
+  guardObject.setNativeState(runtime, guard);
+  runtime.global().setProperty(runtime, RUNTIME_GUARD_PROPERTY, guardObject);
+  ToolkitOverhead::get().addJsiCalls(3); // Creating the guard object, its native state and the property
+
+  const uint64_t registrationId = RuntimeBridgeState::get().registerRuntime(name, [queue](std::function<void(jsi::Runtime&)>&& task) {
+    queue->post(std::move(task));
+  });
+  guard->setRegistrationId(registrationId);
+  return registrationId;
+}
+
+} // namespace margelo::nitro::performancetoolkit
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <ReactCommon/RuntimeExecutor.h>
+#include <jsi/jsi.h>
+
+#include <cstdint>
+#include <string>
+
+namespace margelo::nitro::performancetoolkit {
+
+using namespace facebook;
+using namespace facebook::react;
+
+// RuntimeExecutor for a JS runtime that lives on the UI thread (the worklets UI runtime).
+//
+// Shared C++ has no portable way to post to the UI thread, but the native UI frame callback
+// (UiFrameSource) already runs there every vsync, so tasks are queued and handed over from the
+// next frame. They are handed to the runtime's own `requestAnimationFrame`, so they run in the
+// worklet runtime's frame flush, behind the mappers and animations queued there: a tracker sees
+// the worklet runtime's backlog, not the native frame callback's timing. Runtimes without
+// `requestAnimationFrame` run tasks from the frame callback. Tasks only run while UI frames are
+// delivered (UI FPS tracking running).
+class UiThreadExecutor {
+public:
+  // Registers `runtime` as `name` with RuntimeBridgeState and returns the registrationId. Must be
+  // called on the UI thread. The executor is tied to the runtime through a native state on its
+  // global object: when the runtime is torn down the executor drops its tasks and stops using the
+  // runtime, and the registration is unregistered unless it was replaced in the meantime. While
+  // this runtime's registration under `name` is still current, that one is returned instead
+  static uint64_t registerRuntime(jsi::Runtime& runtime, const std::string& name);
+};
+
+} // namespace margelo::nitro::performancetoolkit
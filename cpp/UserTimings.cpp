@@ -0,0 +1,132 @@
+#include "UserTimings.hpp"
+#include "SessionRecorder.hpp"
+
+#include <chrono>
+
+namespace margelo::nitro::performancetoolkit {
+
+static int64_t nowNs() {
+  const auto now = std::chrono::steady_clock::now().time_since_epoch();
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+}
+
+UserTimings& UserTimings::get() {
+  static UserTimings instance;
+  return instance;
+}
+
+uint32_t UserTimings::intern(const std::string& name) {
+  const std::string key = name.size() > MAX_NAME_LENGTH ? name.substr(0, MAX_NAME_LENGTH) : name;
+  std::lock_guard<std::mutex> lock(_namesMutex);
+  const auto existing = _ids.find(key);
+  if (existing != _ids.end()) {
+    return existing->second;
+  }
+  _names.push_back(key);
+  const auto id = static_cast<uint32_t>(_names.size());
+  _ids.emplace(key, id);
+  return id;
+}
+
+void UserTimings::forEachNameAfter(uint32_t knownCount, const std::function<void(uint32_t id, const std::string& name)>& callback) {
+  std::lock_guard<std::mutex> lock(_namesMutex);
+  for (auto id = static_cast<size_t>(knownCount) + 1; id <= _names.size(); id++) {
+    callback(static_cast<uint32_t>(id), _names[id - 1]);
+  }
+}
+
+UserTimings::ThreadBuffer*& UserTimings::currentThreadBuffer() {
+  thread_local ThreadBuffer* buffer = nullptr;
+  return buffer;
+}
+
+UserTimings::ThreadBuffer& UserTimings::threadBuffer() {
+  // Buffers are never freed, a thread that exits leaves its (drained) ring behind
+  ThreadBuffer*& buffer = currentThreadBuffer();
+  if (buffer == nullptr) {
+    std::lock_guard<std::mutex> lock(_buffersMutex);
+    _buffers.push_back(std::make_unique<ThreadBuffer>());
+    buffer = _buffers.back().get();
+    buffer->thread = static_cast<uint32_t>(_buffers.size() - 1);
+  }
+  return *buffer;
+}
+
+void UserTimings::push(ThreadBuffer& buffer, const UserTimingEvent& event) {
+  const uint64_t writeIndex = buffer.writeIndex.load(std::memory_order_relaxed);
+  if (writeIndex - buffer.readIndex.load(std::memory_order_acquire) >= RING_CAPACITY) {
+    _dropped.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  buffer.ring[writeIndex & (RING_CAPACITY - 1)] = event;
+  buffer.writeIndex.store(writeIndex + 1, std::memory_order_release);
+}
+
+void UserTimings::mark(uint32_t nameId) {
+  if (!SessionRecorder::get().isRecording()) {
+    return;
+  }
+  ThreadBuffer& buffer = threadBuffer();
+  push(buffer, UserTimingEvent{UserTimingKind::Mark, buffer.thread, nameId, nowNs(), 0});
+}
+
+void UserTimings::beginSpan(uint32_t nameId) {
+  if (!SessionRecorder::get().isRecording()) {
+    return;
+  }
+  ThreadBuffer& buffer = threadBuffer();
+  if (buffer.openSpanCount == MAX_OPEN_SPANS) {
+    // Most likely spans that were never ended, make room by dropping the oldest
+    for (uint32_t i = 1; i < MAX_OPEN_SPANS; i++) {
+      buffer.openSpans[i - 1] = buffer.openSpans[i];
+    }
+    buffer.openSpanCount--;
+  }
+  buffer.openSpans[buffer.openSpanCount++] = OpenSpan{nameId, nowNs()};
+}
+
+void UserTimings::endSpan(uint32_t nameId) {
+  // Spans are only opened while recording, a thread without a buffer never opened one
+  ThreadBuffer* current = currentThreadBuffer();
+  if (current == nullptr) {
+    return;
+  }
+  const int64_t endNs = nowNs();
+  ThreadBuffer& buffer = *current;
+  for (uint32_t i = buffer.openSpanCount; i > 0; i--) {
+    if (buffer.openSpans[i - 1].nameId != nameId) {
+      continue;
+    }
+    const OpenSpan span = buffer.openSpans[i - 1];
+    for (uint32_t j = i; j < buffer.openSpanCount; j++) {
+      buffer.openSpans[j - 1] = buffer.openSpans[j];
+    }
+    buffer.openSpanCount--;
+    // A span that outlived the session is still popped, only emitted while recording
+    if (SessionRecorder::get().isRecording()) {
+      push(buffer, UserTimingEvent{UserTimingKind::Span, buffer.thread, nameId, span.beginNs, endNs - span.beginNs});
+    }
+    return;
+  }
+}
+
+void UserTimings::drain(const std::function<void(const UserTimingEvent& event)>& callback) {
+  std::lock_guard<std::mutex> lock(_buffersMutex);
+  for (const auto& buffer : _buffers) {
+    const uint64_t writeIndex = buffer->writeIndex.load(std::memory_order_acquire);
+    uint64_t readIndex = buffer->readIndex.load(std::memory_order_relaxed);
+    for (; readIndex < writeIndex; readIndex++) {
+      callback(buffer->ring[readIndex & (RING_CAPACITY - 1)]);
+    }
+    buffer->readIndex.store(readIndex, std::memory_order_release);
+  }
+}
+
+void UserTimings::discard() {
+  std::lock_guard<std::mutex> lock(_buffersMutex);
+  for (const auto& buffer : _buffers) {
+    buffer->readIndex.store(buffer->writeIndex.load(std::memory_order_acquire), std::memory_order_release);
+  }
+}
+
+} // namespace margelo::nitro::performancetoolkit
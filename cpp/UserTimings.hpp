@@ -0,0 +1,98 @@
+#pragma once
+
+#include "SessionFormat.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace margelo::nitro::performancetoolkit {
+
+enum class UserTimingKind : uint8_t {
+  Mark = 0,
+  Span,
+};
+
+struct UserTimingEvent {
+  UserTimingKind kind;
+  uint32_t thread;     // Index of the producing thread, in order of their first event
+  uint32_t nameId;     // From `intern`
+  int64_t timeNs;      // Steady clock, when the mark was set / the span began
+  int64_t durationNs;  // 0 for marks
+};
+
+// User marks and spans, recorded into the running session next to the built-in samples.
+//
+// Names are interned once (`intern`, takes a lock and copies the string), the hot path only
+// passes the returned id. Every producing thread owns a single-producer ring, so `mark` /
+// `beginSpan` / `endSpan` never lock, allocate or contend with other threads, and cost a single
+// atomic load while no session is recording. Open spans live in a per-thread stack, a span is
+// emitted as one event when it ends.
+class UserTimings {
+public:
+  static constexpr uint32_t RING_CAPACITY = 1024; // Per thread, power of two
+  static constexpr uint32_t MAX_OPEN_SPANS = 64;  // Per thread, the oldest open span is dropped beyond that
+  static constexpr size_t MAX_NAME_LENGTH = SESSION_MAX_NAME_LENGTH; // Longer names are truncated
+
+  static UserTimings& get();
+
+  // Returns the id of `name`, the same name always maps to the same id (ids start at 1)
+  uint32_t intern(const std::string& name);
+  // Names with id > `knownCount`, in id order
+  void forEachNameAfter(uint32_t knownCount, const std::function<void(uint32_t id, const std::string& name)>& callback);
+
+  void mark(uint32_t nameId);
+  void beginSpan(uint32_t nameId);
+  // Ends the innermost open span with `nameId` on this thread, ignored if there is none
+  void endSpan(uint32_t nameId);
+
+  // Called by the session writer, hands over every event recorded since the last drain
+  void drain(const std::function<void(const UserTimingEvent& event)>& callback);
+  // Drops recorded events, called when a session starts
+  void discard();
+
+  // Events lost because a thread's ring was full
+  uint64_t getDroppedCount() const {
+    return _dropped.load(std::memory_order_relaxed);
+  }
+
+private:
+  UserTimings() = default;
+
+  struct OpenSpan {
+    uint32_t nameId;
+    int64_t beginNs;
+  };
+
+  struct ThreadBuffer {
+    uint32_t thread = 0;
+    std::array<UserTimingEvent, RING_CAPACITY> ring{};
+    alignas(64) std::atomic<uint64_t> writeIndex{0};
+    alignas(64) std::atomic<uint64_t> readIndex{0};
+    // Producer-only state
+    std::array<OpenSpan, MAX_OPEN_SPANS> openSpans{};
+    uint32_t openSpanCount = 0;
+  };
+
+  // This thread's buffer, nullptr until it recorded its first event
+  static ThreadBuffer*& currentThreadBuffer();
+  // This thread's buffer, created on first use
+  ThreadBuffer& threadBuffer();
+  void push(ThreadBuffer& buffer, const UserTimingEvent& event);
+
+  std::mutex _namesMutex;
+  std::unordered_map<std::string, uint32_t> _ids;
+  std::vector<std::string> _names;
+
+  std::mutex _buffersMutex; // Taken when a thread records its first event and by the consumer
+  std::vector<std::unique_ptr<ThreadBuffer>> _buffers;
+  std::atomic<uint64_t> _dropped{0};
+};
+
+} // namespace margelo::nitro::performancetoolkit
@@ -0,0 +1,32 @@
+#include "AllocationCounter.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace margelo::nitro::performancetoolkit::testing {
+
+static std::atomic<uint64_t> allocations{0};
+
+uint64_t allocationCount() {
+  return allocations.load(std::memory_order_relaxed);
+}
+
+} // namespace margelo::nitro::performancetoolkit::testing
+
+// The aligned and nothrow forms forward to these in libstdc++ and libc++
+void* operator new(std::size_t size) {
+  margelo::nitro::performancetoolkit::testing::allocations.fetch_add(1, std::memory_order_relaxed);
+  if (void* pointer = std::malloc(size == 0 ? 1 : size)) {
+    return pointer;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept {
+  std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+  std::free(pointer);
+}
@@ -0,0 +1,11 @@
+#pragma once
+
+#include <cstdint>
+
+namespace margelo::nitro::performancetoolkit::testing {
+
+// Heap allocations made by the whole benchmark process so far (global operator new is replaced
+// in AllocationCounter.cpp). Benchmarks report the difference over what they measure.
+uint64_t allocationCount();
+
+} // namespace margelo::nitro::performancetoolkit::testing
@@ -0,0 +1,43 @@
+#include "LatencyHistogram.hpp"
+
+#include <benchmark/benchmark.h>
+
+using namespace margelo::nitro::performancetoolkit;
+
+// Recording runs on the measured threads for every tick and frame, so it has to stay a few ns
+
+static void BM_LatencyHistogramRecord(benchmark::State& state) {
+  static LatencyHistogram histogram;
+  uint32_t value = static_cast<uint32_t>(state.thread_index()) * 7919;
+  for (auto _ : state) {
+    histogram.record(value);
+    value = value * 1103515245u + 12345u; // Spread over every bucket
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_LatencyHistogramRecord)->ThreadRange(1, 4);
+
+// Typical latencies land in a handful of buckets, the contended case for the counters
+static void BM_LatencyHistogramRecordNarrow(benchmark::State& state) {
+  static LatencyHistogram histogram;
+  uint32_t value = 16000;
+  for (auto _ : state) {
+    histogram.record(value);
+    value = value >= 17000 ? 16000 : value + 13;
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_LatencyHistogramRecordNarrow)->ThreadRange(1, 4);
+
+static void BM_LatencyHistogramPercentile(benchmark::State& state) {
+  LatencyHistogram histogram;
+  for (uint32_t value = 0; value < 100000; value++) {
+    histogram.record(value * 37);
+  }
+  for (auto _ : state) {
+    HistogramSnapshot snapshot;
+    histogram.snapshotInto(snapshot);
+    benchmark::DoNotOptimize(snapshot.getValueAtPercentile(99.0));
+  }
+}
+BENCHMARK(BM_LatencyHistogramPercentile);
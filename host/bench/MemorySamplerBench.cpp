@@ -0,0 +1,89 @@
+#include "MemorySampler.hpp"
+
+#include <benchmark/benchmark.h>
+#include <cstring>
+#include <sstream>
+#include <string>
+
+using namespace margelo::nitro::performancetoolkit;
+
+namespace {
+
+constexpr const char* SMAPS_ROLLUP =
+  "12c00000-7fffd2c5f000 ---p 00000000 00:00 0                          [rollup]\n"
+  "Rss:              245312 kB\n"
+  "Pss:              131847 kB\n"
+  "Pss_Dirty:         98120 kB\n"
+  "Pss_Anon:          90536 kB\n"
+  "Pss_File:          33451 kB\n"
+  "Pss_Shmem:          7860 kB\n"
+  "Shared_Clean:     101956 kB\n"
+  "Shared_Dirty:      10916 kB\n"
+  "Private_Clean:     29048 kB\n"
+  "Private_Dirty:    103392 kB\n"
+  "Referenced:       232860 kB\n"
+  "Anonymous:         93440 kB\n"
+  "LazyFree:              0 kB\n"
+  "AnonHugePages:         0 kB\n"
+  "ShmemPmdMapped:        0 kB\n"
+  "FilePmdMapped:         0 kB\n"
+  "Shared_Hugetlb:        0 kB\n"
+  "Private_Hugetlb:       0 kB\n"
+  "Swap:              18204 kB\n"
+  "SwapPss:           17133 kB\n"
+  "Locked:                0 kB\n";
+
+// The straightforward parser the sampler replaced: a stream, a string per line and per key
+bool parseWithGetline(const std::string& data, MemorySampler::MemoryStats& out) {
+  std::istringstream stream(data);
+  std::string line;
+  bool found = false;
+  while (std::getline(stream, line)) {
+    const size_t colon = line.find(':');
+    if (colon == std::string::npos) {
+      continue;
+    }
+    const std::string key = line.substr(0, colon);
+    uint64_t* target = nullptr;
+    if (key == "Rss") {
+      target = &out.rssKb;
+    } else if (key == "Pss") {
+      target = &out.pssKb;
+    } else if (key == "Private_Dirty") {
+      target = &out.privateDirtyKb;
+    } else if (key == "Swap") {
+      target = &out.swapKb;
+    } else if (key == "Anonymous") {
+      target = &out.anonymousKb;
+    }
+    if (target != nullptr) {
+      *target = std::stoull(line.substr(colon + 1));
+      found = true;
+    }
+  }
+  return found;
+}
+
+} // namespace
+
+static void BM_ParseSmapsRollup(benchmark::State& state) {
+  const size_t length = std::strlen(SMAPS_ROLLUP);
+  for (auto _ : state) {
+    MemorySampler::MemoryStats stats;
+    benchmark::DoNotOptimize(MemorySampler::parseSmapsRollup(SMAPS_ROLLUP, length, stats));
+    benchmark::DoNotOptimize(stats);
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * length));
+}
+BENCHMARK(BM_ParseSmapsRollup);
+
+static void BM_ParseSmapsRollupWithGetline(benchmark::State& state) {
+  const std::string data(SMAPS_ROLLUP);
+  for (auto _ : state) {
+    MemorySampler::MemoryStats stats;
+    benchmark::DoNotOptimize(parseWithGetline(data, stats));
+    benchmark::DoNotOptimize(stats);
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * data.size()));
+}
+BENCHMARK(BM_ParseSmapsRollupWithGetline);
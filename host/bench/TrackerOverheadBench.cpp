@@ -0,0 +1,120 @@
+#include "AlertRules.hpp"
+#include "AllocationCounter.hpp"
+#include "FakeRuntimeExecutor.hpp"
+#include "JsFpsTracker.hpp"
+#include "JsFrameTimeline.hpp"
+#include "JsLagEvents.hpp"
+#include "MetricHistograms.hpp"
+#include "MetricsBlock.hpp"
+#include "RuntimeBridge.hpp"
+#include "UserTimings.hpp"
+
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace margelo::nitro::performancetoolkit;
+using namespace margelo::nitro::performancetoolkit::testing;
+using namespace std::chrono_literals;
+
+// What the tracker costs the thread it measures: JS thread time spent in probe tasks.
+// Runs the main runtime tracker (timeline, lag attribution, histograms) on the fake JS thread for
+// two report windows per iteration, arg 0 = idle thread, arg 1 = thread blocked half of the time.
+static void BM_JsFpsTrackerJsThreadCost(benchmark::State& state) {
+  const auto mode = static_cast<JsFpsTrackingMode>(state.range(0));
+  const bool loaded = state.range(1) != 0;
+  RuntimeBridgeState::get().setDeviceRefreshRate(60.0);
+
+  uint64_t probes = 0;
+  uint64_t allocations = 0;
+  double timeInProbesNs = 0.0;
+  std::atomic<int32_t> lastFps{0};
+  for (auto _ : state) {
+    FakeRuntimeExecutor js;
+    if (loaded) {
+      js.setLoad(100ms, 200ms);
+    }
+    auto tracker = std::make_shared<JsFpsTracker>(
+        [&lastFps](int32_t fps, int32_t, double) { lastFps = fps; },
+        std::make_shared<JsFrameTimeline>(),
+        std::make_shared<JsLagEvents>(),
+        nullptr,
+        js.executor(),
+        mode);
+    const auto startedAt = std::chrono::steady_clock::now();
+    const uint64_t allocationsAtStart = allocationCount();
+    tracker->start();
+    std::this_thread::sleep_for(2s);
+    tracker->stop();
+    allocations += allocationCount() - allocationsAtStart;
+    state.SetIterationTime(std::chrono::duration<double>(std::chrono::steady_clock::now() - startedAt).count());
+
+    probes += js.getTasksRun();
+    timeInProbesNs += static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(js.getTimeInTasks()).count());
+  }
+  state.counters["probes_per_s"] = benchmark::Counter(static_cast<double>(probes), benchmark::Counter::kIsRate);
+  state.counters["js_ns_per_probe"] = probes > 0 ? timeInProbesNs / static_cast<double>(probes) : 0.0;
+  // Whole process while tracking, so it includes posting through the executor like on a device
+  state.counters["allocs_per_probe"] = probes > 0 ? static_cast<double>(allocations) / static_cast<double>(probes) : 0.0;
+  // Share of the JS thread used by the tracker
+  state.counters["js_thread_share"] = benchmark::Counter(timeInProbesNs / 1e9, benchmark::Counter::kIsRate);
+  state.counters["last_fps"] = lastFps.load();
+}
+BENCHMARK(BM_JsFpsTrackerJsThreadCost)
+    ->ArgsProduct({{static_cast<int64_t>(JsFpsTrackingMode::CONTINUOUS), static_cast<int64_t>(JsFpsTrackingMode::ON_DEMAND)}, {0, 1}})
+    ->ArgNames({"mode", "loaded"})
+    ->Iterations(2)
+    ->UseManualTime()
+    ->Unit(benchmark::kMillisecond);
+
+// Hot paths that run on the measured threads
+
+static void BM_MetricsBlockPublish(benchmark::State& state) {
+  double value = 0.0;
+  for (auto _ : state) {
+    MetricsBlock::get().publish({
+      {MetricSlot::JsFps, value},
+      {MetricSlot::JsDroppedFrames, value},
+    });
+    value += 1.0;
+  }
+}
+BENCHMARK(BM_MetricsBlockPublish);
+
+static void BM_MetricHistogramsRecord(benchmark::State& state) {
+  double latencyMs = 0.0;
+  for (auto _ : state) {
+    MetricHistograms::get().record(HistogramMetric::JsLatency, latencyMs);
+    latencyMs = latencyMs > 100.0 ? 0.0 : latencyMs + 0.37;
+  }
+}
+BENCHMARK(BM_MetricHistogramsRecord);
+
+static void BM_UserTimingMarkWithoutSession(benchmark::State& state) {
+  const uint32_t nameId = UserTimings::get().intern("benchmark");
+  for (auto _ : state) {
+    UserTimings::get().mark(nameId);
+  }
+}
+BENCHMARK(BM_UserTimingMarkWithoutSession);
+
+static void BM_AlertRulesUnwatchedSlot(benchmark::State& state) {
+  const auto ruleId = AlertRules::get().add({MetricSlot::MemoryUsage, AlertRules::Condition::Above, 1e9, 0.0, 0}, [](const AlertRules::Firing&) {});
+  for (auto _ : state) {
+    AlertRules::get().onSamples({{MetricSlot::JsFps, 60.0}}, 0.0);
+  }
+  AlertRules::get().remove(ruleId);
+}
+BENCHMARK(BM_AlertRulesUnwatchedSlot);
+
+static void BM_AlertRulesWatchedSlot(benchmark::State& state) {
+  const auto ruleId = AlertRules::get().add({MetricSlot::JsFps, AlertRules::Condition::Below, 30.0, 3000.0, 0}, [](const AlertRules::Firing&) {});
+  double timeMs = 0.0;
+  for (auto _ : state) {
+    AlertRules::get().onSamples({{MetricSlot::JsFps, 60.0}}, timeMs);
+    timeMs += 1000.0;
+  }
+  AlertRules::get().remove(ruleId);
+}
+BENCHMARK(BM_AlertRulesWatchedSlot);
@@ -0,0 +1,55 @@
+#pragma once
+
+// Host build stand-in for Nitro's ArrayBuffer: owns (or wraps) a plain byte buffer, which is all
+// the shared C++ core uses it for. There is no JS side to hand it to on the host.
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <new>
+
+namespace margelo::nitro {
+
+class ArrayBuffer {
+public:
+  ArrayBuffer(uint8_t* data, size_t size, std::function<void()> deleteFunc)
+      : _data(data), _size(size), _deleteFunc(std::move(deleteFunc)) {}
+
+  ~ArrayBuffer() {
+    if (_deleteFunc) {
+      _deleteFunc();
+    }
+  }
+
+  ArrayBuffer(const ArrayBuffer&) = delete;
+  ArrayBuffer& operator=(const ArrayBuffer&) = delete;
+
+  static std::shared_ptr<ArrayBuffer> allocate(size_t size) {
+    auto* data = static_cast<uint8_t*>(std::calloc(size, 1));
+    if (data == nullptr) {
+      throw std::bad_alloc();
+    }
+    return std::make_shared<ArrayBuffer>(data, size, [data]() { std::free(data); });
+  }
+
+  static std::shared_ptr<ArrayBuffer> wrap(uint8_t* data, size_t size, std::function<void()>&& deleteFunc) {
+    return std::make_shared<ArrayBuffer>(data, size, std::move(deleteFunc));
+  }
+
+  uint8_t* data() {
+    return _data;
+  }
+
+  size_t size() const {
+    return _size;
+  }
+
+private:
+  uint8_t* _data;
+  size_t _size;
+  std::function<void()> _deleteFunc;
+};
+
+} // namespace margelo::nitro
@@ -0,0 +1,30 @@
+#pragma once
+
+// Host build stand-in: just enough of Nitro's JSIConverter for the generated enum headers to
+// compile. Nothing converts to or from JS on the host, so every conversion throws.
+
+#include <jsi/jsi.h>
+#include <stdexcept>
+#include <string>
+
+namespace margelo::nitro {
+
+using namespace facebook;
+
+template <typename T, typename Enable = void>
+struct JSIConverter;
+
+template <>
+struct JSIConverter<std::string> final {
+  static std::string fromJSI(jsi::Runtime&, const jsi::Value&) {
+    throw std::logic_error("JSI conversions are not available in the host build");
+  }
+  static jsi::Value toJSI(jsi::Runtime&, const std::string&) {
+    throw std::logic_error("JSI conversions are not available in the host build");
+  }
+  static bool canConvert(jsi::Runtime&, const jsi::Value&) {
+    return false;
+  }
+};
+
+} // namespace margelo::nitro
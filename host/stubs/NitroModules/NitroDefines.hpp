@@ -0,0 +1,7 @@
+#pragma once
+
+// Host build stand-in, the Swift interop annotations expand to nothing
+
+#define SWIFT_NAME(name)
+#define SWIFT_PRIVATE
+#define CLOSED_ENUM
@@ -0,0 +1,12 @@
+#pragma once
+
+// Host build stand-in, same signature as React Native's RuntimeExecutor
+
+#include <functional>
+#include <jsi/jsi.h>
+
+namespace facebook::react {
+
+using RuntimeExecutor = std::function<void(std::function<void(jsi::Runtime& runtime)>&& callback)>;
+
+} // namespace facebook::react
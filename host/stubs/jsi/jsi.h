@@ -0,0 +1,42 @@
+#pragma once
+
+// Host build stand-in for the parts of JSI the shared C++ core touches: a Runtime whose
+// instrumentation reports heap statistics (see host/testing/FakeRuntimeExecutor.hpp) and opaque
+// values for the generated converters.
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+namespace facebook::jsi {
+
+class Instrumentation {
+public:
+  virtual ~Instrumentation() = default;
+  virtual std::unordered_map<std::string, int64_t> getHeapInfo(bool includeExpensive) = 0;
+};
+
+class Runtime {
+public:
+  virtual ~Runtime() = default;
+  virtual Instrumentation& instrumentation() = 0;
+};
+
+class Value {
+public:
+  static Value undefined() {
+    return Value();
+  }
+
+  bool isString() const {
+    return false;
+  }
+};
+
+class JSError : public std::runtime_error {
+public:
+  JSError(Runtime&, std::string message) : std::runtime_error(std::move(message)) {}
+};
+
+} // namespace facebook::jsi
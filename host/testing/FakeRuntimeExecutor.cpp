@@ -0,0 +1,123 @@
+#include "FakeRuntimeExecutor.hpp"
+
+#include <algorithm>
+
+namespace margelo::nitro::performancetoolkit::testing {
+
+FakeRuntimeExecutor::FakeRuntimeExecutor() : _state(std::make_shared<State>()) {
+  _thread = std::thread([state = _state]() { run(state); });
+}
+
+FakeRuntimeExecutor::~FakeRuntimeExecutor() {
+  {
+    std::lock_guard<std::mutex> lock(_state->mutex);
+    _state->running = false;
+    _state->tasks.clear();
+  }
+  _state->wakeUp.notify_all();
+  _thread.join();
+}
+
+RuntimeExecutor FakeRuntimeExecutor::executor() {
+  std::weak_ptr<State> weakState = _state;
+  return [weakState](std::function<void(jsi::Runtime& runtime)>&& callback) {
+    if (auto state = weakState.lock()) {
+      state->post(std::move(callback), Clock::duration::zero());
+    }
+  };
+}
+
+void FakeRuntimeExecutor::State::post(std::function<void(jsi::Runtime& runtime)>&& callback, Clock::duration stall) {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!running) {
+      return;
+    }
+    tasks.push_back(Task{Clock::now() + latency, std::move(callback), stall});
+  }
+  wakeUp.notify_all();
+}
+
+void FakeRuntimeExecutor::setLatency(Clock::duration latency) {
+  std::lock_guard<std::mutex> lock(_state->mutex);
+  _state->latency = latency;
+}
+
+void FakeRuntimeExecutor::stall(Clock::duration duration) {
+  _state->post(nullptr, duration);
+}
+
+void FakeRuntimeExecutor::setLoad(Clock::duration busy, Clock::duration period) {
+  {
+    std::lock_guard<std::mutex> lock(_state->mutex);
+    _state->loadBusy = std::min(busy, period);
+    _state->loadPeriod = period;
+    _state->nextLoadAt = Clock::now();
+  }
+  _state->wakeUp.notify_all();
+}
+
+FakeRuntime& FakeRuntimeExecutor::runtime() {
+  return _state->runtime;
+}
+
+uint64_t FakeRuntimeExecutor::getTasksRun() const {
+  return _state->tasksRun.load(std::memory_order_relaxed);
+}
+
+FakeRuntimeExecutor::Clock::duration FakeRuntimeExecutor::getTimeInTasks() const {
+  return std::chrono::nanoseconds(_state->timeInTasksNs.load(std::memory_order_relaxed));
+}
+
+void FakeRuntimeExecutor::run(const std::shared_ptr<State>& state) {
+  std::unique_lock<std::mutex> lock(state->mutex);
+  while (state->running) {
+    const auto now = Clock::now();
+    const bool loadEnabled = state->loadPeriod > Clock::duration::zero();
+
+    // Steady load first, it models work that was already queued on the thread
+    if (loadEnabled && now >= state->nextLoadAt) {
+      const auto busy = state->loadBusy;
+      while (state->nextLoadAt <= now) {
+        state->nextLoadAt += state->loadPeriod;
+      }
+      lock.unlock();
+      std::this_thread::sleep_for(busy);
+      lock.lock();
+      continue;
+    }
+
+    if (!state->tasks.empty() && state->tasks.front().readyAt <= now) {
+      Task task = std::move(state->tasks.front());
+      state->tasks.pop_front();
+      lock.unlock();
+      if (task.callback) {
+        const auto startedAt = Clock::now();
+        task.callback(state->runtime);
+        const auto ranFor = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - startedAt);
+        state->timeInTasksNs.fetch_add(ranFor.count(), std::memory_order_relaxed);
+        state->tasksRun.fetch_add(1, std::memory_order_relaxed);
+      } else {
+        std::this_thread::sleep_for(task.stall);
+      }
+      lock.lock();
+      continue;
+    }
+
+    // Copy the deadlines, the queue and load settings may change while waiting
+    auto wakeAt = Clock::time_point::max();
+    if (!state->tasks.empty()) {
+      wakeAt = state->tasks.front().readyAt;
+    }
+    if (loadEnabled) {
+      wakeAt = std::min(wakeAt, state->nextLoadAt);
+    }
+    if (wakeAt == Clock::time_point::max()) {
+      state->wakeUp.wait(lock);
+    } else {
+      state->wakeUp.wait_until(lock, wakeAt);
+    }
+  }
+}
+
+} // namespace margelo::nitro::performancetoolkit::testing
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <jsi/jsi.h>
+#include <ReactCommon/RuntimeExecutor.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+namespace margelo::nitro::performancetoolkit::testing {
+
+using namespace facebook;
+using namespace facebook::react;
+
+// jsi::Runtime handed to tasks of the fake JS thread. Its instrumentation reports a Hermes-like
+// GC counter the test controls, so GC attribution can be exercised without an engine.
+class FakeRuntime : public jsi::Runtime, private jsi::Instrumentation {
+public:
+  jsi::Instrumentation& instrumentation() override {
+    return *this;
+  }
+
+  void collectGarbage() {
+    _collections.fetch_add(1, std::memory_order_relaxed);
+  }
+
+private:
+  std::unordered_map<std::string, int64_t> getHeapInfo(bool) override {
+    return {
+      {"hermes_allocatedBytes", 8 << 20},
+      {"hermes_heapSize", 16 << 20},
+      {"hermes_numCollections", _collections.load(std::memory_order_relaxed)},
+    };
+  }
+
+  std::atomic<int64_t> _collections{0};
+};
+
+// A RuntimeExecutor backed by one thread and a FIFO task queue, standing in for the JS thread.
+//
+// Synthetic JS load is injected deterministically instead of by running JS:
+//   - `setLatency`: every task runs at least this long after it was posted (dispatch delay)
+//   - `stall`: queues a task that blocks the thread, like one long synchronous JS task
+//   - `setLoad`: blocks the thread for `busy` at the start of every `period`, like steady work
+// Time spent in posted tasks is measured separately from the synthetic load, which is what the
+// tracker overhead benchmarks report.
+//
+// Executors returned by `executor()` may outlive this object, tasks posted after it is destroyed
+// are dropped.
+class FakeRuntimeExecutor {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  FakeRuntimeExecutor();
+  ~FakeRuntimeExecutor();
+
+  FakeRuntimeExecutor(const FakeRuntimeExecutor&) = delete;
+  FakeRuntimeExecutor& operator=(const FakeRuntimeExecutor&) = delete;
+
+  RuntimeExecutor executor();
+
+  void setLatency(Clock::duration latency);
+  void stall(Clock::duration duration);
+  // `busy` of every `period` is spent blocked, a zero period turns the load off
+  void setLoad(Clock::duration busy, Clock::duration period);
+
+  FakeRuntime& runtime();
+
+  uint64_t getTasksRun() const;
+  Clock::duration getTimeInTasks() const;
+
+private:
+  struct Task {
+    Clock::time_point readyAt;
+    std::function<void(jsi::Runtime& runtime)> callback;
+    Clock::duration stall; // Synthetic stall instead of a callback when non-zero
+  };
+
+  struct State {
+    std::mutex mutex;
+    std::condition_variable wakeUp;
+    std::deque<Task> tasks;
+    bool running = true;
+    Clock::duration latency{0};
+    Clock::duration loadBusy{0};
+    Clock::duration loadPeriod{0};
+    Clock::time_point nextLoadAt;
+    FakeRuntime runtime;
+    std::atomic<uint64_t> tasksRun{0};
+    std::atomic<int64_t> timeInTasksNs{0};
+
+    void post(std::function<void(jsi::Runtime& runtime)>&& callback, Clock::duration stall);
+  };
+
+  static void run(const std::shared_ptr<State>& state);
+
+  std::shared_ptr<State> _state;
+  std::thread _thread;
+};
+
+} // namespace margelo::nitro::performancetoolkit::testing
@@ -0,0 +1,33 @@
+#include "FakeVsync.hpp"
+#include "PlatformBridge.hpp"
+#include "RuntimeBridge.hpp"
+
+#include <chrono>
+
+namespace margelo::nitro::performancetoolkit::testing {
+
+FakeVsync::FakeVsync() {
+  _thread = std::thread([this]() {
+    using Clock = std::chrono::steady_clock;
+    auto frameTime = Clock::now();
+    while (_running.load()) {
+      const auto frameInterval = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double, std::milli>(RuntimeBridgeState::get().getFrameIntervalMs())
+      );
+      const auto nextFrameTime = frameTime + frameInterval;
+      const auto frameTimeNs = std::chrono::duration_cast<std::chrono::nanoseconds>(frameTime.time_since_epoch()).count();
+      const auto nextFrameTimeNs = std::chrono::duration_cast<std::chrono::nanoseconds>(nextFrameTime.time_since_epoch()).count();
+      const auto nowNs = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+      PlatformBridge::notifyUiFrame(frameTimeNs, nextFrameTimeNs, nowNs);
+      std::this_thread::sleep_until(nextFrameTime);
+      frameTime = nextFrameTime;
+    }
+  });
+}
+
+FakeVsync::~FakeVsync() {
+  _running = false;
+  _thread.join();
+}
+
+} // namespace margelo::nitro::performancetoolkit::testing
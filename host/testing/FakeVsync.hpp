@@ -0,0 +1,24 @@
+#pragma once
+
+#include <atomic>
+#include <thread>
+
+namespace margelo::nitro::performancetoolkit::testing {
+
+// Stands in for Choreographer / CADisplayLink: a thread that forwards a UI frame through
+// PlatformBridge::notifyUiFrame at the current device refresh rate until it is destroyed.
+// On-demand JS FPS tracking arms its probes from these frames.
+class FakeVsync {
+public:
+  FakeVsync();
+  ~FakeVsync();
+
+  FakeVsync(const FakeVsync&) = delete;
+  FakeVsync& operator=(const FakeVsync&) = delete;
+
+private:
+  std::atomic<bool> _running{true};
+  std::thread _thread;
+};
+
+} // namespace margelo::nitro::performancetoolkit::testing
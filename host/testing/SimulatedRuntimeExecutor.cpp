@@ -0,0 +1,90 @@
+#include "SimulatedRuntimeExecutor.hpp"
+#include "SessionReader.hpp"
+
+#include <algorithm>
+
+namespace margelo::nitro::performancetoolkit::testing {
+
+JsLoadProfile JsLoadProfile::periodic(TrackerScheduler::Clock::duration busy, TrackerScheduler::Clock::duration period, TrackerScheduler::Clock::duration length) {
+  JsLoadProfile profile;
+  for (auto start = TrackerScheduler::Clock::duration::zero(); start < length; start += period) {
+    profile.intervals.push_back(JsBusyInterval{start, std::min(busy, period), false});
+  }
+  return profile;
+}
+
+JsLoadProfile JsLoadProfile::fromSession(const std::string& path) {
+  SessionReader reader(path);
+  const int64_t startTimeNs = reader.header().startTimeNs;
+  JsLoadProfile profile;
+  SessionSample sample;
+  while (reader.next(sample)) {
+    if (sample.type != SessionRecordType::LongTask && sample.type != SessionRecordType::GcPause) {
+      continue;
+    }
+    // The tick was posted when the work started and ran when it ended
+    profile.intervals.push_back(JsBusyInterval{
+      std::chrono::nanoseconds(sample.timeNs - startTimeNs),
+      std::chrono::nanoseconds(static_cast<int64_t>(sample.value * 1'000'000.0)),
+      sample.type == SessionRecordType::GcPause,
+    });
+  }
+  std::sort(profile.intervals.begin(), profile.intervals.end(), [](const auto& a, const auto& b) { return a.start < b.start; });
+  return profile;
+}
+
+SimulatedRuntimeExecutor::State::State(TrackerScheduler& scheduler, JsLoadProfile profile)
+    : scheduler(scheduler), origin(scheduler.now()), profile(std::move(profile)), freeAt(origin) {}
+
+SimulatedRuntimeExecutor::SimulatedRuntimeExecutor(TrackerScheduler& scheduler, JsLoadProfile profile)
+    : _state(std::make_shared<State>(scheduler, std::move(profile))) {}
+
+RuntimeExecutor SimulatedRuntimeExecutor::executor() {
+  std::weak_ptr<State> weakState = _state;
+  return [weakState](std::function<void(jsi::Runtime& runtime)>&& callback) {
+    if (auto state = weakState.lock()) {
+      state->post(std::move(callback));
+    }
+  };
+}
+
+void SimulatedRuntimeExecutor::State::post(std::function<void(jsi::Runtime& runtime)>&& callback) {
+  const Clock::time_point now = scheduler.now();
+  Clock::time_point runAt = std::max(now, freeAt);
+
+  // Wait out the busy intervals the task lands in
+  bool collected = false;
+  while (nextInterval < profile.intervals.size()) {
+    const JsBusyInterval& interval = profile.intervals[nextInterval];
+    const Clock::time_point start = origin + interval.start;
+    if (start > runAt) {
+      break;
+    }
+    runAt = std::max(runAt, start + interval.duration);
+    collected = collected || interval.gc;
+    nextInterval++;
+  }
+  freeAt = runAt + TASK_COST;
+
+  std::weak_ptr<State> weakSelf = weak_from_this();
+  scheduler.schedule(runAt - now, [weakSelf, collected, callback = std::move(callback)]() -> std::optional<Clock::duration> {
+    if (auto self = weakSelf.lock()) {
+      if (collected) {
+        self->runtime.collectGarbage();
+      }
+      self->tasksRun++;
+      callback(self->runtime);
+    }
+    return std::nullopt;
+  });
+}
+
+FakeRuntime& SimulatedRuntimeExecutor::runtime() {
+  return _state->runtime;
+}
+
+uint64_t SimulatedRuntimeExecutor::getTasksRun() const {
+  return _state->tasksRun;
+}
+
+} // namespace margelo::nitro::performancetoolkit::testing
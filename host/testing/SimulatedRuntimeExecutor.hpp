@@ -0,0 +1,71 @@
+#pragma once
+
+#include "FakeRuntimeExecutor.hpp"
+#include "TrackerScheduler.hpp"
+
+#include <ReactCommon/RuntimeExecutor.h>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace margelo::nitro::performancetoolkit::testing {
+
+// Synchronous JS work the simulated JS thread is busy with, relative to the simulation start
+struct JsBusyInterval {
+  TrackerScheduler::Clock::duration start;
+  TrackerScheduler::Clock::duration duration;
+  bool gc; // The engine collected garbage during it
+};
+
+// What kept a JS thread busy over time, sorted by start
+struct JsLoadProfile {
+  std::vector<JsBusyInterval> intervals;
+
+  // `busy` at the start of every `period` until `length`
+  static JsLoadProfile periodic(TrackerScheduler::Clock::duration busy, TrackerScheduler::Clock::duration period, TrackerScheduler::Clock::duration length);
+  // The long tasks and GC pauses of a recorded session, relative to its start
+  static JsLoadProfile fromSession(const std::string& path);
+};
+
+// A RuntimeExecutor simulated on a TrackerScheduler running on a VirtualClock, for replaying a
+// JS load profile faster than real time. A posted task runs once the thread is free: after the
+// tasks posted before it (each takes TASK_COST) and after any busy interval it lands in.
+//
+// Everything runs on the thread advancing the scheduler, like the rest of a simulation.
+class SimulatedRuntimeExecutor {
+public:
+  static constexpr TrackerScheduler::Clock::duration TASK_COST = std::chrono::microseconds(50);
+
+  SimulatedRuntimeExecutor(TrackerScheduler& scheduler, JsLoadProfile profile);
+
+  SimulatedRuntimeExecutor(const SimulatedRuntimeExecutor&) = delete;
+  SimulatedRuntimeExecutor& operator=(const SimulatedRuntimeExecutor&) = delete;
+
+  RuntimeExecutor executor();
+
+  FakeRuntime& runtime();
+
+  uint64_t getTasksRun() const;
+
+private:
+  using Clock = TrackerScheduler::Clock;
+
+  struct State : std::enable_shared_from_this<State> {
+    State(TrackerScheduler& scheduler, JsLoadProfile profile);
+
+    TrackerScheduler& scheduler;
+    Clock::time_point origin;
+    JsLoadProfile profile;
+    size_t nextInterval = 0; // First interval that may still delay a task
+    Clock::time_point freeAt;
+    FakeRuntime runtime;
+    uint64_t tasksRun = 0;
+
+    void post(std::function<void(jsi::Runtime& runtime)>&& callback);
+  };
+
+  std::shared_ptr<State> _state;
+};
+
+} // namespace margelo::nitro::performancetoolkit::testing
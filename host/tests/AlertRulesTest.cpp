@@ -0,0 +1,180 @@
+#include "AlertRules.hpp"
+#include "TrackerScheduler.hpp"
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace margelo::nitro::performancetoolkit;
+using namespace std::chrono_literals;
+
+namespace {
+
+// AlertRules is a process wide singleton, every test removes the rules it added. Rules are
+// evaluated on the scheduler thread, tests wait for it before looking at the firings
+class AlertRulesTest : public ::testing::Test {
+protected:
+  void TearDown() override {
+    settle();
+    for (const auto id : _ruleIds) {
+      AlertRules::get().remove(id);
+    }
+  }
+
+  std::vector<AlertRules::Firing>& add(const AlertRules::Rule& rule) {
+    auto& firings = _firings.emplace_back();
+    _ruleIds.push_back(AlertRules::get().add(rule, [&firings](const AlertRules::Firing& firing) {
+      firings.push_back(firing);
+    }));
+    return firings;
+  }
+
+  static void publish(MetricSlot slot, double value, double timestampMs) {
+    AlertRules::get().onSamples({{slot, value}}, timestampMs);
+  }
+
+  static void settle() {
+    const auto deadline = std::chrono::steady_clock::now() + 2s;
+    while (!AlertRules::get().isIdle() && std::chrono::steady_clock::now() < deadline) {
+      std::this_thread::sleep_for(1ms);
+    }
+    ASSERT_TRUE(AlertRules::get().isIdle());
+  }
+
+private:
+  std::vector<AlertRules::RuleId> _ruleIds;
+  std::deque<std::vector<AlertRules::Firing>> _firings; // Stable addresses for the listeners
+};
+
+} // namespace
+
+TEST_F(AlertRulesTest, FiresOnceConditionHeldForDuration) {
+  auto& firings = add({MetricSlot::JsFps, AlertRules::Condition::Below, 30.0, 3000.0, 0});
+
+  const double values[] = {60, 20, 25, 20, 20, 20, 20, 60, 10, 10};
+  double timeMs = 0.0;
+  for (const double value : values) {
+    publish(MetricSlot::JsFps, value, timeMs);
+    timeMs += 1000.0;
+  }
+
+  // Violating from 1 s, fires at 4 s, re-arms at 7 s, the second violation is too short
+  settle();
+  ASSERT_EQ(firings.size(), 1u);
+  EXPECT_EQ(firings[0].startedAtMs, 1000.0);
+  EXPECT_EQ(firings[0].firedAtMs, 4000.0);
+  EXPECT_EQ(firings[0].value, 20.0);
+  ASSERT_EQ(firings[0].window.size(), 4u);
+  EXPECT_EQ(firings[0].window.front().value, 20.0);
+  EXPECT_EQ(firings[0].window.back().timestampMs, 4000.0);
+}
+
+TEST_F(AlertRulesTest, FiresAfterConsecutiveSamples) {
+  auto& firings = add({MetricSlot::CpuUsage, AlertRules::Condition::Above, 80.0, 0.0, 5});
+
+  for (int i = 0; i < 20; i++) {
+    // 6 samples above, 4 below, twice
+    publish(MetricSlot::CpuUsage, (i % 10) < 6 ? 90.0 : 10.0, i * 500.0);
+  }
+  settle();
+  ASSERT_EQ(firings.size(), 2u);
+  EXPECT_EQ(firings[0].firedAtMs, 2000.0);
+  EXPECT_EQ(firings[1].firedAtMs, 7000.0);
+  EXPECT_EQ(firings[1].window.size(), 5u);
+}
+
+TEST_F(AlertRulesTest, WithoutDurationTheFirstViolationFires) {
+  auto& firings = add({MetricSlot::UiFps, AlertRules::Condition::Below, 50.0, 0.0, 0});
+  publish(MetricSlot::UiFps, 60.0, 0.0);
+  publish(MetricSlot::UiFps, 40.0, 16.0);
+  settle();
+  ASSERT_EQ(firings.size(), 1u);
+  EXPECT_EQ(firings[0].firedAtMs, 16.0);
+}
+
+TEST_F(AlertRulesTest, SlopeOverTimeWindow) {
+  // More than 20 MB per minute over the last minute
+  auto& firings = add({MetricSlot::MemoryUsage, AlertRules::Condition::SlopeAbove, 20.0, 60'000.0, 0});
+
+  // 10 MB/min for two minutes, then 30 MB/min
+  double memory = 100.0;
+  for (int second = 0; second < 240; second++) {
+    memory += second < 120 ? 10.0 / 60.0 : 30.0 / 60.0;
+    publish(MetricSlot::MemoryUsage, memory, second * 1000.0);
+  }
+  settle();
+  ASSERT_EQ(firings.size(), 1u);
+  EXPECT_GT(firings[0].firedAtMs, 120'000.0);
+  EXPECT_LT(firings[0].firedAtMs, 180'000.0);
+  EXPECT_GT(firings[0].value, 20.0);
+}
+
+TEST_F(AlertRulesTest, SlopeNeedsAFullWindow) {
+  auto& firings = add({MetricSlot::MemoryUsage, AlertRules::Condition::SlopeAbove, 1.0, 60'000.0, 0});
+  // Steep, but only 30 s of history
+  for (int second = 0; second < 30; second++) {
+    publish(MetricSlot::MemoryUsage, second * 10.0, second * 1000.0);
+  }
+  settle();
+  EXPECT_TRUE(firings.empty());
+}
+
+TEST_F(AlertRulesTest, OtherSlotsAndRemovedRulesAreIgnored) {
+  auto& firings = add({MetricSlot::JsFps, AlertRules::Condition::Below, 30.0, 0.0, 0});
+  publish(MetricSlot::UiFps, 0.0, 0.0);
+  settle();
+  EXPECT_TRUE(firings.empty());
+
+  auto& removed = add({MetricSlot::CpuUsage, AlertRules::Condition::Above, 0.0, 0.0, 0});
+  publish(MetricSlot::CpuUsage, 1.0, 0.0);
+  settle();
+  ASSERT_EQ(removed.size(), 1u);
+  AlertRules::get().remove(removed[0].ruleId);
+  publish(MetricSlot::CpuUsage, 0.0, 1.0);
+  publish(MetricSlot::CpuUsage, 1.0, 2.0);
+  settle();
+  EXPECT_EQ(removed.size(), 1u);
+}
+
+TEST_F(AlertRulesTest, RulesAreNeverEvaluatedOnThePublishingThread) {
+  std::mutex mutex;
+  std::vector<std::thread::id> firingThreads;
+  const auto ruleId = AlertRules::get().add({MetricSlot::CpuUsage, AlertRules::Condition::Above, 50.0, 0.0, 0}, [&](const AlertRules::Firing&) {
+    std::lock_guard<std::mutex> lock(mutex);
+    firingThreads.push_back(std::this_thread::get_id());
+  });
+  std::promise<std::thread::id> schedulerThread;
+  TrackerScheduler::get().schedule(0ms, [&schedulerThread]() -> std::optional<TrackerScheduler::Clock::duration> {
+    schedulerThread.set_value(std::this_thread::get_id());
+    return std::nullopt;
+  });
+
+  // Every other sample violates, so each publisher fires the rule many times
+  const auto publishAlternating = [](double startMs) {
+    for (int i = 0; i < 200; i++) {
+      publish(MetricSlot::CpuUsage, i % 2 == 0 ? 90.0 : 10.0, startMs + i);
+    }
+  };
+  std::thread::id otherPublisher;
+  std::thread other([&]() {
+    otherPublisher = std::this_thread::get_id();
+    publishAlternating(10'000.0);
+  });
+  publishAlternating(0.0);
+  other.join();
+  settle();
+  AlertRules::get().remove(ruleId);
+
+  const std::thread::id scheduler = schedulerThread.get_future().get();
+  std::lock_guard<std::mutex> lock(mutex);
+  ASSERT_FALSE(firingThreads.empty());
+  for (const auto& thread : firingThreads) {
+    EXPECT_NE(thread, std::this_thread::get_id());
+    EXPECT_NE(thread, otherPublisher);
+    EXPECT_EQ(thread, scheduler);
+  }
+}
@@ -0,0 +1,114 @@
+#include "CpuSampler.hpp"
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+using namespace margelo::nitro::performancetoolkit;
+using namespace std::chrono_literals;
+
+TEST(CpuSamplerTest, ParsesStat) {
+  constexpr const char* STAT =
+    "4242 (mqt_js) S 1 4242 0 0 -1 4194560 2311 0 0 0 731 129 0 0 20 0 42 0 1234 0 0\n";
+  CpuSampler::ParsedStat stat{};
+  ASSERT_TRUE(CpuSampler::parseStat(STAT, std::strlen(STAT), stat));
+  EXPECT_STREQ(stat.name, "mqt_js");
+  EXPECT_EQ(stat.utimeTicks, 731u);
+  EXPECT_EQ(stat.stimeTicks, 129u);
+  EXPECT_EQ(stat.startTicks, 1234u);
+}
+
+TEST(CpuSamplerTest, ParsesNameWithSpacesAndParentheses) {
+  // Thread names are set by the app, the name ends at the last ')' of the line
+  constexpr const char* STAT =
+    "4243 (a) b (c)) R 1 4242 0 0 -1 4194560 2311 0 0 0 17 3 0 0 20 0 42 0 1234 0 0\n";
+  CpuSampler::ParsedStat stat{};
+  ASSERT_TRUE(CpuSampler::parseStat(STAT, std::strlen(STAT), stat));
+  EXPECT_STREQ(stat.name, "a) b (c)");
+  EXPECT_EQ(stat.utimeTicks, 17u);
+  EXPECT_EQ(stat.stimeTicks, 3u);
+  EXPECT_EQ(stat.startTicks, 1234u);
+}
+
+TEST(CpuSamplerTest, RejectsTruncatedStat) {
+  constexpr const char* STAT = "4242 (mqt_js) S 1 4242 0 0 -1 4194560 2311 0 0 0 731";
+  CpuSampler::ParsedStat stat{};
+  EXPECT_FALSE(CpuSampler::parseStat(STAT, std::strlen(STAT), stat));
+  EXPECT_FALSE(CpuSampler::parseStat("4242 mqt_js S 1", 15, stat));
+}
+
+TEST(CpuSamplerTest, ParsesStatEndingBeforeStartTime) {
+  constexpr const char* STAT = "4242 (mqt_js) S 1 4242 0 0 -1 4194560 2311 0 0 0 731 129\n";
+  CpuSampler::ParsedStat stat{};
+  ASSERT_TRUE(CpuSampler::parseStat(STAT, std::strlen(STAT), stat));
+  EXPECT_EQ(stat.stimeTicks, 129u);
+  EXPECT_EQ(stat.startTicks, 0u);
+}
+
+TEST(CpuSamplerTest, ClassifiesReactNativeThreads) {
+  EXPECT_EQ(CpuSampler::classifyThread("anything", true), ThreadRole::Ui);
+  EXPECT_EQ(CpuSampler::classifyThread("mqt_js", true), ThreadRole::Ui);
+  EXPECT_EQ(CpuSampler::classifyThread("mqt_js", false), ThreadRole::Js);
+  EXPECT_EQ(CpuSampler::classifyThread("mqt_v_js", false), ThreadRole::Js);
+  EXPECT_EQ(CpuSampler::classifyThread("mqt_js_other", false), ThreadRole::ReactBackground);
+  EXPECT_EQ(CpuSampler::classifyThread("mqt_native_modu", false), ThreadRole::NativeModules);
+  EXPECT_EQ(CpuSampler::classifyThread("mqt_v_native", false), ThreadRole::NativeModules);
+  EXPECT_EQ(CpuSampler::classifyThread("hermes-inspecto", false), ThreadRole::ReactBackground);
+  EXPECT_EQ(CpuSampler::classifyThread("RenderThread", false), ThreadRole::Other);
+}
+
+#if defined(__linux__)
+
+TEST(CpuSamplerTest, SamplesABusyThreadLive) {
+  std::atomic<bool> running{true};
+  std::atomic<int32_t> busyTid{0};
+  std::thread busy([&]() {
+    pthread_setname_np(pthread_self(), "mqt_js");
+    busyTid = static_cast<int32_t>(syscall(SYS_gettid));
+    while (running.load(std::memory_order_relaxed)) {
+    }
+  });
+  while (busyTid.load() == 0) {
+    std::this_thread::yield();
+  }
+
+  auto& sampler = CpuSampler::get();
+  ASSERT_TRUE(sampler.start());
+  // The first sample only sets the baseline, threads get usage from the one after they were found
+  std::this_thread::sleep_for(std::chrono::milliseconds(CpuSampler::SAMPLE_INTERVAL_MS * 3));
+
+  const auto* bytes = sampler.getThreadBuffer()->data();
+  const auto* header = reinterpret_cast<const CpuSampler::Header*>(bytes);
+  const auto* records = reinterpret_cast<const CpuSampler::Record*>(bytes + sizeof(CpuSampler::Header));
+  double busyUsage = -1.0;
+  uint32_t busyRole = 0;
+  uint32_t sequence = 0;
+  do {
+    sequence = header->sequence.load(std::memory_order_acquire);
+    const uint32_t count = header->threadCount.load(std::memory_order_relaxed);
+    for (uint32_t i = 0; i < count; i++) {
+      if (records[i].tid.load(std::memory_order_relaxed) == busyTid.load()) {
+        busyUsage = records[i].cpuUsage.load(std::memory_order_relaxed);
+        busyRole = records[i].role.load(std::memory_order_relaxed);
+      }
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+  } while ((sequence & 1) != 0 || header->sequence.load(std::memory_order_relaxed) != sequence);
+
+  running = false;
+  busy.join();
+
+  EXPECT_GT(busyUsage, 0.0);
+  EXPECT_EQ(busyRole, static_cast<uint32_t>(ThreadRole::Js));
+  EXPECT_GT(*sampler.getCpuUsageCell(), 0);
+}
+
+#endif
@@ -0,0 +1,233 @@
+#include "JsFpsTracker.hpp"
+#include "JsLagEvents.hpp"
+#include "RuntimeBridge.hpp"
+#include "SessionRecorder.hpp"
+#include "SimulatedRuntimeExecutor.hpp"
+#include "UiFrameSource.hpp"
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <vector>
+
+using namespace margelo::nitro::performancetoolkit;
+using namespace margelo::nitro::performancetoolkit::testing;
+using namespace std::chrono_literals;
+
+namespace {
+
+struct Report {
+  int32_t fps;
+  int32_t droppedFrames;
+  double maxLatencyMs;
+
+  bool operator==(const Report& other) const {
+    return fps == other.fps && droppedFrames == other.droppedFrames && maxLatencyMs == other.maxLatencyMs;
+  }
+};
+
+// Runs a tracker against a load profile on a virtual clock and returns its once per second
+// reports. In on-demand mode UI frames are delivered at the refresh rate, like on a device.
+std::vector<Report> simulate(JsFpsTrackingMode mode, JsLoadProfile profile, TrackerScheduler::Clock::duration length) {
+  RuntimeBridgeState::get().setDeviceRefreshRate(60.0);
+  VirtualClock clock;
+  TrackerScheduler scheduler(clock);
+  SimulatedRuntimeExecutor js(scheduler, std::move(profile));
+
+  std::vector<Report> reports;
+  auto tracker = std::make_shared<JsFpsTracker>(
+    [&reports](int32_t fps, int32_t droppedFrames, double maxLatencyMs) {
+      reports.push_back(Report{fps, droppedFrames, maxLatencyMs});
+    },
+    nullptr, nullptr, nullptr, js.executor(), mode, false, scheduler
+  );
+  if (mode == JsFpsTrackingMode::ON_DEMAND) {
+    const auto frameInterval = std::chrono::duration_cast<TrackerScheduler::Clock::duration>(
+      std::chrono::duration<double, std::milli>(RuntimeBridgeState::get().getFrameIntervalMs())
+    );
+    scheduler.schedule(frameInterval, [&scheduler, frameInterval]() -> std::optional<TrackerScheduler::Clock::duration> {
+      UiFrameSource::get().onFrame(std::chrono::duration_cast<std::chrono::nanoseconds>(scheduler.now().time_since_epoch()).count());
+      return frameInterval;
+    });
+  }
+  tracker->start();
+  scheduler.advanceBy(length);
+  tracker->stop();
+  return reports;
+}
+
+class JsFpsTrackerSimulationTest : public ::testing::TestWithParam<JsFpsTrackingMode> {};
+
+} // namespace
+
+TEST_P(JsFpsTrackerSimulationTest, IdleThreadReportsRefreshRate) {
+  const auto reports = simulate(GetParam(), JsLoadProfile{}, 10s);
+  ASSERT_EQ(reports.size(), 10u);
+  // The first window misses the tick due right at its start
+  for (size_t i = 1; i < reports.size(); i++) {
+    EXPECT_EQ(reports[i].fps, 60) << "report " << i;
+    EXPECT_EQ(reports[i].droppedFrames, 0) << "report " << i;
+    EXPECT_LT(reports[i].maxLatencyMs, 1.0) << "report " << i;
+  }
+}
+
+// Reference values of both modes for a thread busy half of the time in 100 ms blocks. Neither is
+// exactly 30: continuous mode also counts the probe that waited out each block (6 on-time ticks
+// + 1 late one per 200 ms), on-demand mode allows each block the frame its probe was posted in
+// plus one frame of latency before counting it as stalled
+TEST(JsFpsTrackerSimulationReferenceTest, HalfLoadedThread) {
+  const auto profile = JsLoadProfile::periodic(100ms, 200ms, 10s);
+  const auto continuous = simulate(JsFpsTrackingMode::CONTINUOUS, profile, 10s);
+  const auto onDemand = simulate(JsFpsTrackingMode::ON_DEMAND, profile, 10s);
+  ASSERT_EQ(continuous.size(), 10u);
+  ASSERT_EQ(onDemand.size(), 10u);
+  for (size_t i = 1; i < continuous.size(); i++) {
+    EXPECT_EQ(continuous[i].fps, 35) << "report " << i;
+    EXPECT_EQ(continuous[i].droppedFrames, 25) << "report " << i;
+    EXPECT_NEAR(continuous[i].maxLatencyMs, 100.0, 17.0) << "report " << i;
+    EXPECT_EQ(onDemand[i].fps, 40) << "report " << i;
+    EXPECT_EQ(onDemand[i].droppedFrames, 20) << "report " << i;
+    EXPECT_NEAR(onDemand[i].maxLatencyMs, 100.0, 17.0) << "report " << i;
+  }
+}
+
+TEST_P(JsFpsTrackerSimulationTest, StallReportsZeroWithGrowingLatency) {
+  JsLoadProfile profile;
+  profile.intervals.push_back(JsBusyInterval{2s, 3s, false});
+  const auto reports = simulate(GetParam(), std::move(profile), 8s);
+  ASSERT_EQ(reports.size(), 8u);
+  EXPECT_EQ(reports[1].fps, 60);
+  // Windows 3 to 5 fall into the stall, the probe posted right before it is still waiting.
+  // On-demand mode doesn't count the first frames of a stall (see HalfLoadedThread above)
+  for (size_t i = 2; i < 5; i++) {
+    EXPECT_LE(reports[i].fps, GetParam() == JsFpsTrackingMode::CONTINUOUS ? 0 : 2) << "report " << i;
+    EXPECT_NEAR(reports[i].droppedFrames, 60, 2) << "report " << i;
+    EXPECT_NEAR(reports[i].maxLatencyMs, 1000.0 * (i - 1), 17.0) << "report " << i;
+  }
+  EXPECT_EQ(reports[6].fps, 60);
+  EXPECT_EQ(reports[6].droppedFrames, 0);
+}
+
+TEST_P(JsFpsTrackerSimulationTest, SameProfileGivesSameReports) {
+  const auto profile = JsLoadProfile::periodic(37ms, 290ms, 20s);
+  EXPECT_EQ(simulate(GetParam(), profile, 20s), simulate(GetParam(), profile, 20s));
+}
+
+// Every span of the sliding window comes from the same slots, none waits for a window to end
+TEST_P(JsFpsTrackerSimulationTest, SlidingAveragesFollowStall) {
+  RuntimeBridgeState::get().setDeviceRefreshRate(60.0);
+  VirtualClock clock;
+  TrackerScheduler scheduler(clock);
+  JsLoadProfile profile;
+  profile.intervals.push_back(JsBusyInterval{5s, 2s, false});
+  SimulatedRuntimeExecutor js(scheduler, std::move(profile));
+
+  auto tracker = std::make_shared<JsFpsTracker>(nullptr, nullptr, nullptr, nullptr, js.executor(), GetParam(), false, scheduler);
+  std::optional<TrackerScheduler::TaskId> frames;
+  if (GetParam() == JsFpsTrackingMode::ON_DEMAND) {
+    frames = scheduler.schedule(16ms, [&scheduler]() -> std::optional<TrackerScheduler::Clock::duration> {
+      UiFrameSource::get().onFrame(std::chrono::duration_cast<std::chrono::nanoseconds>(scheduler.now().time_since_epoch()).count());
+      return std::chrono::microseconds(16'667);
+    });
+  }
+  tracker->start();
+
+  scheduler.advanceBy(5s);
+  auto averages = tracker->getAverages();
+  EXPECT_NEAR(averages.instant, 60.0, 1.0);
+  EXPECT_NEAR(averages.oneSecond, 60.0, 1.0);
+  EXPECT_NEAR(averages.fiveSeconds, 60.0, 1.0);
+  EXPECT_NEAR(averages.session, 60.0, 1.0);
+
+  // 1.5 s into the stall
+  scheduler.advanceBy(1500ms);
+  averages = tracker->getAverages();
+  EXPECT_NEAR(averages.instant, 0.0, 1.0);
+  EXPECT_NEAR(averages.oneSecond, 0.0, 1.0);
+  EXPECT_NEAR(averages.fiveSeconds, 60.0 * 3.5 / 5.0, 2.0);
+  EXPECT_NEAR(averages.session, 60.0 * 5.0 / 6.5, 2.0);
+
+  // 2 s after the stall
+  scheduler.advanceBy(2500ms);
+  averages = tracker->getAverages();
+  EXPECT_NEAR(averages.instant, 60.0, 1.0);
+  EXPECT_NEAR(averages.oneSecond, 60.0, 1.0);
+  EXPECT_NEAR(averages.fiveSeconds, 60.0 * 3.0 / 5.0, 2.0);
+  EXPECT_NEAR(averages.session, 60.0 * 7.0 / 9.0, 2.0);
+
+  tracker->stop();
+  if (frames.has_value()) {
+    scheduler.cancel(*frames);
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+  Modes,
+  JsFpsTrackerSimulationTest,
+  ::testing::Values(JsFpsTrackingMode::CONTINUOUS, JsFpsTrackingMode::ON_DEMAND),
+  [](const ::testing::TestParamInfo<JsFpsTrackingMode>& info) {
+    return info.param == JsFpsTrackingMode::CONTINUOUS ? "Continuous" : "OnDemand";
+  }
+);
+
+// A changed window ends the current one right away, FPS stays per second whatever the window
+TEST(JsFpsTrackerSimulationWindowTest, ChangedWindowAppliesRightAway) {
+  RuntimeBridgeState::get().setDeviceRefreshRate(60.0);
+  VirtualClock clock;
+  TrackerScheduler scheduler(clock);
+  SimulatedRuntimeExecutor js(scheduler, JsLoadProfile{});
+
+  const auto start = scheduler.now();
+  std::vector<std::pair<int64_t, int32_t>> reports;
+  auto tracker = std::make_shared<JsFpsTracker>(
+    [&](int32_t fps, int32_t, double) {
+      reports.emplace_back(std::chrono::duration_cast<std::chrono::milliseconds>(scheduler.now() - start).count(), fps);
+    },
+    nullptr, nullptr, nullptr, js.executor(), JsFpsTrackingMode::CONTINUOUS, false, scheduler
+  );
+  tracker->start();
+  scheduler.advanceBy(2500ms);
+  tracker->setWindowMs(2000.0);
+  scheduler.advanceBy(4s);
+  tracker->stop();
+
+  ASSERT_EQ(reports.size(), 5u);
+  EXPECT_EQ(reports[1].first, 2000);
+  EXPECT_EQ(reports[2].first, 2500); // Half window, cut short
+  EXPECT_EQ(reports[3].first, 4500);
+  EXPECT_EQ(reports[4].first, 6500);
+  for (size_t i = 1; i < reports.size(); i++) {
+    EXPECT_EQ(reports[i].second, 60) << "report " << i;
+  }
+}
+
+// Replays the long tasks of a recorded session: an hour of tracking in well under a second
+TEST(JsFpsTrackerSimulationReplayTest, ReplaysRecordedSessionFasterThanRealTime) {
+  const std::string path = (std::filesystem::temp_directory_path() / (std::string("simulation-replay-test") + SessionRecorder::FILE_EXTENSION)).string();
+  SessionRecorder::get().start(path);
+  const int64_t startNs = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+  // A 400 ms long task 10.5 s in, and a 250 ms GC pause every minute after that
+  SessionRecorder::get().record(SessionRecordType::LongTask, startNs + 10'500'000'000LL, 400.0);
+  for (int64_t minute = 1; minute < 60; minute++) {
+    SessionRecorder::get().record(SessionRecordType::GcPause, startNs + minute * 60'000'000'000LL + 200'000'000LL, 250.0);
+  }
+  ASSERT_EQ(SessionRecorder::get().stop(), path);
+  const JsLoadProfile profile = JsLoadProfile::fromSession(path);
+  std::remove(path.c_str());
+  ASSERT_EQ(profile.intervals.size(), 60u);
+
+  const auto wallStart = std::chrono::steady_clock::now();
+  const auto reports = simulate(JsFpsTrackingMode::CONTINUOUS, profile, 1h);
+  EXPECT_LT(std::chrono::steady_clock::now() - wallStart, 10s);
+
+  ASSERT_EQ(reports.size(), 3600u);
+  // The long task window loses 400 ms worth of frames, its neighbours are untouched
+  EXPECT_EQ(reports[9].fps, 60);
+  EXPECT_NEAR(reports[10].fps, 36, 1);
+  EXPECT_NEAR(reports[10].maxLatencyMs, 400.0, 17.0);
+  EXPECT_EQ(reports[11].fps, 60);
+  for (size_t minute = 1; minute < 60; minute++) {
+    EXPECT_NEAR(reports[minute * 60].fps, 45, 1) << "minute " << minute;
+  }
+}
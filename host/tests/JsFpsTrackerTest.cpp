@@ -0,0 +1,200 @@
+#include "FakeRuntimeExecutor.hpp"
+#include "FakeVsync.hpp"
+#include "JsHeapSampler.hpp"
+#include "JsFpsTracker.hpp"
+#include "JsLagEvents.hpp"
+#include "RuntimeBridge.hpp"
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace margelo::nitro::performancetoolkit;
+using namespace margelo::nitro::performancetoolkit::testing;
+using namespace std::chrono_literals;
+
+namespace {
+
+struct Report {
+  int32_t fps;
+  int32_t droppedFrames;
+  double maxLatencyMs;
+};
+
+// Collects the once per second reports of a tracker
+class ReportCollector {
+public:
+  JsFpsTracker::Writer writer() {
+    return [this](int32_t fps, int32_t droppedFrames, double maxLatencyMs) {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _reports.push_back(Report{fps, droppedFrames, maxLatencyMs});
+      _changed.notify_all();
+    };
+  }
+
+  // Blocks until `count` reports arrived, returns all of them
+  std::vector<Report> waitFor(size_t count) {
+    std::unique_lock<std::mutex> lock(_mutex);
+    _changed.wait_for(lock, std::chrono::milliseconds(static_cast<int>(JsFpsTracker::FPS_WINDOW_MS)) * (count + 2), [&]() {
+      return _reports.size() >= count;
+    });
+    return _reports;
+  }
+
+private:
+  std::mutex _mutex;
+  std::condition_variable _changed;
+  std::vector<Report> _reports;
+};
+
+// Runs with UI frames like on a device that renders, on-demand probes are armed by them
+class JsFpsTrackerTest : public ::testing::TestWithParam<JsFpsTrackingMode> {
+protected:
+  void SetUp() override {
+    RuntimeBridgeState::get().setDeviceRefreshRate(60.0);
+    _vsync = std::make_unique<FakeVsync>();
+  }
+
+  void TearDown() override {
+    _vsync.reset();
+  }
+
+  // Tracker of a secondary runtime, it only reports through the writer
+  std::shared_ptr<JsFpsTracker> startTracker(ReportCollector& collector) {
+    auto tracker = std::make_shared<JsFpsTracker>(collector.writer(), nullptr, nullptr, nullptr, _js.executor(), GetParam(), false);
+    tracker->start();
+    return tracker;
+  }
+
+  FakeRuntimeExecutor _js;
+  std::unique_ptr<FakeVsync> _vsync;
+};
+
+} // namespace
+
+TEST_P(JsFpsTrackerTest, IdleThreadReportsRefreshRate) {
+  ReportCollector collector;
+  auto tracker = startTracker(collector);
+  const auto reports = collector.waitFor(2);
+  tracker->stop();
+
+  ASSERT_GE(reports.size(), 2u);
+  // The first window includes start up, judge the second one
+  EXPECT_NEAR(reports[1].fps, 60, 4);
+  EXPECT_LE(reports[1].droppedFrames, 4);
+  // Wall clock scheduling jitter only, no probe waits for a whole window
+  EXPECT_LT(reports[1].maxLatencyMs, 100.0);
+}
+
+TEST_P(JsFpsTrackerTest, FollowsRefreshRate) {
+  RuntimeBridgeState::get().setDeviceRefreshRate(120.0);
+  ReportCollector collector;
+  auto tracker = startTracker(collector);
+  const auto reports = collector.waitFor(2);
+  tracker->stop();
+
+  ASSERT_GE(reports.size(), 2u);
+  EXPECT_NEAR(reports[1].fps, 120, 10);
+}
+
+TEST_P(JsFpsTrackerTest, HalfLoadedThreadReportsAboutHalf) {
+  // Blocked for 100 ms out of every 200 ms
+  _js.setLoad(100ms, 200ms);
+  ReportCollector collector;
+  auto tracker = startTracker(collector);
+  const auto reports = collector.waitFor(3);
+  tracker->stop();
+
+  ASSERT_GE(reports.size(), 3u);
+  EXPECT_NEAR(reports[2].fps, 30, 8);
+  EXPECT_NEAR(reports[2].droppedFrames, 30, 8);
+  EXPECT_NEAR(reports[2].maxLatencyMs, 100.0, 20.0);
+}
+
+TEST_P(JsFpsTrackerTest, StalledThreadReportsZero) {
+  ReportCollector collector;
+  auto tracker = startTracker(collector);
+  collector.waitFor(1);
+  // Longer than a full window, so the next report sees no tick at all
+  _js.stall(2500ms);
+  const auto reports = collector.waitFor(3);
+  tracker->stop();
+
+  ASSERT_GE(reports.size(), 3u);
+  EXPECT_EQ(reports[2].fps, 0);
+  EXPECT_NEAR(reports[2].droppedFrames, 60, 4);
+  // A probe still waiting counts with its wait so far
+  EXPECT_GT(reports[2].maxLatencyMs, 900.0);
+}
+
+TEST_P(JsFpsTrackerTest, DispatchLatencyBelowOneFrameKeepsFullRate) {
+  _js.setLatency(5ms);
+  ReportCollector collector;
+  auto tracker = startTracker(collector);
+  const auto reports = collector.waitFor(2);
+  tracker->stop();
+
+  ASSERT_GE(reports.size(), 2u);
+  EXPECT_NEAR(reports[1].fps, 60, 6);
+  // Every probe waits at least the injected latency
+  EXPECT_GE(reports[1].maxLatencyMs, 5.0);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    Modes,
+    JsFpsTrackerTest,
+    ::testing::Values(JsFpsTrackingMode::CONTINUOUS, JsFpsTrackingMode::ON_DEMAND),
+    [](const ::testing::TestParamInfo<JsFpsTrackingMode>& info) {
+      return info.param == JsFpsTrackingMode::CONTINUOUS ? "Continuous" : "OnDemand";
+    });
+
+TEST(JsFpsTrackerOnDemandTest, BacksOffWithoutFramesWhileIdle) {
+  RuntimeBridgeState::get().setDeviceRefreshRate(60.0);
+  FakeRuntimeExecutor js;
+  ReportCollector collector;
+  auto tracker = std::make_shared<JsFpsTracker>(collector.writer(), nullptr, nullptr, nullptr, js.executor(), JsFpsTrackingMode::ON_DEMAND, false);
+  tracker->start();
+  const auto reports = collector.waitFor(2);
+  tracker->stop();
+
+  ASSERT_GE(reports.size(), 2u);
+  EXPECT_NEAR(reports[1].fps, 60, 4);
+  // Probe delay doubles up to PROBE_MAX_BACKOFF_MS, a handful of probes instead of 120
+  EXPECT_LT(js.getTasksRun(), 20u);
+}
+
+TEST(JsFpsTrackerLagTest, AttributesLateTicksToGcOrLongTasks) {
+  RuntimeBridgeState::get().setDeviceRefreshRate(60.0);
+  FakeRuntimeExecutor js;
+  // GC counts come from the heap sampler, which samples the main runtime
+  const uint64_t registrationId = RuntimeBridgeState::get().setRuntimeExecutor(js.executor());
+  const uint64_t samplesBefore = JsHeapSampler::get().getSampleCount();
+  auto lagEvents = std::make_shared<JsLagEvents>();
+  auto tracker = std::make_shared<JsFpsTracker>(nullptr, nullptr, lagEvents, nullptr, js.executor(), JsFpsTrackingMode::CONTINUOUS);
+  tracker->start();
+
+  // The heap sampler is started by the first tick, wait for its first sample of this runtime
+  const auto sampledBy = std::chrono::steady_clock::now() + 3s;
+  while (JsHeapSampler::get().getSampleCount() == samplesBefore && std::chrono::steady_clock::now() < sampledBy) {
+    std::this_thread::sleep_for(10ms);
+  }
+  ASSERT_GT(JsHeapSampler::get().getSampleCount(), samplesBefore);
+  // Let on-time ticks establish the GC baseline
+  std::this_thread::sleep_for(100ms);
+  js.runtime().collectGarbage();
+  js.stall(120ms);
+  // Late ticks are attributed once the next heap sample ran
+  const auto samplePeriod = std::chrono::milliseconds(JsHeapSampler::SAMPLE_INTERVAL_MS);
+  std::this_thread::sleep_for(samplePeriod + 200ms);
+  EXPECT_EQ(lagEvents->getCount(JsLagCause::GcPause), 1u);
+  js.stall(120ms);
+  std::this_thread::sleep_for(samplePeriod + 200ms);
+  tracker->stop();
+  RuntimeBridgeState::get().unregisterRuntime(RuntimeBridgeState::MAIN_RUNTIME_NAME, registrationId);
+
+  EXPECT_EQ(lagEvents->getCount(JsLagCause::GcPause), 1u);
+  EXPECT_EQ(lagEvents->getCount(JsLagCause::LongTask), 1u);
+}
@@ -0,0 +1,171 @@
+#include "LatencyHistogram.hpp"
+#include "MetricHistograms.hpp"
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+using namespace margelo::nitro::performancetoolkit;
+
+TEST(HistogramBucketsTest, SmallValuesAreExact) {
+  for (uint32_t value = 0; value < HistogramBuckets::SUB_BUCKET_COUNT; value++) {
+    const uint32_t index = HistogramBuckets::indexOf(value);
+    EXPECT_EQ(HistogramBuckets::lowerBoundOf(index), value);
+    EXPECT_EQ(HistogramBuckets::upperBoundOf(index), value);
+  }
+}
+
+TEST(HistogramBucketsTest, BucketsContainTheirValues) {
+  for (uint64_t value = 1; value <= UINT32_MAX; value = value * 3 + 1) {
+    const uint32_t index = HistogramBuckets::indexOf(static_cast<uint32_t>(value));
+    ASSERT_LT(index, HistogramBuckets::COUNT);
+    EXPECT_LE(HistogramBuckets::lowerBoundOf(index), value);
+    EXPECT_GE(HistogramBuckets::upperBoundOf(index), value);
+  }
+}
+
+TEST(HistogramBucketsTest, RelativeErrorIsBounded) {
+  // Log-linear buckets keep the width of a bucket below 1 / SUB_BUCKET_COUNT of its values
+  const double maxError = 1.0 / HistogramBuckets::SUB_BUCKET_COUNT;
+  for (uint64_t value = HistogramBuckets::SUB_BUCKET_COUNT; value <= UINT32_MAX; value = value * 5 + 3) {
+    const uint32_t index = HistogramBuckets::indexOf(static_cast<uint32_t>(value));
+    const double width = static_cast<double>(HistogramBuckets::upperBoundOf(index) - HistogramBuckets::lowerBoundOf(index));
+    EXPECT_LE(width / static_cast<double>(value), maxError) << value;
+  }
+}
+
+TEST(HistogramBucketsTest, BucketsAreContiguous) {
+  EXPECT_EQ(HistogramBuckets::lowerBoundOf(0), 0u);
+  for (uint32_t index = 1; index < HistogramBuckets::COUNT; index++) {
+    ASSERT_EQ(HistogramBuckets::lowerBoundOf(index), HistogramBuckets::upperBoundOf(index - 1) + 1) << index;
+  }
+  EXPECT_EQ(HistogramBuckets::upperBoundOf(HistogramBuckets::COUNT - 1), UINT32_MAX);
+  EXPECT_EQ(HistogramBuckets::indexOf(UINT32_MAX), HistogramBuckets::COUNT - 1);
+}
+
+TEST(HistogramBucketsTest, PowersOfTwoStartABucket) {
+  for (uint32_t exponent = HistogramBuckets::SUB_BUCKET_BITS; exponent < HistogramBuckets::VALUE_BITS; exponent++) {
+    const uint32_t value = 1u << exponent;
+    const uint32_t index = HistogramBuckets::indexOf(value);
+    EXPECT_EQ(HistogramBuckets::lowerBoundOf(index), value) << exponent;
+    EXPECT_EQ(HistogramBuckets::indexOf(value - 1), index - 1) << exponent;
+  }
+}
+
+TEST(HistogramBucketsTest, ClampRoundsAndSaturates) {
+  EXPECT_EQ(HistogramBuckets::clamp(-5.0), 0u);
+  EXPECT_EQ(HistogramBuckets::clamp(std::nan("")), 0u);
+  EXPECT_EQ(HistogramBuckets::clamp(1.6), 2u);
+  EXPECT_EQ(HistogramBuckets::clamp(1e12), UINT32_MAX);
+}
+
+TEST(LatencyHistogramTest, PercentilesOfUniformValues) {
+  LatencyHistogram histogram;
+  for (uint32_t value = 1; value <= 10000; value++) {
+    histogram.record(value);
+  }
+  HistogramSnapshot snapshot;
+  histogram.snapshotInto(snapshot);
+
+  EXPECT_EQ(snapshot.getTotalCount(), 10000u);
+  EXPECT_EQ(snapshot.getMax(), 10000u);
+  const double maxError = 1.0 / HistogramBuckets::SUB_BUCKET_COUNT;
+  EXPECT_NEAR(static_cast<double>(snapshot.getValueAtPercentile(50.0)), 5000.0, 5000.0 * maxError);
+  EXPECT_NEAR(static_cast<double>(snapshot.getValueAtPercentile(90.0)), 9000.0, 9000.0 * maxError);
+  EXPECT_NEAR(static_cast<double>(snapshot.getValueAtPercentile(99.0)), 9900.0, 9900.0 * maxError);
+  EXPECT_EQ(snapshot.getValueAtPercentile(100.0), 10000u);
+}
+
+TEST(LatencyHistogramTest, PercentileNeverExceedsMax) {
+  LatencyHistogram histogram;
+  histogram.record(1000);
+  HistogramSnapshot snapshot;
+  histogram.snapshotInto(snapshot);
+  EXPECT_EQ(snapshot.getValueAtPercentile(99.0), 1000u);
+}
+
+TEST(LatencyHistogramTest, PercentilesRoundToTheNearestRank) {
+  LatencyHistogram histogram;
+  for (uint32_t value = 1; value <= 4; value++) {
+    histogram.record(value);
+  }
+  HistogramSnapshot snapshot;
+  histogram.snapshotInto(snapshot);
+  // Small values have exact buckets, so the quantiles are the recorded values themselves
+  EXPECT_EQ(snapshot.getValueAtPercentile(0.0), 1u);
+  EXPECT_EQ(snapshot.getValueAtPercentile(25.0), 1u);
+  EXPECT_EQ(snapshot.getValueAtPercentile(37.0), 1u);
+  EXPECT_EQ(snapshot.getValueAtPercentile(38.0), 2u);
+  EXPECT_EQ(snapshot.getValueAtPercentile(75.0), 3u);
+  EXPECT_EQ(snapshot.getValueAtPercentile(-10.0), 1u);
+  EXPECT_EQ(snapshot.getValueAtPercentile(200.0), 4u);
+}
+
+TEST(LatencyHistogramTest, PercentilesReportTheBucketUpperBound) {
+  LatencyHistogram histogram;
+  // 1000 falls into [992, 1007] (16 wide below 1024), 1024 starts a 32 wide bucket
+  histogram.record(1000);
+  histogram.record(1024);
+  histogram.record(5000);
+  HistogramSnapshot snapshot;
+  histogram.snapshotInto(snapshot);
+  EXPECT_EQ(snapshot.getValueAtPercentile(33.0), 1007u);
+  EXPECT_EQ(snapshot.getValueAtPercentile(66.0), 1055u);
+  EXPECT_EQ(snapshot.getValueAtPercentile(100.0), 5000u);
+}
+
+TEST(LatencyHistogramTest, ConcurrentRecordsAreAllCounted) {
+  static constexpr uint32_t THREADS = 4;
+  static constexpr uint32_t RECORDS_PER_THREAD = 100000;
+  LatencyHistogram histogram;
+  std::vector<std::thread> threads;
+  for (uint32_t t = 0; t < THREADS; t++) {
+    threads.emplace_back([&histogram, t]() {
+      for (uint32_t i = 0; i < RECORDS_PER_THREAD; i++) {
+        histogram.record(i % 1000 + t);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  HistogramSnapshot snapshot;
+  histogram.snapshotInto(snapshot);
+  EXPECT_EQ(snapshot.getTotalCount(), uint64_t(THREADS) * RECORDS_PER_THREAD);
+  EXPECT_EQ(snapshot.getMax(), 999u + THREADS - 1);
+}
+
+TEST(LatencyHistogramTest, SnapshotsMerge) {
+  LatencyHistogram first;
+  LatencyHistogram second;
+  first.record(10);
+  second.record(20);
+  second.record(30);
+
+  HistogramSnapshot merged;
+  first.snapshotInto(merged);
+  second.snapshotInto(merged);
+  EXPECT_EQ(merged.getTotalCount(), 3u);
+  EXPECT_EQ(merged.getMax(), 30u);
+  EXPECT_EQ(merged.getValueAtPercentile(50.0), 20u);
+}
+
+TEST(LatencyHistogramTest, ResetClearsCounts) {
+  LatencyHistogram histogram;
+  histogram.record(42);
+  histogram.reset();
+  HistogramSnapshot snapshot;
+  histogram.snapshotInto(snapshot);
+  EXPECT_EQ(snapshot.getTotalCount(), 0u);
+  EXPECT_EQ(snapshot.getValueAtPercentile(50.0), 0u);
+}
+
+TEST(MetricHistogramsTest, LatenciesAreRecordedInMicroseconds) {
+  const uint64_t countBefore = MetricHistograms::get().snapshot(HistogramMetric::UiFrameTime, MetricHistograms::MAX_WINDOW_SECONDS).getTotalCount();
+  MetricHistograms::get().record(HistogramMetric::UiFrameTime, 1234.5678);
+  const HistogramSnapshot snapshot = MetricHistograms::get().snapshot(HistogramMetric::UiFrameTime, MetricHistograms::MAX_WINDOW_SECONDS);
+  EXPECT_EQ(snapshot.getTotalCount(), countBefore + 1);
+  EXPECT_GE(snapshot.getMax(), 1234568u); // Other tests in this process may have recorded more
+  EXPECT_EQ(MetricHistograms::scaleOf(HistogramMetric::CpuUsage), 1.0);
+}
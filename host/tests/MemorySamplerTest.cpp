@@ -0,0 +1,71 @@
+#include "MemorySampler.hpp"
+
+#include <gtest/gtest.h>
+#include <cstring>
+
+using namespace margelo::nitro::performancetoolkit;
+
+namespace {
+
+// Same fields and alignment as /proc/self/smaps_rollup on Linux 5.x (Android 12+)
+constexpr const char* SMAPS_ROLLUP =
+  "12c00000-7fffd2c5f000 ---p 00000000 00:00 0                          [rollup]\n"
+  "Rss:              245312 kB\n"
+  "Pss:              131847 kB\n"
+  "Pss_Dirty:         98120 kB\n"
+  "Pss_Anon:          90536 kB\n"
+  "Pss_File:          33451 kB\n"
+  "Pss_Shmem:          7860 kB\n"
+  "Shared_Clean:     101956 kB\n"
+  "Shared_Dirty:      10916 kB\n"
+  "Private_Clean:     29048 kB\n"
+  "Private_Dirty:    103392 kB\n"
+  "Referenced:       232860 kB\n"
+  "Anonymous:         93440 kB\n"
+  "LazyFree:              0 kB\n"
+  "AnonHugePages:         0 kB\n"
+  "ShmemPmdMapped:        0 kB\n"
+  "FilePmdMapped:         0 kB\n"
+  "Shared_Hugetlb:        0 kB\n"
+  "Private_Hugetlb:       0 kB\n"
+  "Swap:              18204 kB\n"
+  "SwapPss:           17133 kB\n"
+  "Locked:                0 kB\n";
+
+} // namespace
+
+TEST(MemorySamplerTest, ParsesSmapsRollup) {
+  MemorySampler::MemoryStats stats;
+  ASSERT_TRUE(MemorySampler::parseSmapsRollup(SMAPS_ROLLUP, std::strlen(SMAPS_ROLLUP), stats));
+  EXPECT_EQ(stats.rssKb, 245312u);
+  EXPECT_EQ(stats.pssKb, 131847u);
+  EXPECT_EQ(stats.privateDirtyKb, 103392u);
+  EXPECT_EQ(stats.anonymousKb, 93440u);
+  // SwapPss must not be taken for Swap, nor Pss_* for Pss
+  EXPECT_EQ(stats.swapKb, 18204u);
+}
+
+TEST(MemorySamplerTest, ParsesTruncatedSmapsRollup) {
+  const char* data = "Rss:  100 kB\nPss:  5";
+  MemorySampler::MemoryStats stats;
+  ASSERT_TRUE(MemorySampler::parseSmapsRollup(data, std::strlen(data), stats));
+  EXPECT_EQ(stats.rssKb, 100u);
+  EXPECT_EQ(stats.pssKb, 5u);
+}
+
+TEST(MemorySamplerTest, RejectsUnknownContent) {
+  const char* data = "MemTotal: 100 kB\n";
+  MemorySampler::MemoryStats stats;
+  EXPECT_FALSE(MemorySampler::parseSmapsRollup(data, std::strlen(data), stats));
+  EXPECT_FALSE(MemorySampler::parseSmapsRollup(data, 0, stats));
+}
+
+TEST(MemorySamplerTest, ParsesStatmResidentPages) {
+  const char* data = "3551232 61328 34052 2 0 112956 0\n";
+  uint64_t residentPages = 0;
+  ASSERT_TRUE(MemorySampler::parseStatmResidentPages(data, std::strlen(data), residentPages));
+  EXPECT_EQ(residentPages, 61328u);
+
+  EXPECT_FALSE(MemorySampler::parseStatmResidentPages("3551232", 7, residentPages));
+  EXPECT_FALSE(MemorySampler::parseStatmResidentPages("3551232 x", 9, residentPages));
+}
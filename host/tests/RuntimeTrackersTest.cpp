@@ -0,0 +1,132 @@
+#include "RuntimeBridge.hpp"
+#include "RuntimeFpsTable.hpp"
+#include "RuntimeTrackers.hpp"
+#include "SimulatedRuntimeExecutor.hpp"
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <vector>
+
+using namespace margelo::nitro::performancetoolkit;
+using namespace margelo::nitro::performancetoolkit::testing;
+using namespace std::chrono_literals;
+
+namespace {
+
+// Queues tasks instead of running them, so a test decides when (and whether) they run
+struct QueueingExecutor {
+  std::shared_ptr<std::vector<std::function<void(jsi::Runtime&)>>> tasks = std::make_shared<std::vector<std::function<void(jsi::Runtime&)>>>();
+
+  RuntimeExecutor executor() const {
+    return [tasks = tasks](std::function<void(jsi::Runtime&)>&& task) {
+      tasks->push_back(std::move(task));
+    };
+  }
+};
+
+class RuntimeTrackersTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    RuntimeBridgeState::get().setDeviceRefreshRate(60.0);
+  }
+
+  void TearDown() override {
+    RuntimeBridgeState::get().unregisterRuntime(RuntimeBridgeState::MAIN_RUNTIME_NAME);
+  }
+
+  static int32_t mainFps(RuntimeTrackers& trackers) {
+    return *reinterpret_cast<int32_t*>(trackers.getFpsBuffer()->data());
+  }
+};
+
+} // namespace
+
+TEST_F(RuntimeTrackersTest, RegistrationExecutorDropsTasksOnceReplaced) {
+  QueueingExecutor first;
+  QueueingExecutor second;
+  auto& registry = RuntimeBridgeState::get();
+  const uint64_t firstId = registry.setRuntimeExecutor(first.executor());
+  const RuntimeExecutor firstExecutor = registry.getRuntimeExecutor();
+  const RuntimeExecutor bound = registry.getBoundExecutor(RuntimeBridgeState::MAIN_RUNTIME_NAME);
+  // The first main runtime of the process also gets the startup tracer's first JS tick
+  const size_t startupTasks = first.tasks->size();
+
+  firstExecutor([](jsi::Runtime&) {});
+  bound([](jsi::Runtime&) {});
+  EXPECT_EQ(first.tasks->size(), startupTasks + 2);
+
+  const uint64_t secondId = registry.setRuntimeExecutor(second.executor());
+  EXPECT_NE(firstId, secondId);
+  EXPECT_EQ(registry.getRegistrationId(RuntimeBridgeState::MAIN_RUNTIME_NAME), secondId);
+  firstExecutor([](jsi::Runtime&) {});
+  bound([](jsi::Runtime&) {});
+  EXPECT_EQ(first.tasks->size(), startupTasks + 2);
+  EXPECT_EQ(second.tasks->size(), 1u);
+
+  // Teardown of the first runtime must not unregister its replacement
+  registry.unregisterRuntime(RuntimeBridgeState::MAIN_RUNTIME_NAME, firstId);
+  EXPECT_EQ(registry.getRegistrationId(RuntimeBridgeState::MAIN_RUNTIME_NAME), secondId);
+  registry.unregisterRuntime(RuntimeBridgeState::MAIN_RUNTIME_NAME, secondId);
+  EXPECT_EQ(registry.getRegistrationId(RuntimeBridgeState::MAIN_RUNTIME_NAME), 0u);
+  bound([](jsi::Runtime&) {});
+  EXPECT_EQ(second.tasks->size(), 1u);
+}
+
+// A reload: the old JS thread freezes with a probe pending and is destroyed once the new runtime
+// registered. The same tracker goes on reporting the new runtime
+TEST_F(RuntimeTrackersTest, MainTrackerKeepsReportingAcrossReload) {
+  VirtualClock clock;
+  TrackerScheduler scheduler(clock);
+  auto oldJs = std::make_unique<SimulatedRuntimeExecutor>(scheduler, JsLoadProfile{{JsBusyInterval{3s, 1h, false}}});
+  RuntimeBridgeState::get().setRuntimeExecutor(oldJs->executor());
+
+  RuntimeTrackers trackers(scheduler);
+  trackers.start();
+  scheduler.advanceBy(3s);
+  EXPECT_EQ(mainFps(trackers), 60);
+  scheduler.advanceBy(2s);
+  EXPECT_EQ(mainFps(trackers), 0);
+
+  SimulatedRuntimeExecutor newJs(scheduler, JsLoadProfile{});
+  RuntimeBridgeState::get().setRuntimeExecutor(newJs.executor());
+  oldJs.reset();
+  // Picked up by the periodic registry check, the first full window after it is back to normal
+  scheduler.advanceBy(std::chrono::milliseconds(RuntimeTrackers::RUNTIME_SYNC_INTERVAL_MS) + 2s);
+  EXPECT_EQ(mainFps(trackers), 60);
+  EXPECT_GT(newJs.getTasksRun(), 60u);
+  EXPECT_EQ(trackers.getRuntimeTable()->getNames()[RuntimeFpsTable::MAIN_SLOT], RuntimeBridgeState::MAIN_RUNTIME_NAME);
+  trackers.stop();
+}
+
+TEST_F(RuntimeTrackersTest, ReRegisteredRuntimeKeepsItsSlot) {
+  VirtualClock clock;
+  TrackerScheduler scheduler(clock);
+  SimulatedRuntimeExecutor mainJs(scheduler, JsLoadProfile{});
+  SimulatedRuntimeExecutor firstWorker(scheduler, JsLoadProfile{});
+  SimulatedRuntimeExecutor secondWorker(scheduler, JsLoadProfile{});
+  auto& registry = RuntimeBridgeState::get();
+  registry.setRuntimeExecutor(mainJs.executor());
+  registry.registerRuntime("worker", firstWorker.executor());
+
+  RuntimeTrackers trackers(scheduler);
+  trackers.start();
+  scheduler.advanceBy(2s);
+  const auto names = trackers.getRuntimeTable()->getNames();
+  const auto slot = std::find(names.begin(), names.end(), "worker");
+  ASSERT_NE(slot, names.end());
+
+  registry.registerRuntime("worker", secondWorker.executor());
+  trackers.sync();
+  EXPECT_EQ(trackers.getRuntimeTable()->getNames(), names);
+  const uint64_t tasksBefore = secondWorker.getTasksRun();
+  scheduler.advanceBy(1s);
+  EXPECT_GT(secondWorker.getTasksRun(), tasksBefore);
+
+  registry.unregisterRuntime("worker");
+  trackers.sync();
+  EXPECT_TRUE(trackers.getRuntimeTable()->getNames()[slot - names.begin()].empty());
+  trackers.stop();
+}
@@ -0,0 +1,100 @@
+#include "SamplerRates.hpp"
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <set>
+#include <vector>
+
+using namespace margelo::nitro::performancetoolkit;
+using namespace std::chrono_literals;
+
+namespace {
+
+class SamplerRatesTest : public ::testing::Test {
+protected:
+  void TearDown() override {
+    for (uint32_t i = 0; i < static_cast<uint32_t>(SamplerKind::Count); i++) {
+      SamplerRates::get().reset(static_cast<SamplerKind>(i));
+    }
+  }
+
+  static int64_t sinceEpochMs(TrackerScheduler::Clock::time_point time) {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(time.time_since_epoch()).count();
+  }
+};
+
+} // namespace
+
+TEST_F(SamplerRatesTest, IntervalsAreRoundedToTheGridAndClamped) {
+  auto& rates = SamplerRates::get();
+  EXPECT_EQ(rates.getIntervalMs(SamplerKind::Cpu), 500u);
+  rates.setIntervalMs(SamplerKind::Cpu, 1100);
+  EXPECT_EQ(rates.getIntervalMs(SamplerKind::Cpu), 1000u);
+  rates.setIntervalMs(SamplerKind::Cpu, 1200);
+  EXPECT_EQ(rates.getIntervalMs(SamplerKind::Cpu), 1250u);
+  rates.setIntervalMs(SamplerKind::Cpu, 0);
+  EXPECT_EQ(rates.getIntervalMs(SamplerKind::Cpu), SamplerRates::MIN_INTERVAL_MS);
+  rates.setIntervalMs(SamplerKind::Cpu, 10'000'000);
+  EXPECT_EQ(rates.getIntervalMs(SamplerKind::Cpu), SamplerRates::MAX_INTERVAL_MS);
+  rates.reset(SamplerKind::Cpu);
+  EXPECT_EQ(rates.getIntervalMs(SamplerKind::Cpu), 500u);
+}
+
+// Samplers started at arbitrary moments with different periods only wake the thread on grid ticks
+TEST_F(SamplerRatesTest, SamplersStartedApartShareWakeups) {
+  VirtualClock clock(TrackerScheduler::Clock::time_point(std::chrono::hours(1) + 37ms));
+  TrackerScheduler scheduler(clock);
+  std::vector<int64_t> runsMs;
+  auto record = [&]() { runsMs.push_back(sinceEpochMs(scheduler.now())); };
+
+  SamplerRates::get().schedule(SamplerKind::JsHeap, record, 0ms, scheduler);
+  scheduler.advanceBy(180ms);
+  SamplerRates::get().schedule(SamplerKind::Cpu, record, std::nullopt, scheduler);
+  scheduler.advanceBy(71ms);
+  SamplerRates::get().schedule(SamplerKind::Memory, record, std::nullopt, scheduler);
+  scheduler.advanceBy(10s);
+
+  const std::set<int64_t> wakeups(runsMs.begin(), runsMs.end());
+  for (int64_t runMs : wakeups) {
+    EXPECT_EQ(runMs % SamplerRates::GRID_MS, 0) << runMs;
+  }
+  // 10 heap + 2 * 20 procfs samples (+ first runs), only the 500 ms ticks wake the thread
+  EXPECT_GE(runsMs.size(), 48u);
+  EXPECT_LE(wakeups.size(), 22u);
+}
+
+TEST_F(SamplerRatesTest, ChangedIntervalAppliesRightAway) {
+  VirtualClock clock;
+  TrackerScheduler scheduler(clock);
+  const int64_t startMs = sinceEpochMs(scheduler.now());
+  std::vector<int64_t> runsMs;
+  SamplerRates::get().schedule(SamplerKind::Memory, [&]() { runsMs.push_back(sinceEpochMs(scheduler.now()) - startMs); }, std::nullopt, scheduler);
+  scheduler.advanceBy(2s);
+  EXPECT_EQ(runsMs.size(), 4u);
+
+  // The run already due at 2.5 s moves to the next multiple of the new period
+  SamplerRates::get().setIntervalMs(SamplerKind::Memory, 10'000);
+  scheduler.advanceBy(1s);
+  EXPECT_EQ(runsMs.size(), 4u);
+  // Shortened again, it doesn't wait out the 10 s period
+  SamplerRates::get().setIntervalMs(SamplerKind::Memory, 250);
+  scheduler.advanceBy(1s);
+  EXPECT_EQ(runsMs, (std::vector<int64_t>{500, 1000, 1500, 2000, 3250, 3500, 3750, 4000}));
+}
+
+TEST_F(SamplerRatesTest, PausedSamplerResumesRightAway) {
+  VirtualClock clock;
+  TrackerScheduler scheduler(clock);
+  int runs = 0;
+  SamplerRates::get().schedule(SamplerKind::Cpu, [&runs]() { runs++; }, std::nullopt, scheduler);
+  scheduler.advanceBy(1s);
+  EXPECT_EQ(runs, 2);
+
+  SamplerRates::get().setPaused(SamplerKind::Cpu, true);
+  scheduler.advanceBy(10min);
+  EXPECT_EQ(runs, 2);
+
+  SamplerRates::get().setPaused(SamplerKind::Cpu, false);
+  scheduler.advanceBy(500ms);
+  EXPECT_EQ(runs, 3);
+}
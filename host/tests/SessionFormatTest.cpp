@@ -0,0 +1,198 @@
+#include "PlatformBridge.hpp"
+#include "SessionFormat.hpp"
+#include "SessionReader.hpp"
+#include "SessionRecorder.hpp"
+#include "UserTimings.hpp"
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <filesystem>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <sys/resource.h>
+#endif
+
+using namespace margelo::nitro::performancetoolkit;
+
+namespace {
+
+int64_t nowNs() {
+  const auto now = std::chrono::steady_clock::now().time_since_epoch();
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+}
+
+std::string tempSessionPath(const char* name) {
+  return (std::filesystem::temp_directory_path() / (std::string(name) + SessionRecorder::FILE_EXTENSION)).string();
+}
+
+std::vector<SessionSample> readAll(SessionReader& reader) {
+  std::vector<SessionSample> samples;
+  SessionSample sample;
+  while (reader.next(sample)) {
+    samples.push_back(sample);
+  }
+  return samples;
+}
+
+} // namespace
+
+TEST(SessionFormatTest, ZigzagRoundTrips) {
+  for (int64_t value : {int64_t(0), int64_t(1), int64_t(-1), int64_t(123456789), INT64_MIN, INT64_MAX}) {
+    EXPECT_EQ(zigzagDecode(zigzagEncode(value)), value);
+  }
+  // Small magnitudes of either sign encode to small numbers, so their varints stay short
+  EXPECT_EQ(zigzagEncode(-1), 1u);
+  EXPECT_EQ(zigzagEncode(1), 2u);
+}
+
+TEST(SessionFormatTest, RecordedSamplesReadBack) {
+  const std::string path = tempSessionPath("session-format-test");
+  SessionRecorder::get().start(path);
+
+  const int64_t startNs = nowNs();
+  for (int i = 0; i < 500; i++) {
+    const int64_t timeNs = startNs + i * 8'000'000LL; // 8 ms apart, spans several index intervals
+    SessionRecorder::get().record(SessionRecordType::JsTick, timeNs, 0.25 * (i % 40));
+    SessionRecorder::get().record(SessionRecordType::CpuUsage, timeNs, 12.3);
+  }
+  ASSERT_EQ(SessionRecorder::get().stop(), path);
+
+  SessionReader reader(path);
+  EXPECT_EQ(reader.header().version, SESSION_FILE_VERSION);
+  EXPECT_EQ(reader.header().droppedSamples, 0u);
+
+  int jsTicks = 0;
+  int cpuSamples = 0;
+  int64_t lastTimeNs = 0;
+  for (const auto& sample : readAll(reader)) {
+    if (sample.type == SessionRecordType::JsTick) {
+      // Times are stored in microseconds, values in microseconds of latency
+      EXPECT_NEAR(static_cast<double>(sample.timeNs), static_cast<double>(startNs + jsTicks * 8'000'000LL), 1000.0);
+      EXPECT_NEAR(sample.value, 0.25 * (jsTicks % 40), 0.001);
+      EXPECT_GE(sample.timeNs, lastTimeNs);
+      lastTimeNs = sample.timeNs;
+      jsTicks++;
+    } else if (sample.type == SessionRecordType::CpuUsage) {
+      EXPECT_NEAR(sample.value, 12.3, 0.05); // Quantized to 0.1%
+      cpuSamples++;
+    }
+  }
+  EXPECT_EQ(jsTicks, 500);
+  EXPECT_EQ(cpuSamples, 500);
+  std::remove(path.c_str());
+}
+
+TEST(SessionFormatTest, UserTimingsReadBackWithNames) {
+  const uint32_t markId = UserTimings::get().intern("Navigated");
+  const uint32_t spanId = UserTimings::get().intern("Feed render");
+  const std::string path = tempSessionPath("session-user-timings-test");
+  SessionRecorder::get().start(path);
+  UserTimings::get().mark(markId);
+  UserTimings::get().beginSpan(spanId);
+  UserTimings::get().endSpan(spanId);
+  ASSERT_EQ(SessionRecorder::get().stop(), path);
+
+  SessionReader reader(path);
+  int marks = 0;
+  int spans = 0;
+  for (const auto& sample : readAll(reader)) {
+    if (sample.type == SessionRecordType::UserMark) {
+      EXPECT_EQ(reader.nameOf(sample.nameId), "Navigated");
+      marks++;
+    } else if (sample.type == SessionRecordType::UserSpan) {
+      EXPECT_EQ(reader.nameOf(sample.nameId), "Feed render");
+      EXPECT_GE(sample.value, 0.0);
+      spans++;
+    }
+  }
+  EXPECT_EQ(marks, 1);
+  EXPECT_EQ(spans, 1);
+  std::remove(path.c_str());
+}
+
+TEST(SessionFormatTest, UiFramesAreStampedOnTheSteadyClock) {
+  // A platform frame clock running an hour ahead of the steady clock, like mach time vs. the boot clock
+  const int64_t platformOffsetNs = 3600LL * 1'000'000'000;
+  const int64_t frameNs = 16'666'667;
+  const std::string path = tempSessionPath("session-ui-frames-test");
+  SessionRecorder::get().start(path);
+  const int64_t startNs = nowNs();
+  for (int i = 0; i < 3; i++) {
+    const int64_t platformNowNs = nowNs() + platformOffsetNs;
+    PlatformBridge::notifyUiFrame(platformNowNs, platformNowNs + frameNs, platformNowNs);
+    std::this_thread::sleep_for(std::chrono::nanoseconds(frameNs));
+  }
+  const int64_t endNs = nowNs();
+  ASSERT_EQ(SessionRecorder::get().stop(), path);
+
+  SessionReader reader(path);
+  int uiFrames = 0;
+  for (const auto& sample : readAll(reader)) {
+    if (sample.type == SessionRecordType::UiFrame) {
+      EXPECT_GE(sample.timeNs, startNs - 1000);
+      EXPECT_LE(sample.timeNs, endNs);
+      uiFrames++;
+    }
+  }
+  EXPECT_GE(uiFrames, 1);
+  std::remove(path.c_str());
+}
+
+#if defined(__linux__)
+
+TEST(SessionFormatTest, SessionEndsWhenTheFileCantGrow) {
+  // A file size limit makes allocating the second growth step fail like a full disk would
+  rlimit previousLimit{};
+  ASSERT_EQ(getrlimit(RLIMIT_FSIZE, &previousLimit), 0);
+  const auto previousHandler = std::signal(SIGXFSZ, SIG_IGN);
+  rlimit limit = previousLimit;
+  limit.rlim_cur = SessionRecorder::GROWTH_BYTES;
+  ASSERT_EQ(setrlimit(RLIMIT_FSIZE, &limit), 0);
+
+  const std::string path = tempSessionPath("session-storage-full-test");
+  SessionRecorder::get().start(path);
+  // Large deltas so every sample takes ~15 bytes, a few queue drains fill the first step
+  int64_t timeNs = nowNs();
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  for (int batch = 0; SessionRecorder::get().isRecording() && std::chrono::steady_clock::now() < deadline; batch++) {
+    for (uint32_t i = 0; i < SessionRecorder::QUEUE_CAPACITY / 2; i++) {
+      timeNs += 1'000'000'000LL + i;
+      SessionRecorder::get().record(SessionRecordType::MemoryUsage, timeNs, (batch * 7919 + i * 104729) % 100000);
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(SessionRecorder::DRAIN_INTERVAL_MS));
+  }
+  EXPECT_FALSE(SessionRecorder::get().isRecording());
+  EXPECT_THROW(SessionRecorder::get().stop(), std::runtime_error);
+
+  ASSERT_EQ(setrlimit(RLIMIT_FSIZE, &previousLimit), 0);
+  std::signal(SIGXFSZ, previousHandler);
+
+  // Everything before the failed step is intact
+  SessionReader reader(path);
+  EXPECT_GT(readAll(reader).size(), 10000u);
+  EXPECT_FALSE(SessionRecorder::get().stop().has_value());
+  std::remove(path.c_str());
+}
+
+#endif
+
+TEST(SessionFormatTest, NothingIsRecordedWithoutASession) {
+  EXPECT_FALSE(SessionRecorder::get().isRecording());
+  EXPECT_FALSE(SessionRecorder::get().stop().has_value());
+  // Must be a no-op rather than queueing for the next session
+  SessionRecorder::get().record(SessionRecordType::JsTick, nowNs(), 1.0);
+
+  const std::string path = tempSessionPath("session-empty-test");
+  SessionRecorder::get().start(path);
+  SessionRecorder::get().stop();
+  SessionReader reader(path);
+  for (const auto& sample : readAll(reader)) {
+    EXPECT_NE(sample.type, SessionRecordType::JsTick);
+  }
+  std::remove(path.c_str());
+}
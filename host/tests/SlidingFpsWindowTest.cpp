@@ -0,0 +1,39 @@
+#include "SlidingFpsWindow.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace margelo::nitro::performancetoolkit;
+
+namespace {
+
+constexpr long long MS = 1'000'000;
+constexpr double MAX_FPS = 120.0;
+
+} // namespace
+
+TEST(SlidingFpsWindowTest, SessionStartingMidSlotOnlyCountsFramesAfterIt) {
+  SlidingFpsWindow window;
+  window.reset(1000 * MS);
+  // 60 FPS for two slots, the session restarts 200 ms into the first one
+  for (int i = 0; i < 30; i++) {
+    window.addFrame(1000 * MS + i * 1'000'000'000LL / 60);
+    if (i == 11) {
+      window.reset(1200 * MS);
+    }
+  }
+  const auto averages = window.compute(1500 * MS, false, MAX_FPS, 0);
+  EXPECT_NEAR(averages.instant, 60.0, 0.5);
+  EXPECT_NEAR(averages.oneSecond, 60.0, 0.5); // The whole first slot would make it 100
+  EXPECT_NEAR(averages.fiveSeconds, 60.0, 0.5);
+}
+
+TEST(SlidingFpsWindowTest, SessionStartingMidSlotOnlyCountsStallsAfterIt) {
+  SlidingFpsWindow window;
+  window.reset(1000 * MS);
+  window.addStall(1000 * MS, 1250 * MS);
+  window.reset(1200 * MS);
+  const auto averages = window.compute(1500 * MS, true, 60.0, 0);
+  EXPECT_DOUBLE_EQ(averages.instant, 60.0);
+  // 50 ms of the stall fall into the 300 ms since the session start
+  EXPECT_NEAR(averages.oneSecond, 50.0, 0.01);
+}
@@ -0,0 +1,78 @@
+#include "FakeRuntimeExecutor.hpp"
+#include "PlatformBridge.hpp"
+#include "RuntimeBridge.hpp"
+#include "StartupTracer.hpp"
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <thread>
+
+using namespace margelo::nitro::performancetoolkit;
+using namespace margelo::nitro::performancetoolkit::testing;
+using namespace std::chrono_literals;
+
+namespace {
+
+double steadyNowMs() {
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// The tracer and the runtime registry are process wide, other tests register runtimes and
+// deliver UI frames before these run
+class StartupTracerTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    RuntimeBridgeState::get().resetForTesting();
+    StartupTracer::get().resetForTesting();
+  }
+
+  void TearDown() override {
+    RuntimeBridgeState::get().resetForTesting();
+  }
+};
+
+} // namespace
+
+// The process started before the test binary got here, no longer ago than a full test run takes
+TEST_F(StartupTracerTest, ProcessStartIsOnTheSteadyClock) {
+  const double processStartMs = StartupTracer::get().getMs(StartupMilestone::ProcessStart);
+  ASSERT_GT(processStartMs, 0.0);
+  // starttime has clock tick (10 ms) resolution
+  EXPECT_LE(processStartMs, steadyNowMs() + 10.0);
+  EXPECT_GT(processStartMs, steadyNowMs() - 600'000.0);
+}
+
+TEST_F(StartupTracerTest, MilestonesAreRecordedOnce) {
+  PlatformBridge::notifyNativeLibraryLoaded();
+  const double loadedMs = StartupTracer::get().getMs(StartupMilestone::NativeLibraryLoaded);
+  EXPECT_GE(loadedMs, StartupTracer::get().getMs(StartupMilestone::ProcessStart) - 10.0);
+
+  std::this_thread::sleep_for(2ms);
+  EXPECT_FALSE(StartupTracer::get().mark(StartupMilestone::NativeLibraryLoaded));
+  PlatformBridge::notifyNativeLibraryLoaded();
+  EXPECT_EQ(StartupTracer::get().getMs(StartupMilestone::NativeLibraryLoaded), loadedMs);
+  EXPECT_EQ(StartupTracer::get().getMs(StartupMilestone::FirstUiFrame), 0.0);
+}
+
+// Registering the main runtime marks it and posts the first JS tick, a reload marks nothing
+TEST_F(StartupTracerTest, FirstMainRuntimeMarksFirstJsTick) {
+  auto& tracer = StartupTracer::get();
+  FakeRuntimeExecutor js;
+  js.setLatency(20ms);
+  const uint64_t registrationId = RuntimeBridgeState::get().setRuntimeExecutor(js.executor());
+  const double runtimeCreatedMs = tracer.getMs(StartupMilestone::RuntimeCreated);
+  EXPECT_GT(runtimeCreatedMs, 0.0);
+  EXPECT_EQ(tracer.getMs(StartupMilestone::FirstJsTick), 0.0);
+
+  const auto deadline = std::chrono::steady_clock::now() + 2s;
+  while (tracer.getMs(StartupMilestone::FirstJsTick) == 0.0 && std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(1ms);
+  }
+  EXPECT_GE(tracer.getMs(StartupMilestone::FirstJsTick), runtimeCreatedMs + 20.0);
+
+  FakeRuntimeExecutor reloaded;
+  const uint64_t reloadedId = RuntimeBridgeState::get().setRuntimeExecutor(reloaded.executor());
+  EXPECT_EQ(tracer.getMs(StartupMilestone::RuntimeCreated), runtimeCreatedMs);
+  RuntimeBridgeState::get().unregisterRuntime(RuntimeBridgeState::MAIN_RUNTIME_NAME, registrationId);
+  RuntimeBridgeState::get().unregisterRuntime(RuntimeBridgeState::MAIN_RUNTIME_NAME, reloadedId);
+}
@@ -0,0 +1,86 @@
+#include "FakeRuntimeExecutor.hpp"
+#include "JsFpsTracker.hpp"
+#include "MetricsBlock.hpp"
+#include "PlatformBridge.hpp"
+#include "RuntimeBridge.hpp"
+#include "SessionRecorder.hpp"
+#include "ToolkitOverhead.hpp"
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <thread>
+
+using namespace margelo::nitro::performancetoolkit;
+using namespace margelo::nitro::performancetoolkit::testing;
+using namespace std::chrono_literals;
+
+TEST(ToolkitOverheadTest, ThreadCpuClockAdvancesWithWork) {
+  const int64_t startNs = ToolkitOverhead::threadCpuNs();
+  volatile uint64_t sink = 0;
+  for (uint64_t i = 0; i < 20'000'000; i++) {
+    sink = sink + i;
+  }
+  EXPECT_GT(ToolkitOverhead::threadCpuNs(), startNs);
+}
+
+TEST(ToolkitOverheadTest, ScopedTimerAddsToItsWork) {
+  const auto before = ToolkitOverhead::get().totals();
+  {
+    ToolkitOverhead::ScopedTimer timer(ToolkitOverhead::TimedWork::UiFrame);
+    std::this_thread::sleep_for(2ms);
+  }
+  const auto after = ToolkitOverhead::get().totals();
+  EXPECT_GE(after.uiFrameNs - before.uiFrameNs, 2'000'000);
+  EXPECT_EQ(after.jsTasks, before.jsTasks);
+}
+
+TEST(ToolkitOverheadTest, NestedTimersCountOnce) {
+  const auto before = ToolkitOverhead::get().totals();
+  {
+    ToolkitOverhead::ScopedTimer outer(ToolkitOverhead::TimedWork::JsTask);
+    ToolkitOverhead::ScopedTimer inner(ToolkitOverhead::TimedWork::JsTask);
+    std::this_thread::sleep_for(20ms);
+  }
+  const auto after = ToolkitOverhead::get().totals();
+  EXPECT_GE(after.jsTaskNs - before.jsTaskNs, 20'000'000);
+  EXPECT_LT(after.jsTaskNs - before.jsTaskNs, 35'000'000); // Counting the inner timer too would double it
+}
+
+TEST(ToolkitOverheadTest, MeasuresTrackerAndSessionWriter) {
+  RuntimeBridgeState::get().setDeviceRefreshRate(60.0);
+  ToolkitOverhead::get().start();
+  const auto before = ToolkitOverhead::get().totals();
+
+  FakeRuntimeExecutor js;
+  auto tracker = std::make_shared<JsFpsTracker>(nullptr, nullptr, nullptr, nullptr, js.executor(), JsFpsTrackingMode::CONTINUOUS, false);
+  const std::string path = (std::filesystem::temp_directory_path() / (std::string("overhead-test") + SessionRecorder::FILE_EXTENSION)).string();
+  SessionRecorder::get().start(path);
+  tracker->start();
+  for (int i = 0; i < 100; i++) {
+    const auto nowNs = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    PlatformBridge::notifyUiFrame(nowNs, 0, nowNs);
+    std::this_thread::sleep_for(16ms);
+  }
+  // Past the next publish, the first sample only sets the baseline
+  std::this_thread::sleep_for(std::chrono::milliseconds(ToolkitOverhead::SAMPLE_INTERVAL_MS));
+  tracker->stop();
+  SessionRecorder::get().stop();
+  std::remove(path.c_str());
+
+  const auto after = ToolkitOverhead::get().totals();
+  EXPECT_GT(after.jsTasks - before.jsTasks, 50u); // ~60 probes per second for ~2.6 s
+  EXPECT_EQ(after.jsTasks - before.jsTasks, js.getTasksRun());
+  EXPECT_GT(after.jsTaskNs, before.jsTaskNs);
+  EXPECT_GT(after.uiFrameNs, before.uiFrameNs);
+  EXPECT_GT(after.schedulerCpuNs, 0);
+  EXPECT_GT(after.sessionWriterCpuNs, before.sessionWriterCpuNs);
+  EXPECT_GT(after.wakeups, before.wakeups);
+  EXPECT_GT(after.measuredSinceNs, 0);
+
+  // Well under one core on an otherwise idle thread
+  EXPECT_GT(MetricsBlock::get().read(MetricSlot::ToolkitCpuUsage), 0.0);
+  EXPECT_LT(MetricsBlock::get().read(MetricSlot::ToolkitCpuUsage), 50.0);
+  EXPECT_LT(MetricsBlock::get().read(MetricSlot::ToolkitJsThreadUsage), 10.0);
+}
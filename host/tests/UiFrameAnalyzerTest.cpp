@@ -0,0 +1,50 @@
+#include "MetricsBlock.hpp"
+#include "RuntimeBridge.hpp"
+#include "UiFrameAnalyzer.hpp"
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <thread>
+
+using namespace margelo::nitro::performancetoolkit;
+using namespace std::chrono_literals;
+
+namespace {
+
+constexpr double FRAME_MS = 1000.0 / 60.0;
+
+int64_t steadyNowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
+TEST(UiFrameAnalyzerTest, ClassifiesFrames) {
+  EXPECT_EQ(UiFrameAnalyzer::classify(FRAME_MS, FRAME_MS, FRAME_MS), UiFrameClass::Smooth);
+  EXPECT_EQ(UiFrameAnalyzer::classify(FRAME_MS * 6, FRAME_MS, FRAME_MS), UiFrameClass::Jank);
+  EXPECT_EQ(UiFrameAnalyzer::classify(FRAME_MS * 8, FRAME_MS, FRAME_MS), UiFrameClass::BigJank);
+  EXPECT_EQ(UiFrameAnalyzer::classify(800.0, FRAME_MS, FRAME_MS), UiFrameClass::Frozen);
+  // Slow but steady frames are no jank, only stutter relative to the refresh rate
+  EXPECT_EQ(UiFrameAnalyzer::classify(100.0, 90.0, FRAME_MS), UiFrameClass::Stutter);
+  EXPECT_EQ(UiFrameAnalyzer::droppedFrames(FRAME_MS * 1.4, FRAME_MS), 0u);
+  EXPECT_EQ(UiFrameAnalyzer::droppedFrames(FRAME_MS * 3, FRAME_MS), 2u);
+}
+
+TEST(UiFrameAnalyzerTest, WindowsArePublishedByTheScheduler) {
+  RuntimeBridgeState::get().setDeviceRefreshRate(60.0);
+  MetricsBlock::get().publish(MetricSlot::UiFps, 0.0);
+  const uint32_t windowMs = UiFrameAnalyzer::get().getWindowMs();
+  const auto frameNs = static_cast<int64_t>(FRAME_MS * 1'000'000.0);
+  const int64_t startNs = steadyNowNs();
+  const int64_t targetNs = 0; // Budget from the refresh rate
+  const auto frames = static_cast<int64_t>(windowMs / FRAME_MS) + 2;
+  for (int64_t i = 0; i <= frames; i++) {
+    UiFrameAnalyzer::get().onFrame(startNs + i * frameNs, targetNs);
+  }
+  // Handed over to the scheduler, published on its next grid step
+  const auto publishedBy = std::chrono::steady_clock::now() + 2s;
+  while (MetricsBlock::get().read(MetricSlot::UiFps) == 0.0 && std::chrono::steady_clock::now() < publishedBy) {
+    std::this_thread::sleep_for(10ms);
+  }
+  EXPECT_NEAR(MetricsBlock::get().read(MetricSlot::UiFps), 60.0, 1.0);
+}
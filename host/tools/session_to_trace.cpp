@@ -0,0 +1,27 @@
+#include "ChromeTraceExporter.hpp"
+
+#include <cstdio>
+#include <exception>
+#include <string>
+
+using namespace margelo::nitro::performancetoolkit;
+
+int main(int argc, char** argv) {
+  if (argc < 2 || argc > 3) {
+    std::fprintf(stderr, "Usage: %s <session file> [trace.json]\n", argv[0]);
+    return 2;
+  }
+  const std::string sessionPath = argv[1];
+  const std::string tracePath = argc == 3 ? argv[2] : ChromeTraceExporter::defaultTracePath(sessionPath);
+  try {
+    const ChromeTraceExporter::Result result = ChromeTraceExporter::exportSession(sessionPath, tracePath);
+    std::printf("Wrote %llu samples to %s\n", static_cast<unsigned long long>(result.samples), tracePath.c_str());
+    if (result.droppedSamples > 0) {
+      std::printf("Warning: %llu samples were dropped while recording\n", static_cast<unsigned long long>(result.droppedSamples));
+    }
+  } catch (const std::exception& error) {
+    std::fprintf(stderr, "%s\n", error.what());
+    return 1;
+  }
+  return 0;
+}
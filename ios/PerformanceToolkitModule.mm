@@ -6,12 +6,38 @@
 #import <ReactCommon/CallInvoker.h>
 #import <UIKit/UIKit.h>
 
+#include "PlatformBridge.hpp"
 #include "RuntimeBridge.hpp"
 
 using namespace facebook::react;
 using namespace margelo::nitro::performancetoolkit;
 
-@implementation PerformanceToolkitModule
+// Startup timeline: records the first frame drawn after the library loaded, then stops
+@interface PerformanceToolkitFirstFrameObserver : NSObject
+@end
+
+@implementation PerformanceToolkitFirstFrameObserver
+
+- (void)onFrame:(CADisplayLink *)link {
+  PlatformBridge::notifyFirstUiFrame();
+  [link invalidate]; // Releases the observer
+}
+
+@end
+
+// Runs with the image initializers, before main(). RCT_EXPORT_MODULE already defines +load
+__attribute__((constructor)) static void PerformanceToolkitLibraryLoaded() {
+  PlatformBridge::notifyNativeLibraryLoaded();
+  dispatch_async(dispatch_get_main_queue(), ^{
+    CADisplayLink *link = [CADisplayLink displayLinkWithTarget:[PerformanceToolkitFirstFrameObserver new]
+                                                      selector:@selector(onFrame:)];
+    [link addToRunLoop:[NSRunLoop mainRunLoop] forMode:NSRunLoopCommonModes];
+  });
+}
+
+@implementation PerformanceToolkitModule {
+  uint64_t _registrationId;
+}
 
 RCT_EXPORT_MODULE(PerformanceToolkit)
 
@@ -47,7 +73,7 @@ RCT_EXPORT_MODULE(PerformanceToolkit)
     });
   };
 
-  RuntimeBridgeState::get().setRuntimeExecutor(executor);
+  _registrationId = RuntimeBridgeState::get().setRuntimeExecutor(executor);
   
   // Set device refresh rate (this is safe to call multiple times)
   static dispatch_once_t onceToken;
@@ -55,7 +81,21 @@ RCT_EXPORT_MODULE(PerformanceToolkit)
     double deviceFps = (double)UIScreen.mainScreen.maximumFramesPerSecond;
     RuntimeBridgeState::get().setDeviceRefreshRate(deviceFps);
     RCTLogInfo(@"[PerformanceToolkitModule] Device refresh rate set to %.1f FPS", deviceFps);
+
+    NSString *cacheDirectory = NSSearchPathForDirectoriesInDomains(NSCachesDirectory, NSUserDomainMask, YES).firstObject;
+    if (cacheDirectory != nil) {
+      PlatformBridge::setCacheDirectory(cacheDirectory.UTF8String);
+    }
   });
+
+  PlatformBridge::notifyBindingsInstalled();
+}
+
+// The bridge invalidates modules when their runtime goes away. Unless a reload already registered
+// the next runtime, trackers stop posting into this one right here
+- (void)invalidate {
+  RuntimeBridgeState::get().unregisterRuntime(RuntimeBridgeState::MAIN_RUNTIME_NAME, _registrationId);
+  [super invalidate];
 }
 
 - (std::shared_ptr<facebook::react::TurboModule>)getTurboModule:(const ObjCTurboModule::InitParams&)params {
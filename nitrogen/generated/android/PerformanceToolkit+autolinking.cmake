@@ -35,6 +35,7 @@ target_sources(
   # Shared Nitrogen C++ sources
   ../nitrogen/generated/shared/c++/HybridJsFpsTrackingSpec.cpp
   ../nitrogen/generated/shared/c++/HybridPerformanceToolkitSpec.cpp
+  ../nitrogen/generated/shared/c++/HybridPerformanceMetricsSpec.cpp
   # Android-specific Nitrogen C++ sources
   ../nitrogen/generated/android/c++/JHybridPerformanceToolkitSpec.cpp
 )
@@ -18,6 +18,7 @@
 #include "JHybridPerformanceToolkitSpec.hpp"
 #include <NitroModules/DefaultConstructableObject.hpp>
 #include "HybridJsFpsTracking.hpp"
+#include "HybridPerformanceMetrics.hpp"
 
 namespace margelo::nitro::performancetoolkit {
 
@@ -48,6 +49,15 @@ int initialize(JavaVM* vm) {
         return std::make_shared<HybridJsFpsTracking>();
       }
     );
+    HybridObjectRegistry::registerHybridObjectConstructor(
+      "PerformanceMetrics",
+      []() -> std::shared_ptr<HybridObject> {
+        static_assert(std::is_default_constructible_v<HybridPerformanceMetrics>,
+                      "The HybridObject \"HybridPerformanceMetrics\" is not default-constructible! "
+                      "Create a public constructor that takes zero arguments to be able to autolink this HybridObject.");
+        return std::make_shared<HybridPerformanceMetrics>();
+      }
+    );
   });
 }
 
@@ -12,6 +12,7 @@
 
 #include "HybridPerformanceToolkitSpecSwift.hpp"
 #include "HybridJsFpsTracking.hpp"
+#include "HybridPerformanceMetrics.hpp"
 
 @interface PerformanceToolkitAutolinking : NSObject
 @end
@@ -38,6 +39,15 @@
       return std::make_shared<HybridJsFpsTracking>();
     }
   );
+  HybridObjectRegistry::registerHybridObjectConstructor(
+    "PerformanceMetrics",
+    []() -> std::shared_ptr<HybridObject> {
+      static_assert(std::is_default_constructible_v<HybridPerformanceMetrics>,
+                    "The HybridObject \"HybridPerformanceMetrics\" is not default-constructible! "
+                    "Create a public constructor that takes zero arguments to be able to autolink this HybridObject.");
+      return std::make_shared<HybridPerformanceMetrics>();
+    }
+  );
 }
 
 @end
@@ -0,0 +1,99 @@
+///
+/// Alert.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/JSIHelpers.hpp>)
+#include <NitroModules/JSIHelpers.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+
+
+#include <vector>
+
+namespace margelo::nitro::performancetoolkit {
+
+  /**
+   * A struct which can be represented as a JavaScript object (Alert).
+   */
+  struct Alert {
+  public:
+    double ruleId     SWIFT_PRIVATE;
+    double metric     SWIFT_PRIVATE;
+    double value     SWIFT_PRIVATE;
+    double startedAtMs     SWIFT_PRIVATE;
+    double firedAtMs     SWIFT_PRIVATE;
+    std::vector<double> windowValues     SWIFT_PRIVATE;
+    std::vector<double> windowTimestampsMs     SWIFT_PRIVATE;
+
+  public:
+    Alert() = default;
+    explicit Alert(double ruleId, double metric, double value, double startedAtMs, double firedAtMs, std::vector<double> windowValues, std::vector<double> windowTimestampsMs): ruleId(ruleId), metric(metric), value(value), startedAtMs(startedAtMs), firedAtMs(firedAtMs), windowValues(windowValues), windowTimestampsMs(windowTimestampsMs) {}
+  };
+
+} // namespace margelo::nitro::performancetoolkit
+
+namespace margelo::nitro {
+
+  // C++ Alert <> JS Alert (object)
+  template <>
+  struct JSIConverter<margelo::nitro::performancetoolkit::Alert> final {
+    static inline margelo::nitro::performancetoolkit::Alert fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return margelo::nitro::performancetoolkit::Alert(
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "ruleId")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "metric")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "value")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "startedAtMs")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "firedAtMs")),
+        JSIConverter<std::vector<double>>::fromJSI(runtime, obj.getProperty(runtime, "windowValues")),
+        JSIConverter<std::vector<double>>::fromJSI(runtime, obj.getProperty(runtime, "windowTimestampsMs"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const margelo::nitro::performancetoolkit::Alert& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "ruleId", JSIConverter<double>::toJSI(runtime, arg.ruleId));
+      obj.setProperty(runtime, "metric", JSIConverter<double>::toJSI(runtime, arg.metric));
+      obj.setProperty(runtime, "value", JSIConverter<double>::toJSI(runtime, arg.value));
+      obj.setProperty(runtime, "startedAtMs", JSIConverter<double>::toJSI(runtime, arg.startedAtMs));
+      obj.setProperty(runtime, "firedAtMs", JSIConverter<double>::toJSI(runtime, arg.firedAtMs));
+      obj.setProperty(runtime, "windowValues", JSIConverter<std::vector<double>>::toJSI(runtime, arg.windowValues));
+      obj.setProperty(runtime, "windowTimestampsMs", JSIConverter<std::vector<double>>::toJSI(runtime, arg.windowTimestampsMs));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!nitro::isPlainObject(runtime, obj)) {
+        return false;
+      }
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "ruleId"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "metric"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "value"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "startedAtMs"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "firedAtMs"))) return false;
+      if (!JSIConverter<std::vector<double>>::canConvert(runtime, obj.getProperty(runtime, "windowValues"))) return false;
+      if (!JSIConverter<std::vector<double>>::canConvert(runtime, obj.getProperty(runtime, "windowTimestampsMs"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
@@ -0,0 +1,84 @@
+///
+/// AlertCondition.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/NitroHash.hpp>)
+#include <NitroModules/NitroHash.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+namespace margelo::nitro::performancetoolkit {
+
+  /**
+   * An enum which can be represented as a JavaScript union (AlertCondition).
+   */
+  enum class AlertCondition {
+    ABOVE      SWIFT_NAME(above) = 0,
+    BELOW      SWIFT_NAME(below) = 1,
+    SLOPE_ABOVE      SWIFT_NAME(slopeAbove) = 2,
+    SLOPE_BELOW      SWIFT_NAME(slopeBelow) = 3,
+  } CLOSED_ENUM;
+
+} // namespace margelo::nitro::performancetoolkit
+
+namespace margelo::nitro {
+
+  // C++ AlertCondition <> JS AlertCondition (union)
+  template <>
+  struct JSIConverter<margelo::nitro::performancetoolkit::AlertCondition> final {
+    static inline margelo::nitro::performancetoolkit::AlertCondition fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      std::string unionValue = JSIConverter<std::string>::fromJSI(runtime, arg);
+      switch (hashString(unionValue.c_str(), unionValue.size())) {
+        case hashString("above"): return margelo::nitro::performancetoolkit::AlertCondition::ABOVE;
+        case hashString("below"): return margelo::nitro::performancetoolkit::AlertCondition::BELOW;
+        case hashString("slope-above"): return margelo::nitro::performancetoolkit::AlertCondition::SLOPE_ABOVE;
+        case hashString("slope-below"): return margelo::nitro::performancetoolkit::AlertCondition::SLOPE_BELOW;
+        default: [[unlikely]]
+          throw std::invalid_argument("Cannot convert \"" + unionValue + "\" to enum AlertCondition - invalid value!");
+      }
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, margelo::nitro::performancetoolkit::AlertCondition arg) {
+      switch (arg) {
+        case margelo::nitro::performancetoolkit::AlertCondition::ABOVE: return JSIConverter<std::string>::toJSI(runtime, "above");
+        case margelo::nitro::performancetoolkit::AlertCondition::BELOW: return JSIConverter<std::string>::toJSI(runtime, "below");
+        case margelo::nitro::performancetoolkit::AlertCondition::SLOPE_ABOVE: return JSIConverter<std::string>::toJSI(runtime, "slope-above");
+        case margelo::nitro::performancetoolkit::AlertCondition::SLOPE_BELOW: return JSIConverter<std::string>::toJSI(runtime, "slope-below");
+        default: [[unlikely]]
+          throw std::invalid_argument("Cannot convert AlertCondition to JS - invalid value: "
+                                    + std::to_string(static_cast<int>(arg)) + "!");
+      }
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isString()) {
+        return false;
+      }
+      std::string unionValue = JSIConverter<std::string>::fromJSI(runtime, value);
+      switch (hashString(unionValue.c_str(), unionValue.size())) {
+        case hashString("above"):
+        case hashString("below"):
+        case hashString("slope-above"):
+        case hashString("slope-below"):
+          return true;
+        default:
+          return false;
+      }
+    }
+  };
+
+} // namespace margelo::nitro
@@ -0,0 +1,93 @@
+///
+/// AlertRule.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/JSIHelpers.hpp>)
+#include <NitroModules/JSIHelpers.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+// Forward declaration of `AlertCondition` to properly resolve imports.
+namespace margelo::nitro::performancetoolkit { enum class AlertCondition; }
+
+#include "AlertCondition.hpp"
+#include <optional>
+
+namespace margelo::nitro::performancetoolkit {
+
+  /**
+   * A struct which can be represented as a JavaScript object (AlertRule).
+   */
+  struct AlertRule {
+  public:
+    double metric     SWIFT_PRIVATE;
+    AlertCondition condition     SWIFT_PRIVATE;
+    double threshold     SWIFT_PRIVATE;
+    std::optional<double> forMs     SWIFT_PRIVATE;
+    std::optional<double> forSamples     SWIFT_PRIVATE;
+
+  public:
+    AlertRule() = default;
+    explicit AlertRule(double metric, AlertCondition condition, double threshold, std::optional<double> forMs, std::optional<double> forSamples): metric(metric), condition(condition), threshold(threshold), forMs(forMs), forSamples(forSamples) {}
+  };
+
+} // namespace margelo::nitro::performancetoolkit
+
+namespace margelo::nitro {
+
+  // C++ AlertRule <> JS AlertRule (object)
+  template <>
+  struct JSIConverter<margelo::nitro::performancetoolkit::AlertRule> final {
+    static inline margelo::nitro::performancetoolkit::AlertRule fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return margelo::nitro::performancetoolkit::AlertRule(
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "metric")),
+        JSIConverter<margelo::nitro::performancetoolkit::AlertCondition>::fromJSI(runtime, obj.getProperty(runtime, "condition")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "threshold")),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "forMs")),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "forSamples"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const margelo::nitro::performancetoolkit::AlertRule& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "metric", JSIConverter<double>::toJSI(runtime, arg.metric));
+      obj.setProperty(runtime, "condition", JSIConverter<margelo::nitro::performancetoolkit::AlertCondition>::toJSI(runtime, arg.condition));
+      obj.setProperty(runtime, "threshold", JSIConverter<double>::toJSI(runtime, arg.threshold));
+      obj.setProperty(runtime, "forMs", JSIConverter<std::optional<double>>::toJSI(runtime, arg.forMs));
+      obj.setProperty(runtime, "forSamples", JSIConverter<std::optional<double>>::toJSI(runtime, arg.forSamples));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!nitro::isPlainObject(runtime, obj)) {
+        return false;
+      }
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "metric"))) return false;
+      if (!JSIConverter<margelo::nitro::performancetoolkit::AlertCondition>::canConvert(runtime, obj.getProperty(runtime, "condition"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "threshold"))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "forMs"))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "forSamples"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
@@ -15,6 +15,16 @@ namespace margelo::nitro::performancetoolkit {
     // load custom methods/properties
     registerHybrids(this, [](Prototype& prototype) {
       prototype.registerHybridMethod("getJsFpsBuffer", &HybridJsFpsTrackingSpec::getJsFpsBuffer);
+      prototype.registerHybridMethod("getJsDroppedFramesBuffer", &HybridJsFpsTrackingSpec::getJsDroppedFramesBuffer);
+      prototype.registerHybridMethod("getJsFrameTimelineBuffer", &HybridJsFpsTrackingSpec::getJsFrameTimelineBuffer);
+      prototype.registerHybridMethod("getJsLagEventsBuffer", &HybridJsFpsTrackingSpec::getJsLagEventsBuffer);
+      prototype.registerHybridMethod("setTrackingMode", &HybridJsFpsTrackingSpec::setTrackingMode);
+      prototype.registerHybridMethod("getTrackingMode", &HybridJsFpsTrackingSpec::getTrackingMode);
+      prototype.registerHybridMethod("setLongTaskThreshold", &HybridJsFpsTrackingSpec::setLongTaskThreshold);
+      prototype.registerHybridMethod("drainLongTasks", &HybridJsFpsTrackingSpec::drainLongTasks);
+      prototype.registerHybridMethod("getRuntimeFpsBuffer", &HybridJsFpsTrackingSpec::getRuntimeFpsBuffer);
+      prototype.registerHybridMethod("getTrackedRuntimes", &HybridJsFpsTrackingSpec::getTrackedRuntimes);
+      prototype.registerHybridMethod("unregisterRuntime", &HybridJsFpsTrackingSpec::unregisterRuntime);
     });
   }
 
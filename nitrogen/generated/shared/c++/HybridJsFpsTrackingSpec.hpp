@@ -15,8 +15,16 @@
 
 // Forward declaration of `ArrayBuffer` to properly resolve imports.
 namespace NitroModules { class ArrayBuffer; }
+// Forward declaration of `JsFpsTrackingMode` to properly resolve imports.
+namespace margelo::nitro::performancetoolkit { enum class JsFpsTrackingMode; }
+// Forward declaration of `LongTask` to properly resolve imports.
+namespace margelo::nitro::performancetoolkit { struct LongTask; }
 
 #include <NitroModules/ArrayBuffer.hpp>
+#include "JsFpsTrackingMode.hpp"
+#include "LongTask.hpp"
+#include <vector>
+#include <string>
 
 namespace margelo::nitro::performancetoolkit {
 
@@ -50,6 +58,16 @@ namespace margelo::nitro::performancetoolkit {
     public:
       // Methods
       virtual std::shared_ptr<ArrayBuffer> getJsFpsBuffer() = 0;
+      virtual std::shared_ptr<ArrayBuffer> getJsDroppedFramesBuffer() = 0;
+      virtual std::shared_ptr<ArrayBuffer> getJsFrameTimelineBuffer() = 0;
+      virtual std::shared_ptr<ArrayBuffer> getJsLagEventsBuffer() = 0;
+      virtual void setTrackingMode(JsFpsTrackingMode mode) = 0;
+      virtual JsFpsTrackingMode getTrackingMode() = 0;
+      virtual void setLongTaskThreshold(double thresholdMs) = 0;
+      virtual std::vector<LongTask> drainLongTasks() = 0;
+      virtual std::shared_ptr<ArrayBuffer> getRuntimeFpsBuffer() = 0;
+      virtual std::vector<std::string> getTrackedRuntimes() = 0;
+      virtual void unregisterRuntime(const std::string& name) = 0;
 
     protected:
       // Hybrid Setup
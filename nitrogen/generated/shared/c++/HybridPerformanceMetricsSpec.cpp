@@ -0,0 +1,39 @@
+///
+/// HybridPerformanceMetricsSpec.cpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#include "HybridPerformanceMetricsSpec.hpp"
+
+namespace margelo::nitro::performancetoolkit {
+
+  void HybridPerformanceMetricsSpec::loadHybridMethods() {
+    // load base methods/properties
+    HybridObject::loadHybridMethods();
+    // load custom methods/properties
+    registerHybrids(this, [](Prototype& prototype) {
+      prototype.registerHybridMethod("getMetricsBuffer", &HybridPerformanceMetricsSpec::getMetricsBuffer);
+      prototype.registerHybridMethod("getThreadCpuUsageBuffer", &HybridPerformanceMetricsSpec::getThreadCpuUsageBuffer);
+      prototype.registerHybridMethod("getMetricPercentiles", &HybridPerformanceMetricsSpec::getMetricPercentiles);
+      prototype.registerHybridMethod("startSessionRecording", &HybridPerformanceMetricsSpec::startSessionRecording);
+      prototype.registerHybridMethod("stopSessionRecording", &HybridPerformanceMetricsSpec::stopSessionRecording);
+      prototype.registerHybridMethod("exportSessionTrace", &HybridPerformanceMetricsSpec::exportSessionTrace);
+      prototype.registerHybridMethod("internTimingName", &HybridPerformanceMetricsSpec::internTimingName);
+      prototype.registerHybridMethod("mark", &HybridPerformanceMetricsSpec::mark);
+      prototype.registerHybridMethod("beginSpan", &HybridPerformanceMetricsSpec::beginSpan);
+      prototype.registerHybridMethod("endSpan", &HybridPerformanceMetricsSpec::endSpan);
+      prototype.registerHybridMethod("addMetricsListener", &HybridPerformanceMetricsSpec::addMetricsListener);
+      prototype.registerHybridMethod("addUiMetricsListener", &HybridPerformanceMetricsSpec::addUiMetricsListener);
+      prototype.registerHybridMethod("removeMetricsListener", &HybridPerformanceMetricsSpec::removeMetricsListener);
+      prototype.registerHybridMethod("addAlertRule", &HybridPerformanceMetricsSpec::addAlertRule);
+      prototype.registerHybridMethod("removeAlertRule", &HybridPerformanceMetricsSpec::removeAlertRule);
+      prototype.registerHybridMethod("getOverheadStats", &HybridPerformanceMetricsSpec::getOverheadStats);
+      prototype.registerHybridMethod("setSamplingProfile", &HybridPerformanceMetricsSpec::setSamplingProfile);
+      prototype.registerHybridMethod("getSamplingConfig", &HybridPerformanceMetricsSpec::getSamplingConfig);
+      prototype.registerHybridMethod("getStartupTimeline", &HybridPerformanceMetricsSpec::getStartupTimeline);
+    });
+  }
+
+} // namespace margelo::nitro::performancetoolkit
@@ -0,0 +1,110 @@
+///
+/// HybridPerformanceMetricsSpec.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/HybridObject.hpp>)
+#include <NitroModules/HybridObject.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+// Forward declaration of `ArrayBuffer` to properly resolve imports.
+namespace NitroModules { class ArrayBuffer; }
+// Forward declaration of `MetricPercentiles` to properly resolve imports.
+namespace margelo::nitro::performancetoolkit { struct MetricPercentiles; }
+// Forward declaration of `AlertRule` to properly resolve imports.
+namespace margelo::nitro::performancetoolkit { struct AlertRule; }
+// Forward declaration of `Alert` to properly resolve imports.
+namespace margelo::nitro::performancetoolkit { struct Alert; }
+// Forward declaration of `OverheadStats` to properly resolve imports.
+namespace margelo::nitro::performancetoolkit { struct OverheadStats; }
+// Forward declaration of `SamplingConfig` to properly resolve imports.
+namespace margelo::nitro::performancetoolkit { struct SamplingConfig; }
+// Forward declaration of `SamplingProfile` to properly resolve imports.
+namespace margelo::nitro::performancetoolkit { enum class SamplingProfile; }
+// Forward declaration of `SamplingOverrides` to properly resolve imports.
+namespace margelo::nitro::performancetoolkit { struct SamplingOverrides; }
+// Forward declaration of `StartupTimeline` to properly resolve imports.
+namespace margelo::nitro::performancetoolkit { struct StartupTimeline; }
+
+#include <NitroModules/ArrayBuffer.hpp>
+#include "MetricPercentiles.hpp"
+#include <string>
+#include <optional>
+#include <NitroModules/Promise.hpp>
+#include <functional>
+#include <vector>
+#include "AlertRule.hpp"
+#include "Alert.hpp"
+#include "OverheadStats.hpp"
+#include "SamplingConfig.hpp"
+#include "SamplingProfile.hpp"
+#include "SamplingOverrides.hpp"
+#include "StartupTimeline.hpp"
+
+namespace margelo::nitro::performancetoolkit {
+
+  using namespace margelo::nitro;
+
+  /**
+   * An abstract base class for `PerformanceMetrics`
+   * Inherit this class to create instances of `HybridPerformanceMetricsSpec` in C++.
+   * You must explicitly call `HybridObject`'s constructor yourself, because it is virtual.
+   * @example
+   * ```cpp
+   * class HybridPerformanceMetrics: public HybridPerformanceMetricsSpec {
+   * public:
+   *   HybridPerformanceMetrics(...): HybridObject(TAG) { ... }
+   *   // ...
+   * };
+   * ```
+   */
+  class HybridPerformanceMetricsSpec: public virtual HybridObject {
+    public:
+      // Constructor
+      explicit HybridPerformanceMetricsSpec(): HybridObject(TAG) { }
+
+      // Destructor
+      ~HybridPerformanceMetricsSpec() override = default;
+
+    public:
+      // Properties
+      
+
+    public:
+      // Methods
+      virtual std::shared_ptr<ArrayBuffer> getMetricsBuffer() = 0;
+      virtual std::shared_ptr<ArrayBuffer> getThreadCpuUsageBuffer() = 0;
+      virtual MetricPercentiles getMetricPercentiles(double windowSeconds) = 0;
+      virtual std::shared_ptr<Promise<std::string>> startSessionRecording(const std::optional<std::string>& path) = 0;
+      virtual std::shared_ptr<Promise<std::optional<std::string>>> stopSessionRecording() = 0;
+      virtual std::shared_ptr<Promise<std::string>> exportSessionTrace(const std::string& sessionPath, const std::optional<std::string>& tracePath) = 0;
+      virtual double internTimingName(const std::string& name) = 0;
+      virtual void mark(double nameId) = 0;
+      virtual void beginSpan(double nameId) = 0;
+      virtual void endSpan(double nameId) = 0;
+      virtual double addMetricsListener(const std::function<void(double /* changedSlots */)>& listener, const std::optional<std::vector<double>>& minChanges) = 0;
+      virtual double addUiMetricsListener() = 0;
+      virtual void removeMetricsListener(double listenerId) = 0;
+      virtual double addAlertRule(const AlertRule& rule, const std::function<void(const Alert& /* alert */)>& onAlert) = 0;
+      virtual void removeAlertRule(double ruleId) = 0;
+      virtual OverheadStats getOverheadStats() = 0;
+      virtual SamplingConfig setSamplingProfile(SamplingProfile profile, const std::optional<SamplingOverrides>& overrides) = 0;
+      virtual SamplingConfig getSamplingConfig() = 0;
+      virtual StartupTimeline getStartupTimeline() = 0;
+
+    protected:
+      // Hybrid Setup
+      void loadHybridMethods() override;
+
+    protected:
+      // Tag for logging
+      static constexpr auto TAG = "PerformanceMetrics";
+  };
+
+} // namespace margelo::nitro::performancetoolkit
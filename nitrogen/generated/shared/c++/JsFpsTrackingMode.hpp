@@ -0,0 +1,76 @@
+///
+/// JsFpsTrackingMode.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/NitroHash.hpp>)
+#include <NitroModules/NitroHash.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+namespace margelo::nitro::performancetoolkit {
+
+  /**
+   * An enum which can be represented as a JavaScript union (JsFpsTrackingMode).
+   */
+  enum class JsFpsTrackingMode {
+    CONTINUOUS      SWIFT_NAME(continuous) = 0,
+    ON_DEMAND      SWIFT_NAME(onDemand) = 1,
+  } CLOSED_ENUM;
+
+} // namespace margelo::nitro::performancetoolkit
+
+namespace margelo::nitro {
+
+  // C++ JsFpsTrackingMode <> JS JsFpsTrackingMode (union)
+  template <>
+  struct JSIConverter<margelo::nitro::performancetoolkit::JsFpsTrackingMode> final {
+    static inline margelo::nitro::performancetoolkit::JsFpsTrackingMode fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      std::string unionValue = JSIConverter<std::string>::fromJSI(runtime, arg);
+      switch (hashString(unionValue.c_str(), unionValue.size())) {
+        case hashString("continuous"): return margelo::nitro::performancetoolkit::JsFpsTrackingMode::CONTINUOUS;
+        case hashString("on-demand"): return margelo::nitro::performancetoolkit::JsFpsTrackingMode::ON_DEMAND;
+        default: [[unlikely]]
+          throw std::invalid_argument("Cannot convert \"" + unionValue + "\" to enum JsFpsTrackingMode - invalid value!");
+      }
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, margelo::nitro::performancetoolkit::JsFpsTrackingMode arg) {
+      switch (arg) {
+        case margelo::nitro::performancetoolkit::JsFpsTrackingMode::CONTINUOUS: return JSIConverter<std::string>::toJSI(runtime, "continuous");
+        case margelo::nitro::performancetoolkit::JsFpsTrackingMode::ON_DEMAND: return JSIConverter<std::string>::toJSI(runtime, "on-demand");
+        default: [[unlikely]]
+          throw std::invalid_argument("Cannot convert JsFpsTrackingMode to JS - invalid value: "
+                                    + std::to_string(static_cast<int>(arg)) + "!");
+      }
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isString()) {
+        return false;
+      }
+      std::string unionValue = JSIConverter<std::string>::fromJSI(runtime, value);
+      switch (hashString(unionValue.c_str(), unionValue.size())) {
+        case hashString("continuous"):
+        case hashString("on-demand"):
+          return true;
+        default:
+          return false;
+      }
+    }
+  };
+
+} // namespace margelo::nitro
@@ -0,0 +1,84 @@
+///
+/// LongTask.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/JSIHelpers.hpp>)
+#include <NitroModules/JSIHelpers.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+
+
+#include <string>
+#include <optional>
+
+namespace margelo::nitro::performancetoolkit {
+
+  /**
+   * A struct which can be represented as a JavaScript object (LongTask).
+   */
+  struct LongTask {
+  public:
+    double startMs     SWIFT_PRIVATE;
+    double durationMs     SWIFT_PRIVATE;
+    std::optional<std::string> sampledTrace     SWIFT_PRIVATE;
+
+  public:
+    LongTask() = default;
+    explicit LongTask(double startMs, double durationMs, std::optional<std::string> sampledTrace): startMs(startMs), durationMs(durationMs), sampledTrace(sampledTrace) {}
+  };
+
+} // namespace margelo::nitro::performancetoolkit
+
+namespace margelo::nitro {
+
+  // C++ LongTask <> JS LongTask (object)
+  template <>
+  struct JSIConverter<margelo::nitro::performancetoolkit::LongTask> final {
+    static inline margelo::nitro::performancetoolkit::LongTask fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return margelo::nitro::performancetoolkit::LongTask(
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "startMs")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "durationMs")),
+        JSIConverter<std::optional<std::string>>::fromJSI(runtime, obj.getProperty(runtime, "sampledTrace"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const margelo::nitro::performancetoolkit::LongTask& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "startMs", JSIConverter<double>::toJSI(runtime, arg.startMs));
+      obj.setProperty(runtime, "durationMs", JSIConverter<double>::toJSI(runtime, arg.durationMs));
+      obj.setProperty(runtime, "sampledTrace", JSIConverter<std::optional<std::string>>::toJSI(runtime, arg.sampledTrace));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!nitro::isPlainObject(runtime, obj)) {
+        return false;
+      }
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "startMs"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "durationMs"))) return false;
+      if (!JSIConverter<std::optional<std::string>>::canConvert(runtime, obj.getProperty(runtime, "sampledTrace"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
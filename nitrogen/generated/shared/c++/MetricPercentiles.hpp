@@ -0,0 +1,96 @@
+///
+/// MetricPercentiles.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/JSIHelpers.hpp>)
+#include <NitroModules/JSIHelpers.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+// Forward declaration of `Percentiles` to properly resolve imports.
+namespace margelo::nitro::performancetoolkit { struct Percentiles; }
+
+#include "Percentiles.hpp"
+
+namespace margelo::nitro::performancetoolkit {
+
+  /**
+   * A struct which can be represented as a JavaScript object (MetricPercentiles).
+   */
+  struct MetricPercentiles {
+  public:
+    Percentiles jsLatencyMs     SWIFT_PRIVATE;
+    Percentiles jsFps     SWIFT_PRIVATE;
+    Percentiles uiFps     SWIFT_PRIVATE;
+    Percentiles cpuUsage     SWIFT_PRIVATE;
+    Percentiles memoryUsage     SWIFT_PRIVATE;
+    Percentiles uiFrameTimeMs     SWIFT_PRIVATE;
+
+  public:
+    MetricPercentiles() = default;
+    explicit MetricPercentiles(Percentiles jsLatencyMs, Percentiles jsFps, Percentiles uiFps, Percentiles cpuUsage, Percentiles memoryUsage, Percentiles uiFrameTimeMs): jsLatencyMs(jsLatencyMs), jsFps(jsFps), uiFps(uiFps), cpuUsage(cpuUsage), memoryUsage(memoryUsage), uiFrameTimeMs(uiFrameTimeMs) {}
+  };
+
+} // namespace margelo::nitro::performancetoolkit
+
+namespace margelo::nitro {
+
+  // C++ MetricPercentiles <> JS MetricPercentiles (object)
+  template <>
+  struct JSIConverter<margelo::nitro::performancetoolkit::MetricPercentiles> final {
+    static inline margelo::nitro::performancetoolkit::MetricPercentiles fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return margelo::nitro::performancetoolkit::MetricPercentiles(
+        JSIConverter<margelo::nitro::performancetoolkit::Percentiles>::fromJSI(runtime, obj.getProperty(runtime, "jsLatencyMs")),
+        JSIConverter<margelo::nitro::performancetoolkit::Percentiles>::fromJSI(runtime, obj.getProperty(runtime, "jsFps")),
+        JSIConverter<margelo::nitro::performancetoolkit::Percentiles>::fromJSI(runtime, obj.getProperty(runtime, "uiFps")),
+        JSIConverter<margelo::nitro::performancetoolkit::Percentiles>::fromJSI(runtime, obj.getProperty(runtime, "cpuUsage")),
+        JSIConverter<margelo::nitro::performancetoolkit::Percentiles>::fromJSI(runtime, obj.getProperty(runtime, "memoryUsage")),
+        JSIConverter<margelo::nitro::performancetoolkit::Percentiles>::fromJSI(runtime, obj.getProperty(runtime, "uiFrameTimeMs"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const margelo::nitro::performancetoolkit::MetricPercentiles& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "jsLatencyMs", JSIConverter<margelo::nitro::performancetoolkit::Percentiles>::toJSI(runtime, arg.jsLatencyMs));
+      obj.setProperty(runtime, "jsFps", JSIConverter<margelo::nitro::performancetoolkit::Percentiles>::toJSI(runtime, arg.jsFps));
+      obj.setProperty(runtime, "uiFps", JSIConverter<margelo::nitro::performancetoolkit::Percentiles>::toJSI(runtime, arg.uiFps));
+      obj.setProperty(runtime, "cpuUsage", JSIConverter<margelo::nitro::performancetoolkit::Percentiles>::toJSI(runtime, arg.cpuUsage));
+      obj.setProperty(runtime, "memoryUsage", JSIConverter<margelo::nitro::performancetoolkit::Percentiles>::toJSI(runtime, arg.memoryUsage));
+      obj.setProperty(runtime, "uiFrameTimeMs", JSIConverter<margelo::nitro::performancetoolkit::Percentiles>::toJSI(runtime, arg.uiFrameTimeMs));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!nitro::isPlainObject(runtime, obj)) {
+        return false;
+      }
+      if (!JSIConverter<margelo::nitro::performancetoolkit::Percentiles>::canConvert(runtime, obj.getProperty(runtime, "jsLatencyMs"))) return false;
+      if (!JSIConverter<margelo::nitro::performancetoolkit::Percentiles>::canConvert(runtime, obj.getProperty(runtime, "jsFps"))) return false;
+      if (!JSIConverter<margelo::nitro::performancetoolkit::Percentiles>::canConvert(runtime, obj.getProperty(runtime, "uiFps"))) return false;
+      if (!JSIConverter<margelo::nitro::performancetoolkit::Percentiles>::canConvert(runtime, obj.getProperty(runtime, "cpuUsage"))) return false;
+      if (!JSIConverter<margelo::nitro::performancetoolkit::Percentiles>::canConvert(runtime, obj.getProperty(runtime, "memoryUsage"))) return false;
+      if (!JSIConverter<margelo::nitro::performancetoolkit::Percentiles>::canConvert(runtime, obj.getProperty(runtime, "uiFrameTimeMs"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
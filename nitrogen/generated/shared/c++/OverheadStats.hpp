@@ -0,0 +1,101 @@
+///
+/// OverheadStats.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/JSIHelpers.hpp>)
+#include <NitroModules/JSIHelpers.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+
+
+namespace margelo::nitro::performancetoolkit {
+
+  /**
+   * A struct which can be represented as a JavaScript object (OverheadStats).
+   */
+  struct OverheadStats {
+  public:
+    double schedulerCpuMs     SWIFT_PRIVATE;
+    double sessionWriterCpuMs     SWIFT_PRIVATE;
+    double jsTaskMs     SWIFT_PRIVATE;
+    double uiFrameMs     SWIFT_PRIVATE;
+    double jsTasks     SWIFT_PRIVATE;
+    double wakeups     SWIFT_PRIVATE;
+    double jsiCalls     SWIFT_PRIVATE;
+    double measuredForMs     SWIFT_PRIVATE;
+
+  public:
+    OverheadStats() = default;
+    explicit OverheadStats(double schedulerCpuMs, double sessionWriterCpuMs, double jsTaskMs, double uiFrameMs, double jsTasks, double wakeups, double jsiCalls, double measuredForMs): schedulerCpuMs(schedulerCpuMs), sessionWriterCpuMs(sessionWriterCpuMs), jsTaskMs(jsTaskMs), uiFrameMs(uiFrameMs), jsTasks(jsTasks), wakeups(wakeups), jsiCalls(jsiCalls), measuredForMs(measuredForMs) {}
+  };
+
+} // namespace margelo::nitro::performancetoolkit
+
+namespace margelo::nitro {
+
+  // C++ OverheadStats <> JS OverheadStats (object)
+  template <>
+  struct JSIConverter<margelo::nitro::performancetoolkit::OverheadStats> final {
+    static inline margelo::nitro::performancetoolkit::OverheadStats fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return margelo::nitro::performancetoolkit::OverheadStats(
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "schedulerCpuMs")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "sessionWriterCpuMs")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "jsTaskMs")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "uiFrameMs")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "jsTasks")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "wakeups")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "jsiCalls")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "measuredForMs"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const margelo::nitro::performancetoolkit::OverheadStats& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "schedulerCpuMs", JSIConverter<double>::toJSI(runtime, arg.schedulerCpuMs));
+      obj.setProperty(runtime, "sessionWriterCpuMs", JSIConverter<double>::toJSI(runtime, arg.sessionWriterCpuMs));
+      obj.setProperty(runtime, "jsTaskMs", JSIConverter<double>::toJSI(runtime, arg.jsTaskMs));
+      obj.setProperty(runtime, "uiFrameMs", JSIConverter<double>::toJSI(runtime, arg.uiFrameMs));
+      obj.setProperty(runtime, "jsTasks", JSIConverter<double>::toJSI(runtime, arg.jsTasks));
+      obj.setProperty(runtime, "wakeups", JSIConverter<double>::toJSI(runtime, arg.wakeups));
+      obj.setProperty(runtime, "jsiCalls", JSIConverter<double>::toJSI(runtime, arg.jsiCalls));
+      obj.setProperty(runtime, "measuredForMs", JSIConverter<double>::toJSI(runtime, arg.measuredForMs));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!nitro::isPlainObject(runtime, obj)) {
+        return false;
+      }
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "schedulerCpuMs"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "sessionWriterCpuMs"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "jsTaskMs"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "uiFrameMs"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "jsTasks"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "wakeups"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "jsiCalls"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "measuredForMs"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
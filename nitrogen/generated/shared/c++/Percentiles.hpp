@@ -0,0 +1,89 @@
+///
+/// Percentiles.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/JSIHelpers.hpp>)
+#include <NitroModules/JSIHelpers.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+
+
+namespace margelo::nitro::performancetoolkit {
+
+  /**
+   * A struct which can be represented as a JavaScript object (Percentiles).
+   */
+  struct Percentiles {
+  public:
+    double p50     SWIFT_PRIVATE;
+    double p90     SWIFT_PRIVATE;
+    double p99     SWIFT_PRIVATE;
+    double max     SWIFT_PRIVATE;
+    double count     SWIFT_PRIVATE;
+
+  public:
+    Percentiles() = default;
+    explicit Percentiles(double p50, double p90, double p99, double max, double count): p50(p50), p90(p90), p99(p99), max(max), count(count) {}
+  };
+
+} // namespace margelo::nitro::performancetoolkit
+
+namespace margelo::nitro {
+
+  // C++ Percentiles <> JS Percentiles (object)
+  template <>
+  struct JSIConverter<margelo::nitro::performancetoolkit::Percentiles> final {
+    static inline margelo::nitro::performancetoolkit::Percentiles fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return margelo::nitro::performancetoolkit::Percentiles(
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "p50")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "p90")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "p99")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "max")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "count"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const margelo::nitro::performancetoolkit::Percentiles& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "p50", JSIConverter<double>::toJSI(runtime, arg.p50));
+      obj.setProperty(runtime, "p90", JSIConverter<double>::toJSI(runtime, arg.p90));
+      obj.setProperty(runtime, "p99", JSIConverter<double>::toJSI(runtime, arg.p99));
+      obj.setProperty(runtime, "max", JSIConverter<double>::toJSI(runtime, arg.max));
+      obj.setProperty(runtime, "count", JSIConverter<double>::toJSI(runtime, arg.count));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!nitro::isPlainObject(runtime, obj)) {
+        return false;
+      }
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "p50"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "p90"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "p99"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "max"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "count"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
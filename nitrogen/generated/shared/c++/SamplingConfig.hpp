@@ -0,0 +1,104 @@
+///
+/// SamplingConfig.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/JSIHelpers.hpp>)
+#include <NitroModules/JSIHelpers.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+// Forward declaration of `SamplingProfile` to properly resolve imports.
+namespace margelo::nitro::performancetoolkit { enum class SamplingProfile; }
+
+#include "SamplingProfile.hpp"
+
+namespace margelo::nitro::performancetoolkit {
+
+  /**
+   * A struct which can be represented as a JavaScript object (SamplingConfig).
+   */
+  struct SamplingConfig {
+  public:
+    SamplingProfile profile     SWIFT_PRIVATE;
+    double jsFpsWindowMs     SWIFT_PRIVATE;
+    double uiFpsWindowMs     SWIFT_PRIVATE;
+    double cpuIntervalMs     SWIFT_PRIVATE;
+    double memoryIntervalMs     SWIFT_PRIVATE;
+    double jsHeapIntervalMs     SWIFT_PRIVATE;
+    double counterUpdateIntervalMs     SWIFT_PRIVATE;
+    bool frameTimeline     SWIFT_PRIVATE;
+
+  public:
+    SamplingConfig() = default;
+    explicit SamplingConfig(SamplingProfile profile, double jsFpsWindowMs, double uiFpsWindowMs, double cpuIntervalMs, double memoryIntervalMs, double jsHeapIntervalMs, double counterUpdateIntervalMs, bool frameTimeline): profile(profile), jsFpsWindowMs(jsFpsWindowMs), uiFpsWindowMs(uiFpsWindowMs), cpuIntervalMs(cpuIntervalMs), memoryIntervalMs(memoryIntervalMs), jsHeapIntervalMs(jsHeapIntervalMs), counterUpdateIntervalMs(counterUpdateIntervalMs), frameTimeline(frameTimeline) {}
+  };
+
+} // namespace margelo::nitro::performancetoolkit
+
+namespace margelo::nitro {
+
+  // C++ SamplingConfig <> JS SamplingConfig (object)
+  template <>
+  struct JSIConverter<margelo::nitro::performancetoolkit::SamplingConfig> final {
+    static inline margelo::nitro::performancetoolkit::SamplingConfig fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return margelo::nitro::performancetoolkit::SamplingConfig(
+        JSIConverter<margelo::nitro::performancetoolkit::SamplingProfile>::fromJSI(runtime, obj.getProperty(runtime, "profile")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "jsFpsWindowMs")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "uiFpsWindowMs")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "cpuIntervalMs")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "memoryIntervalMs")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "jsHeapIntervalMs")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "counterUpdateIntervalMs")),
+        JSIConverter<bool>::fromJSI(runtime, obj.getProperty(runtime, "frameTimeline"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const margelo::nitro::performancetoolkit::SamplingConfig& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "profile", JSIConverter<margelo::nitro::performancetoolkit::SamplingProfile>::toJSI(runtime, arg.profile));
+      obj.setProperty(runtime, "jsFpsWindowMs", JSIConverter<double>::toJSI(runtime, arg.jsFpsWindowMs));
+      obj.setProperty(runtime, "uiFpsWindowMs", JSIConverter<double>::toJSI(runtime, arg.uiFpsWindowMs));
+      obj.setProperty(runtime, "cpuIntervalMs", JSIConverter<double>::toJSI(runtime, arg.cpuIntervalMs));
+      obj.setProperty(runtime, "memoryIntervalMs", JSIConverter<double>::toJSI(runtime, arg.memoryIntervalMs));
+      obj.setProperty(runtime, "jsHeapIntervalMs", JSIConverter<double>::toJSI(runtime, arg.jsHeapIntervalMs));
+      obj.setProperty(runtime, "counterUpdateIntervalMs", JSIConverter<double>::toJSI(runtime, arg.counterUpdateIntervalMs));
+      obj.setProperty(runtime, "frameTimeline", JSIConverter<bool>::toJSI(runtime, arg.frameTimeline));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!nitro::isPlainObject(runtime, obj)) {
+        return false;
+      }
+      if (!JSIConverter<margelo::nitro::performancetoolkit::SamplingProfile>::canConvert(runtime, obj.getProperty(runtime, "profile"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "jsFpsWindowMs"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "uiFpsWindowMs"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "cpuIntervalMs"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "memoryIntervalMs"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "jsHeapIntervalMs"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "counterUpdateIntervalMs"))) return false;
+      if (!JSIConverter<bool>::canConvert(runtime, obj.getProperty(runtime, "frameTimeline"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
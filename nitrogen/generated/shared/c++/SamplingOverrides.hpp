@@ -0,0 +1,97 @@
+///
+/// SamplingOverrides.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/JSIHelpers.hpp>)
+#include <NitroModules/JSIHelpers.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+#include <optional>
+
+namespace margelo::nitro::performancetoolkit {
+
+  /**
+   * A struct which can be represented as a JavaScript object (SamplingOverrides).
+   */
+  struct SamplingOverrides {
+  public:
+    std::optional<double> jsFpsWindowMs     SWIFT_PRIVATE;
+    std::optional<double> uiFpsWindowMs     SWIFT_PRIVATE;
+    std::optional<double> cpuIntervalMs     SWIFT_PRIVATE;
+    std::optional<double> memoryIntervalMs     SWIFT_PRIVATE;
+    std::optional<double> jsHeapIntervalMs     SWIFT_PRIVATE;
+    std::optional<double> counterUpdateIntervalMs     SWIFT_PRIVATE;
+    std::optional<bool> frameTimeline     SWIFT_PRIVATE;
+
+  public:
+    SamplingOverrides() = default;
+    explicit SamplingOverrides(std::optional<double> jsFpsWindowMs, std::optional<double> uiFpsWindowMs, std::optional<double> cpuIntervalMs, std::optional<double> memoryIntervalMs, std::optional<double> jsHeapIntervalMs, std::optional<double> counterUpdateIntervalMs, std::optional<bool> frameTimeline): jsFpsWindowMs(jsFpsWindowMs), uiFpsWindowMs(uiFpsWindowMs), cpuIntervalMs(cpuIntervalMs), memoryIntervalMs(memoryIntervalMs), jsHeapIntervalMs(jsHeapIntervalMs), counterUpdateIntervalMs(counterUpdateIntervalMs), frameTimeline(frameTimeline) {}
+  };
+
+} // namespace margelo::nitro::performancetoolkit
+
+namespace margelo::nitro {
+
+  // C++ SamplingOverrides <> JS SamplingOverrides (object)
+  template <>
+  struct JSIConverter<margelo::nitro::performancetoolkit::SamplingOverrides> final {
+    static inline margelo::nitro::performancetoolkit::SamplingOverrides fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return margelo::nitro::performancetoolkit::SamplingOverrides(
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "jsFpsWindowMs")),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "uiFpsWindowMs")),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "cpuIntervalMs")),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "memoryIntervalMs")),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "jsHeapIntervalMs")),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "counterUpdateIntervalMs")),
+        JSIConverter<std::optional<bool>>::fromJSI(runtime, obj.getProperty(runtime, "frameTimeline"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const margelo::nitro::performancetoolkit::SamplingOverrides& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "jsFpsWindowMs", JSIConverter<std::optional<double>>::toJSI(runtime, arg.jsFpsWindowMs));
+      obj.setProperty(runtime, "uiFpsWindowMs", JSIConverter<std::optional<double>>::toJSI(runtime, arg.uiFpsWindowMs));
+      obj.setProperty(runtime, "cpuIntervalMs", JSIConverter<std::optional<double>>::toJSI(runtime, arg.cpuIntervalMs));
+      obj.setProperty(runtime, "memoryIntervalMs", JSIConverter<std::optional<double>>::toJSI(runtime, arg.memoryIntervalMs));
+      obj.setProperty(runtime, "jsHeapIntervalMs", JSIConverter<std::optional<double>>::toJSI(runtime, arg.jsHeapIntervalMs));
+      obj.setProperty(runtime, "counterUpdateIntervalMs", JSIConverter<std::optional<double>>::toJSI(runtime, arg.counterUpdateIntervalMs));
+      obj.setProperty(runtime, "frameTimeline", JSIConverter<std::optional<bool>>::toJSI(runtime, arg.frameTimeline));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!nitro::isPlainObject(runtime, obj)) {
+        return false;
+      }
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "jsFpsWindowMs"))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "uiFpsWindowMs"))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "cpuIntervalMs"))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "memoryIntervalMs"))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "jsHeapIntervalMs"))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "counterUpdateIntervalMs"))) return false;
+      if (!JSIConverter<std::optional<bool>>::canConvert(runtime, obj.getProperty(runtime, "frameTimeline"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
@@ -0,0 +1,84 @@
+///
+/// SamplingProfile.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/NitroHash.hpp>)
+#include <NitroModules/NitroHash.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+namespace margelo::nitro::performancetoolkit {
+
+  /**
+   * An enum which can be represented as a JavaScript union (SamplingProfile).
+   */
+  enum class SamplingProfile {
+    OFF      SWIFT_NAME(off) = 0,
+    PRODUCTION      SWIFT_NAME(production) = 1,
+    QA      SWIFT_NAME(qa) = 2,
+    PROFILING      SWIFT_NAME(profiling) = 3,
+  } CLOSED_ENUM;
+
+} // namespace margelo::nitro::performancetoolkit
+
+namespace margelo::nitro {
+
+  // C++ SamplingProfile <> JS SamplingProfile (union)
+  template <>
+  struct JSIConverter<margelo::nitro::performancetoolkit::SamplingProfile> final {
+    static inline margelo::nitro::performancetoolkit::SamplingProfile fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      std::string unionValue = JSIConverter<std::string>::fromJSI(runtime, arg);
+      switch (hashString(unionValue.c_str(), unionValue.size())) {
+        case hashString("off"): return margelo::nitro::performancetoolkit::SamplingProfile::OFF;
+        case hashString("production"): return margelo::nitro::performancetoolkit::SamplingProfile::PRODUCTION;
+        case hashString("qa"): return margelo::nitro::performancetoolkit::SamplingProfile::QA;
+        case hashString("profiling"): return margelo::nitro::performancetoolkit::SamplingProfile::PROFILING;
+        default: [[unlikely]]
+          throw std::invalid_argument("Cannot convert \"" + unionValue + "\" to enum SamplingProfile - invalid value!");
+      }
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, margelo::nitro::performancetoolkit::SamplingProfile arg) {
+      switch (arg) {
+        case margelo::nitro::performancetoolkit::SamplingProfile::OFF: return JSIConverter<std::string>::toJSI(runtime, "off");
+        case margelo::nitro::performancetoolkit::SamplingProfile::PRODUCTION: return JSIConverter<std::string>::toJSI(runtime, "production");
+        case margelo::nitro::performancetoolkit::SamplingProfile::QA: return JSIConverter<std::string>::toJSI(runtime, "qa");
+        case margelo::nitro::performancetoolkit::SamplingProfile::PROFILING: return JSIConverter<std::string>::toJSI(runtime, "profiling");
+        default: [[unlikely]]
+          throw std::invalid_argument("Cannot convert SamplingProfile to JS - invalid value: "
+                                    + std::to_string(static_cast<int>(arg)) + "!");
+      }
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isString()) {
+        return false;
+      }
+      std::string unionValue = JSIConverter<std::string>::fromJSI(runtime, value);
+      switch (hashString(unionValue.c_str(), unionValue.size())) {
+        case hashString("off"):
+        case hashString("production"):
+        case hashString("qa"):
+        case hashString("profiling"):
+          return true;
+        default:
+          return false;
+      }
+    }
+  };
+
+} // namespace margelo::nitro
@@ -0,0 +1,91 @@
+///
+/// StartupTimeline.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/JSIHelpers.hpp>)
+#include <NitroModules/JSIHelpers.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+namespace margelo::nitro::performancetoolkit {
+
+  /**
+   * A struct which can be represented as a JavaScript object (StartupTimeline).
+   */
+  struct StartupTimeline {
+  public:
+    double processStartMs     SWIFT_PRIVATE;
+    double nativeLibraryLoadedMs     SWIFT_PRIVATE;
+    double runtimeCreatedMs     SWIFT_PRIVATE;
+    double bindingsInstalledMs     SWIFT_PRIVATE;
+    double firstJsTickMs     SWIFT_PRIVATE;
+    double firstUiFrameMs     SWIFT_PRIVATE;
+
+  public:
+    StartupTimeline() = default;
+    explicit StartupTimeline(double processStartMs, double nativeLibraryLoadedMs, double runtimeCreatedMs, double bindingsInstalledMs, double firstJsTickMs, double firstUiFrameMs): processStartMs(processStartMs), nativeLibraryLoadedMs(nativeLibraryLoadedMs), runtimeCreatedMs(runtimeCreatedMs), bindingsInstalledMs(bindingsInstalledMs), firstJsTickMs(firstJsTickMs), firstUiFrameMs(firstUiFrameMs) {}
+  };
+
+} // namespace margelo::nitro::performancetoolkit
+
+namespace margelo::nitro {
+
+  // C++ StartupTimeline <> JS StartupTimeline (object)
+  template <>
+  struct JSIConverter<margelo::nitro::performancetoolkit::StartupTimeline> final {
+    static inline margelo::nitro::performancetoolkit::StartupTimeline fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return margelo::nitro::performancetoolkit::StartupTimeline(
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "processStartMs")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "nativeLibraryLoadedMs")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "runtimeCreatedMs")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "bindingsInstalledMs")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "firstJsTickMs")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "firstUiFrameMs"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const margelo::nitro::performancetoolkit::StartupTimeline& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "processStartMs", JSIConverter<double>::toJSI(runtime, arg.processStartMs));
+      obj.setProperty(runtime, "nativeLibraryLoadedMs", JSIConverter<double>::toJSI(runtime, arg.nativeLibraryLoadedMs));
+      obj.setProperty(runtime, "runtimeCreatedMs", JSIConverter<double>::toJSI(runtime, arg.runtimeCreatedMs));
+      obj.setProperty(runtime, "bindingsInstalledMs", JSIConverter<double>::toJSI(runtime, arg.bindingsInstalledMs));
+      obj.setProperty(runtime, "firstJsTickMs", JSIConverter<double>::toJSI(runtime, arg.firstJsTickMs));
+      obj.setProperty(runtime, "firstUiFrameMs", JSIConverter<double>::toJSI(runtime, arg.firstUiFrameMs));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!nitro::isPlainObject(runtime, obj)) {
+        return false;
+      }
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "processStartMs"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "nativeLibraryLoadedMs"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "runtimeCreatedMs"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "bindingsInstalledMs"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "firstJsTickMs"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "firstUiFrameMs"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
@@ -0,0 +1,116 @@
+import { readJsFrameTimeline } from '../jsFrameTimeline'
+
+jest.mock('../hybrids', () => ({}))
+
+// Same layout as cpp/JsFrameTimeline.hpp
+const HEADER_SIZE = 16
+const RECORD_SIZE = 24
+const CAPACITY = 8
+
+class FakeProducer {
+  readonly buffer = new ArrayBuffer(HEADER_SIZE + CAPACITY * RECORD_SIZE)
+  private readonly view = new DataView(this.buffer)
+  writeIndex = 0
+
+  constructor() {
+    this.view.setUint32(0, CAPACITY, true)
+    this.view.setUint32(4, RECORD_SIZE, true)
+  }
+
+  // Writes the record without publishing it, like the native producer before its release store
+  beginPush(scheduledMs: number, ranMs: number) {
+    const offset = HEADER_SIZE + (this.writeIndex % CAPACITY) * RECORD_SIZE
+    this.view.setFloat64(offset, scheduledMs, true)
+    this.view.setFloat64(offset + 8, ranMs, true)
+    this.view.setFloat64(offset + 16, ranMs - scheduledMs, true)
+  }
+
+  publish() {
+    this.writeIndex++
+    this.view.setUint32(8, this.writeIndex, true)
+  }
+
+  push(scheduledMs: number, ranMs: number) {
+    this.beginPush(scheduledMs, ranMs)
+    this.publish()
+  }
+}
+
+// Runs `onRead` once, right after the reader copied the first field of the first record
+const interruptFirstRecordRead = (onRead: () => void) => {
+  const getFloat64 = DataView.prototype.getFloat64
+  let interrupted = false
+  return jest
+    .spyOn(DataView.prototype, 'getFloat64')
+    .mockImplementation(function (
+      this: DataView,
+      byteOffset: number,
+      littleEndian?: boolean
+    ) {
+      const value = getFloat64.call(this, byteOffset, littleEndian)
+      if (!interrupted && byteOffset === HEADER_SIZE) {
+        interrupted = true
+        onRead()
+      }
+      return value
+    })
+}
+
+const expectNoTornRecords = (
+  records: ReturnType<typeof readJsFrameTimeline>['records']
+) => {
+  for (const record of records) {
+    expect(record.latencyMs).toBe(record.ranMs - record.scheduledMs)
+  }
+}
+
+describe('readJsFrameTimeline', () => {
+  afterEach(() => {
+    jest.restoreAllMocks()
+  })
+
+  it('reads every record written since fromIndex', () => {
+    const producer = new FakeProducer()
+    for (let i = 0; i < 5; i++) {
+      producer.push(i * 16, i * 16 + 1)
+    }
+    const chunk = readJsFrameTimeline(producer.buffer, 2)
+    expect(chunk.records.map((record) => record.scheduledMs)).toEqual([
+      32, 48, 64,
+    ])
+    expect(chunk.nextIndex).toBe(5)
+  })
+
+  it('drops the slot the producer is writing while the reader copies it', () => {
+    const producer = new FakeProducer()
+    for (let i = 0; i < CAPACITY; i++) {
+      producer.push(i * 16, i * 16 + 1)
+    }
+    // The next record goes into slot 0, half written when the reader gets there
+    interruptFirstRecordRead(() => producer.beginPush(1000, 1010))
+
+    const chunk = readJsFrameTimeline(producer.buffer, 0)
+    expectNoTornRecords(chunk.records)
+    expect(chunk.records[0]?.scheduledMs).toBe(16)
+  })
+
+  it('drops every slot the producer lapped while the reader copied', () => {
+    const producer = new FakeProducer()
+    for (let i = 0; i < CAPACITY; i++) {
+      producer.push(i * 16, i * 16 + 1)
+    }
+    // Three records published and a fourth half written, slots 0-3 can't be trusted
+    interruptFirstRecordRead(() => {
+      for (let i = 0; i < 3; i++) {
+        producer.push(1000 + i, 1010 + i)
+      }
+      producer.beginPush(2000, 2010)
+    })
+
+    const chunk = readJsFrameTimeline(producer.buffer, 0)
+    expectNoTornRecords(chunk.records)
+    expect(chunk.records.map((record) => record.scheduledMs)).toEqual([
+      64, 80, 96, 112,
+    ])
+  })
+})
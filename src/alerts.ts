@@ -0,0 +1,46 @@
+import { PerformanceMetrics } from './hybrids'
+import { METRIC_SLOTS, type MetricName } from './metricsBlock'
+import type {
+  Alert as NativeAlert,
+  AlertCondition,
+} from './specs/performance-metrics.nitro'
+
+export type { AlertCondition }
+
+export type AlertRuleOptions = {
+  metric: MetricName
+  condition: AlertCondition
+  /** Metric units, or metric units per minute for slopes */
+  threshold: number
+  /** Condition must hold this long, for slopes the window of the slope (60 s by default) */
+  forMs?: number
+  /** Condition must hold for this many consecutive samples, for slopes the window in samples */
+  forSamples?: number
+}
+
+export type Alert = Omit<NativeAlert, 'metric'> & {
+  metric: MetricName
+}
+
+const METRIC_NAMES = Object.fromEntries(
+  Object.entries(METRIC_SLOTS).map(([name, slot]) => [slot, name])
+) as Record<number, MetricName>
+
+/**
+ * Registers a rule evaluated natively against every sample, JS only runs when it fires.
+ * Returns a function that removes the rule.
+ *
+ * addAlertRule({ metric: 'jsFps', condition: 'below', threshold: 30, forMs: 3000 }, onAlert)
+ * addAlertRule({ metric: 'cpuUsage', condition: 'above', threshold: 80, forSamples: 5 }, onAlert)
+ * addAlertRule({ metric: 'memoryUsage', condition: 'slope-above', threshold: 20 }, onAlert)
+ */
+export const addAlertRule = (
+  rule: AlertRuleOptions,
+  onAlert: (alert: Alert) => void
+) => {
+  const ruleId = PerformanceMetrics.addAlertRule(
+    { ...rule, metric: METRIC_SLOTS[rule.metric] },
+    (alert) => onAlert({ ...alert, metric: METRIC_NAMES[alert.metric]! })
+  )
+  return () => PerformanceMetrics.removeAlertRule(ruleId)
+}
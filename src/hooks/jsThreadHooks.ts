@@ -1,47 +1,89 @@
-import { JsFpsTracking } from '../hybrids'
-import { PerformanceToolkit } from '../hybrids'
 import { useEffect, useState } from 'react'
+import { PerformanceMetrics } from '../hybrids'
+import {
+  getMetricsBuffer,
+  METRIC_SLOTS,
+  readMetrics,
+  type MetricName,
+  type MetricsSnapshot,
+} from '../metricsBlock'
 
-const getJsFpsBuffer = () => JsFpsTracking.getJsFpsBuffer()
+type Subscriber = {
+  callback: (metrics: MetricsSnapshot) => void
+  /** Bits of the metric slots the subscriber cares about */
+  slotMask: number
+}
+
+const ALL_SLOTS = 0xffffffff
 
-const getUiFpsBuffer = () => PerformanceToolkit.getUiFpsBuffer()
-const getCpuUsageBuffer = () => PerformanceToolkit.getCpuUsageBuffer()
-const getMemoryUsageBuffer = () => PerformanceToolkit.getMemoryUsageBuffer()
+const subscribers = new Set<Subscriber>()
+let listenerId: number | null = null
+// Fetched once with the native listener, deliveries only read it without calling into native
+let listenerBuffer: ArrayBuffer | null = null
 
-const getValueFromBuffer = (buffer: ArrayBuffer) => {
-  const view = new DataView(buffer)
-  return view.getInt32(0, true) // true = littleEndian
+// One native listener for the whole JS runtime, fanned out to every subscriber. Native calls it
+// only when a metric changed, batched and at most once per frame, so idle widgets cost nothing.
+const onNativeChange = (changedSlots: number) => {
+  if (listenerBuffer === null) {
+    return
+  }
+  const metrics = readMetrics(listenerBuffer)
+  subscribers.forEach((subscriber) => {
+    if ((subscriber.slotMask & changedSlots) !== 0) {
+      subscriber.callback(metrics)
+    }
+  })
 }
 
-export const getJsFps = () => getValueFromBuffer(getJsFpsBuffer())
-export const getUiFps = () => getValueFromBuffer(getUiFpsBuffer())
-export const getCpuUsage = () => getValueFromBuffer(getCpuUsageBuffer())
-export const getMemoryUsage = () => getValueFromBuffer(getMemoryUsageBuffer())
+export const getMetrics = () => readMetrics(getMetricsBuffer())
+
+export const getJsFps = () => getMetrics().jsFps.value
+export const getJsDroppedFrames = () => getMetrics().jsDroppedFrames.value
+export const getUiFps = () => getMetrics().uiFps.value
+export const getCpuUsage = () => getMetrics().cpuUsage.value
+export const getMemoryUsage = () => getMetrics().memoryUsage.value
 
-const prepareOnChange = (
-  bufferGetter: () => ArrayBuffer,
-  intervalMs: number = 1000
+/**
+ * Calls `callback` with a snapshot of all metrics right away and then whenever one of `metrics`
+ * (all by default) changes. Pushed from native, no timers run on the JS thread.
+ */
+export const onMetricsChange = (
+  callback: (metrics: MetricsSnapshot) => void,
+  metrics?: MetricName[]
 ) => {
-  return (callback: (fps: number) => void) => {
-    const intervalId = setInterval(() => {
-      const buffer = bufferGetter()
-      if (!buffer) {
-        console.error(`Failed to get buffer.`)
-        return
-      }
-      callback(getValueFromBuffer(buffer))
-    }, intervalMs)
+  const slotMask = metrics
+    ? metrics.reduce((mask, name) => mask | (1 << METRIC_SLOTS[name]), 0)
+    : ALL_SLOTS
+  const subscriber: Subscriber = { callback, slotMask }
+  subscribers.add(subscriber)
+  if (listenerBuffer === null) {
+    listenerBuffer = getMetricsBuffer()
+  }
+  if (listenerId === null) {
+    listenerId = PerformanceMetrics.addMetricsListener(onNativeChange)
+  }
+  callback(readMetrics(listenerBuffer))
 
-    return () => {
-      clearInterval(intervalId)
+  return () => {
+    subscribers.delete(subscriber)
+    if (subscribers.size === 0 && listenerId !== null) {
+      PerformanceMetrics.removeMetricsListener(listenerId)
+      listenerId = null
+      listenerBuffer = null
     }
   }
 }
 
-export const onFpsJsChange = prepareOnChange(getJsFpsBuffer)
-export const onFpsUiChange = prepareOnChange(getUiFpsBuffer)
-export const onCpuChange = prepareOnChange(getCpuUsageBuffer)
-export const onMemoryChange = prepareOnChange(getMemoryUsageBuffer)
+const prepareOnChange = (metric: MetricName) => {
+  return (callback: (value: number) => void) =>
+    onMetricsChange((metrics) => callback(metrics[metric].value), [metric])
+}
+
+export const onFpsJsChange = prepareOnChange('jsFps')
+export const onJsDroppedFramesChange = prepareOnChange('jsDroppedFrames')
+export const onFpsUiChange = prepareOnChange('uiFps')
+export const onCpuChange = prepareOnChange('cpuUsage')
+export const onMemoryChange = prepareOnChange('memoryUsage')
 
 export const useFpsJs = () => {
   const [value, setValue] = useState(0)
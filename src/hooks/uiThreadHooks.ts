@@ -1,61 +1,162 @@
-import { useCallback, useEffect } from 'react'
-import { useSharedValue } from 'react-native-reanimated'
+import { useEffect } from 'react'
+import { useSharedValue, type SharedValue } from 'react-native-reanimated'
 import { scheduleOnUI } from 'react-native-worklets'
 
-import { BoxedJsFpsTracking, BoxedPerformanceToolkit } from '../hybrids'
+import { BoxedPerformanceMetrics } from '../hybrids'
+import {
+  getMetricsBuffer,
+  METRIC_SLOTS,
+  readMetrics,
+  type MetricName,
+  type MetricsSnapshot,
+} from '../metricsBlock'
+import { registerUiRuntime } from '../runtimeFps'
+import type { PerformanceMetrics } from '../specs/performance-metrics.nitro'
 
 export type CounterType = 'js' | 'ui' | 'cpu' | 'memory'
 
-export const useCounterSharedValue = (type: CounterType) => {
-  const fpsValue = useSharedValue(0)
-  const internvalId = useSharedValue<ReturnType<typeof setInterval> | null>(
-    null
-  )
-
-  const updateFps = useCallback(() => {
-    'worklet'
-    const unboxedJsFps = BoxedJsFpsTracking.unbox()
-    const unboxedPerformanceToolkit = BoxedPerformanceToolkit.unbox()
-
-    let buffer = null
-    if (type === 'js') {
-      buffer = unboxedJsFps.getJsFpsBuffer()
-    } else if (type === 'ui') {
-      buffer = unboxedPerformanceToolkit.getUiFpsBuffer()
-    } else if (type === 'cpu') {
-      buffer = unboxedPerformanceToolkit.getCpuUsageBuffer()
-    } else if (type === 'memory') {
-      buffer = unboxedPerformanceToolkit.getMemoryUsageBuffer()
-    }
+type UiCounter = {
+  type: CounterType
+  value: SharedValue<number>
+}
+
+// State of the UI runtime's counters, kept on its global object so every counter shares one
+// native listener and one buffer. Nitro callbacks can't be dispatched to the UI runtime, so native
+// posts the changed slots through the runtime's `ui` registration instead, at most once per
+// `counterUpdateIntervalMs` of the sampling profile. No timer runs on the UI runtime.
+type UiCounterState = {
+  counters: Map<number, UiCounter>
+  nextId: number
+  listenerId: number | null
+  metrics: PerformanceMetrics | null
+  buffer: ArrayBuffer | null
+}
+
+type UiCounterGlobal = typeof globalThis & {
+  __performanceToolkitUiCounters?: UiCounterState
+  __performanceToolkitOnMetricsChange?: (changedSlots: number) => void
+}
 
-    if (!buffer) {
-      console.error(`Failed to get buffer for type: ${type}`)
-      return
+const getState = (): UiCounterState => {
+  'worklet'
+  const global = globalThis as UiCounterGlobal
+  if (global.__performanceToolkitUiCounters === undefined) {
+    global.__performanceToolkitUiCounters = {
+      counters: new Map(),
+      nextId: 1,
+      listenerId: null,
+      metrics: null,
+      buffer: null,
     }
-    const view = new DataView(buffer)
-    fpsValue.value = view.getInt32(0, true)
-  }, [type])
-
-  const startUpdateFpsLoop = useCallback(() => {
-    'worklet'
-    internvalId.value = setInterval(updateFps, 1000)
-  }, [updateFps])
-
-  const stopUpdateFpsLoop = useCallback(() => {
-    'worklet'
-    if (internvalId.value) {
-      clearInterval(internvalId.value)
+  }
+  return global.__performanceToolkitUiCounters
+}
+
+const metricOf = (type: CounterType): MetricName => {
+  'worklet'
+  if (type === 'js') {
+    return 'jsFps'
+  } else if (type === 'ui') {
+    return 'uiFps'
+  } else if (type === 'cpu') {
+    return 'cpuUsage'
+  }
+  return 'memoryUsage'
+}
+
+const selectCounter = (metrics: MetricsSnapshot, type: CounterType) => {
+  'worklet'
+  return metrics[metricOf(type)].value
+}
+
+const getMetricsObject = (state: UiCounterState) => {
+  'worklet'
+  if (state.metrics === null) {
+    state.metrics = BoxedPerformanceMetrics.unbox()
+  }
+  return state.metrics
+}
+
+const getBuffer = (state: UiCounterState) => {
+  'worklet'
+  if (state.buffer === null) {
+    state.buffer = getMetricsObject(state).getMetricsBuffer()
+  }
+  return state.buffer
+}
+
+// Called by native on the UI runtime with the slots that changed since the last call
+const onMetricsChange = (changedSlots: number) => {
+  'worklet'
+  const state = getState()
+  // One read of the shared buffer for all counters, no Nitro call per update
+  const metrics = readMetrics(getBuffer(state))
+  if (metrics.counterUpdateIntervalMs.value <= 0) {
+    return
+  }
+  // Changes are not posted while the counters are paused, so catch up on all of them when they resume
+  const resumed =
+    (changedSlots & (1 << METRIC_SLOTS.counterUpdateIntervalMs)) !== 0
+  state.counters.forEach((counter) => {
+    if (
+      resumed ||
+      (changedSlots & (1 << METRIC_SLOTS[metricOf(counter.type)])) !== 0
+    ) {
+      counter.value.value = selectCounter(metrics, counter.type)
     }
-    internvalId.value = null
-  }, [internvalId])
+  })
+}
+
+// The runtime can only be registered on the UI thread once UI frames are delivered, which
+// `getMetricsBuffer` starts, so retry every frame until then
+const registerWhenFramesArrive = (state: UiCounterState) => {
+  'worklet'
+  if (state.listenerId === null) {
+    return
+  }
+  try {
+    registerUiRuntime()
+  } catch {
+    requestAnimationFrame(() => registerWhenFramesArrive(state))
+  }
+}
+
+const addCounter = (counter: UiCounter, id: SharedValue<number>) => {
+  'worklet'
+  const state = getState()
+  id.value = state.nextId++
+  state.counters.set(id.value, counter)
+  counter.value.value = selectCounter(readMetrics(getBuffer(state)), counter.type)
+  if (state.listenerId !== null) {
+    return
+  }
+  const global = globalThis as UiCounterGlobal
+  global.__performanceToolkitOnMetricsChange = onMetricsChange
+  state.listenerId = getMetricsObject(state).addUiMetricsListener()
+  registerWhenFramesArrive(state)
+}
+
+const removeCounter = (id: SharedValue<number>) => {
+  'worklet'
+  const state = getState()
+  state.counters.delete(id.value)
+  if (state.counters.size === 0 && state.listenerId !== null) {
+    getMetricsObject(state).removeMetricsListener(state.listenerId)
+    state.listenerId = null
+  }
+}
+
+export const useCounterSharedValue = (type: CounterType) => {
+  const fpsValue = useSharedValue(0)
+  const counterId = useSharedValue(0)
 
   useEffect(() => {
-    if (internvalId.value) return
-    scheduleOnUI(startUpdateFpsLoop)
+    getMetricsBuffer() // Starts the native samplers that fill the buffer
+    scheduleOnUI(addCounter, { type, value: fpsValue }, counterId)
     return () => {
-      scheduleOnUI(stopUpdateFpsLoop)
+      scheduleOnUI(removeCounter, counterId)
     }
-  }, [startUpdateFpsLoop, stopUpdateFpsLoop])
+  }, [type, fpsValue, counterId])
 
   return fpsValue
 }
@@ -1,6 +1,7 @@
 import { NitroModules } from 'react-native-nitro-modules'
 import type { JsFpsTracking as JsFpsTrackingSpec } from './specs/js-fps-tracking.nitro'
 import type { PerformanceToolkit as PerformanceToolkitSpec } from './specs/performance-toolkit.nitro'
+import type { PerformanceMetrics as PerformanceMetricsSpec } from './specs/performance-metrics.nitro'
 
 export const PerformanceToolkit =
   NitroModules.createHybridObject<PerformanceToolkitSpec>('PerformanceToolkit')
@@ -8,5 +9,9 @@ export const PerformanceToolkit =
 export const JsFpsTracking =
   NitroModules.createHybridObject<JsFpsTrackingSpec>('JsFpsTracking')
 
+export const PerformanceMetrics =
+  NitroModules.createHybridObject<PerformanceMetricsSpec>('PerformanceMetrics')
+
 export const BoxedJsFpsTracking = NitroModules.box(JsFpsTracking)
 export const BoxedPerformanceToolkit = NitroModules.box(PerformanceToolkit)
+export const BoxedPerformanceMetrics = NitroModules.box(PerformanceMetrics)
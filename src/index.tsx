@@ -1,11 +1,33 @@
 import './specs/TurboPerformanceToolkit'
 
-import { PerformanceToolkit } from './hybrids'
+import { JsFpsTracking, PerformanceMetrics, PerformanceToolkit } from './hybrids'
+import { getMetricsBuffer } from './metricsBlock'
+import type { JsFpsTrackingMode } from './specs/js-fps-tracking.nitro'
+import type {
+  SamplingOverrides,
+  SamplingProfile,
+} from './specs/performance-metrics.nitro'
+
+export type {
+  JsFpsTrackingMode,
+  LongTask,
+} from './specs/js-fps-tracking.nitro'
+export type {
+  MetricPercentiles,
+  OverheadStats,
+  Percentiles,
+  SamplingConfig,
+  SamplingOverrides,
+  SamplingProfile,
+  StartupTimeline,
+} from './specs/performance-metrics.nitro'
 
 export {
   BoxedJsFpsTracking,
+  BoxedPerformanceMetrics,
   BoxedPerformanceToolkit,
   JsFpsTracking,
+  PerformanceMetrics,
   PerformanceToolkit,
 } from './hybrids'
 
@@ -15,4 +37,78 @@ export const getDeviceMaxRefreshRate = () =>
 export const getDeviceCurrentRefreshRate = () =>
   PerformanceToolkit.getDeviceCurrentRefreshRate()
 
+export const setJsFpsTrackingMode = (mode: JsFpsTrackingMode) =>
+  JsFpsTracking.setTrackingMode(mode)
+
+export const getJsFpsTrackingMode = () => JsFpsTracking.getTrackingMode()
+
+export const setLongTaskThreshold = (thresholdMs: number) =>
+  JsFpsTracking.setLongTaskThreshold(thresholdMs)
+
+export const drainLongTasks = () => JsFpsTracking.drainLongTasks()
+
+export const getMetricPercentiles = (windowSeconds: number = 10) =>
+  PerformanceMetrics.getMetricPercentiles(windowSeconds)
+
+export const getOverheadStats = () => PerformanceMetrics.getOverheadStats()
+
+/**
+ * Switches how much is measured, e.g. `production` in release builds and `qa` or `profiling` for a
+ * session that needs more detail. Applies right away, returns the applied config.
+ */
+export const setSamplingProfile = (
+  profile: SamplingProfile,
+  overrides?: SamplingOverrides
+) => PerformanceMetrics.setSamplingProfile(profile, overrides)
+
+export const getSamplingConfig = () => PerformanceMetrics.getSamplingConfig()
+
+/**
+ * Startup milestones of this process (process start, native library load, runtime, bindings,
+ * first JS tick, first UI frame) in ms, 0 for milestones not reached yet.
+ */
+export const getStartupTimeline = () => PerformanceMetrics.getStartupTimeline()
+
+/**
+ * Starts recording all samples (JS ticks, UI frames, CPU, memory, long tasks) into a binary
+ * session file in the app cache directory, or at `path`. Resolves with the file path once the
+ * file was created natively, off the JS thread.
+ * The samplers are started too, so the session isn't missing CPU and memory samples.
+ */
+export const startSessionRecording = (path?: string) => {
+  getMetricsBuffer()
+  return PerformanceMetrics.startSessionRecording(path)
+}
+
+export const stopSessionRecording = () =>
+  PerformanceMetrics.stopSessionRecording()
+
+export const exportSessionTrace = (sessionPath: string, tracePath?: string) =>
+  PerformanceMetrics.exportSessionTrace(sessionPath, tracePath)
+
+/**
+ * User timings: intern a name once, then pass its id on the hot path (no string crosses JSI).
+ * Marks and spans are only recorded while a session is recording and show up in the exported
+ * trace on a "User timings" track next to the JS and UI frames.
+ *
+ * const LIST_RENDER = internTimingName('FeedList render')
+ * beginSpan(LIST_RENDER); ...; endSpan(LIST_RENDER)
+ */
+export const internTimingName = (name: string) =>
+  PerformanceMetrics.internTimingName(name)
+
+export const mark = (nameId: number) => PerformanceMetrics.mark(nameId)
+
+export const beginSpan = (nameId: number) =>
+  PerformanceMetrics.beginSpan(nameId)
+
+export const endSpan = (nameId: number) =>
+  PerformanceMetrics.endSpan(nameId)
+
+export * from './alerts'
 export * from './hooks/jsThreadHooks'
+export * from './jsFrameTimeline'
+export * from './jsLagEvents'
+export * from './metricsBlock'
+export * from './runtimeFps'
+export * from './threadCpuUsage'
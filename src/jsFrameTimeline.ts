@@ -0,0 +1,78 @@
+import { JsFpsTracking } from './hybrids'
+
+// Must match the layout in cpp/JsFrameTimeline.hpp
+const HEADER_SIZE = 16
+const CAPACITY_OFFSET = 0
+const RECORD_SIZE_OFFSET = 4
+const WRITE_INDEX_OFFSET = 8
+
+export type JsFrameTimelineRecord = {
+  /** When the tick was posted to the JS thread (same timebase as `performance.now()`) */
+  scheduledMs: number
+  /** When the tick started running on the JS thread */
+  ranMs: number
+  /** How long the tick waited for the JS thread */
+  latencyMs: number
+}
+
+export type JsFrameTimelineChunk = {
+  records: JsFrameTimelineRecord[]
+  /** Pass this as `fromIndex` on the next read to only get new records */
+  nextIndex: number
+}
+
+export const getJsFrameTimelineBuffer = () =>
+  JsFpsTracking.getJsFrameTimelineBuffer()
+
+/**
+ * Reads all records written since `fromIndex` from the JS frame timeline ring.
+ * Works on any thread (JS or worklets), the buffer is shared with native without copying.
+ * Records older than the ring capacity are lost, so read at least every few seconds.
+ */
+export const readJsFrameTimeline = (
+  buffer: ArrayBuffer,
+  fromIndex: number = 0
+): JsFrameTimelineChunk => {
+  'worklet'
+  const view = new DataView(buffer)
+  const capacity = view.getUint32(CAPACITY_OFFSET, true)
+  const recordSize = view.getUint32(RECORD_SIZE_OFFSET, true)
+  const writeIndex = view.getUint32(WRITE_INDEX_OFFSET, true)
+
+  const start = Math.max(fromIndex, writeIndex - capacity, 0)
+  const records: JsFrameTimelineRecord[] = []
+  for (let index = start; index < writeIndex; index++) {
+    const offset = HEADER_SIZE + (index % capacity) * recordSize
+    records.push({
+      scheduledMs: view.getFloat64(offset, true),
+      ranMs: view.getFloat64(offset + 8, true),
+      latencyMs: view.getFloat64(offset + 16, true),
+    })
+  }
+
+  // The producer may have lapped us while copying, drop slots that got overwritten. The slot of
+  // index `newWriteIndex - capacity` is the one it may be writing right now, so it goes too
+  const newWriteIndex = view.getUint32(WRITE_INDEX_OFFSET, true)
+  const overwritten = newWriteIndex - capacity + 1 - start
+  return {
+    records: overwritten > 0 ? records.slice(overwritten) : records,
+    nextIndex: writeIndex,
+  }
+}
+
+/**
+ * Returns the latency (in ms) below which `percentile` (0-100) of the records fall.
+ */
+export const getLatencyPercentile = (
+  records: JsFrameTimelineRecord[],
+  percentile: number
+) => {
+  'worklet'
+  if (records.length === 0) {
+    return 0
+  }
+  const latencies = records.map((record) => record.latencyMs)
+  latencies.sort((a, b) => a - b)
+  const rank = Math.ceil((percentile / 100) * latencies.length) - 1
+  return latencies[Math.min(Math.max(rank, 0), latencies.length - 1)] ?? 0
+}
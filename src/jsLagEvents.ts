@@ -0,0 +1,80 @@
+import { JsFpsTracking } from './hybrids'
+
+// Must match the layout in cpp/JsLagEvents.hpp
+const HEADER_SIZE = 32
+const CAPACITY_OFFSET = 0
+const RECORD_SIZE_OFFSET = 4
+const WRITE_INDEX_OFFSET = 8
+const GC_PAUSE_COUNT_OFFSET = 12
+const LONG_TASK_COUNT_OFFSET = 16
+const BACKLOG_COUNT_OFFSET = 20
+
+/**
+ * - `gc-pause`: the JS engine collected garbage while the tick was waiting, chase allocations
+ * - `long-task`: no GC, the tick waited more than 50 ms for synchronous JS work
+ * - `backlog`: a shorter delay behind other tasks queued on the JS thread
+ */
+export type JsLagCause = 'gc-pause' | 'long-task' | 'backlog'
+
+// Indexed by `JsLagCause` in cpp/JsLagEvents.hpp
+const CAUSES: JsLagCause[] = ['gc-pause', 'long-task', 'backlog']
+
+export type JsLagEvent = {
+  /** When the late tick was posted to the JS thread (same timebase as `performance.now()`) */
+  scheduledMs: number
+  /** How long it waited for the JS thread */
+  latencyMs: number
+  cause: JsLagCause
+  /** Garbage collections that happened while it waited */
+  gcCount: number
+}
+
+export type JsLagEventsChunk = {
+  /** Late ticks per cause since tracking started */
+  counts: Record<JsLagCause, number>
+  events: JsLagEvent[]
+  /** Pass this as `fromIndex` on the next read to only get new events */
+  nextIndex: number
+}
+
+export const getJsLagEventsBuffer = () => JsFpsTracking.getJsLagEventsBuffer()
+
+/**
+ * Reads the per-cause counters and all late JS ticks recorded since `fromIndex`.
+ * Works on any thread (JS or worklets), the buffer is shared with native without copying.
+ */
+export const readJsLagEvents = (
+  buffer: ArrayBuffer,
+  fromIndex: number = 0
+): JsLagEventsChunk => {
+  'worklet'
+  const view = new DataView(buffer)
+  const capacity = view.getUint32(CAPACITY_OFFSET, true)
+  const recordSize = view.getUint32(RECORD_SIZE_OFFSET, true)
+  const writeIndex = view.getUint32(WRITE_INDEX_OFFSET, true)
+  const counts = {
+    'gc-pause': view.getUint32(GC_PAUSE_COUNT_OFFSET, true),
+    'long-task': view.getUint32(LONG_TASK_COUNT_OFFSET, true),
+    'backlog': view.getUint32(BACKLOG_COUNT_OFFSET, true),
+  }
+
+  const start = Math.max(fromIndex, writeIndex - capacity, 0)
+  const events: JsLagEvent[] = []
+  for (let index = start; index < writeIndex; index++) {
+    const offset = HEADER_SIZE + (index % capacity) * recordSize
+    events.push({
+      scheduledMs: view.getFloat64(offset, true),
+      latencyMs: view.getFloat64(offset + 8, true),
+      cause: CAUSES[view.getUint32(offset + 16, true)] ?? 'backlog',
+      gcCount: view.getUint32(offset + 20, true),
+    })
+  }
+
+  // The producer may have lapped us while copying, drop slots that got overwritten
+  const overwritten = view.getUint32(WRITE_INDEX_OFFSET, true) - capacity - start
+  return {
+    counts,
+    events: overwritten > 0 ? events.slice(overwritten) : events,
+    nextIndex: writeIndex,
+  }
+}
@@ -0,0 +1,212 @@
+import { JsFpsTracking, PerformanceMetrics, PerformanceToolkit } from './hybrids'
+
+// Must match the layout in cpp/MetricsBlock.hpp
+const LAYOUT_VERSION = 2
+const HEADER_SIZE = 64
+const SEQUENCE_OFFSET = 0
+const LAYOUT_VERSION_OFFSET = 4
+const SLOT_SIZE_OFFSET = 12
+
+// Slot indices, must match `MetricSlot` in cpp/MetricsBlock.hpp
+const JS_FPS_SLOT = 0
+const JS_DROPPED_FRAMES_SLOT = 1
+const UI_FPS_SLOT = 2
+const CPU_USAGE_SLOT = 3
+const MEMORY_USAGE_SLOT = 4
+const JS_THREAD_CPU_USAGE_SLOT = 5
+const UI_THREAD_CPU_USAGE_SLOT = 6
+const MEMORY_PSS_KB_SLOT = 7
+const MEMORY_RSS_KB_SLOT = 8
+const MEMORY_PRIVATE_DIRTY_KB_SLOT = 9
+const MEMORY_SWAP_KB_SLOT = 10
+const MEMORY_ANONYMOUS_KB_SLOT = 11
+const JS_HEAP_ALLOCATED_BYTES_SLOT = 12
+const JS_HEAP_SIZE_BYTES_SLOT = 13
+const JS_GC_COUNT_SLOT = 14
+const UI_DROPPED_FRAMES_SLOT = 15
+const UI_MAX_FRAME_TIME_MS_SLOT = 16
+const UI_STUTTER_COUNT_SLOT = 17
+const UI_JANK_COUNT_SLOT = 18
+const UI_BIG_JANK_COUNT_SLOT = 19
+const UI_FROZEN_FRAME_COUNT_SLOT = 20
+const TOOLKIT_CPU_USAGE_SLOT = 21
+const TOOLKIT_JS_THREAD_USAGE_SLOT = 22
+const JS_FPS_INSTANT_SLOT = 23
+const JS_FPS_1S_SLOT = 24
+const JS_FPS_5S_SLOT = 25
+const JS_FPS_SESSION_SLOT = 26
+const COUNTER_UPDATE_INTERVAL_MS_SLOT = 27
+
+export type MetricValue = {
+  value: number
+  /** When the value was last written (same timebase as `performance.now()`), 0 if never written */
+  updatedAtMs: number
+}
+
+export type MetricsSnapshot = {
+  jsFps: MetricValue
+  jsDroppedFrames: MetricValue
+  uiFps: MetricValue
+  cpuUsage: MetricValue
+  memoryUsage: MetricValue
+  /** CPU usage of the JS thread (percent of one core), Android only */
+  jsThreadCpuUsage: MetricValue
+  /** CPU usage of the main thread (percent of one core), Android only */
+  uiThreadCpuUsage: MetricValue
+  /** Proportional set size in KB, Android only */
+  memoryPssKb: MetricValue
+  /** Resident set size in KB, Android only */
+  memoryRssKb: MetricValue
+  /** Private dirty pages in KB, Android only */
+  memoryPrivateDirtyKb: MetricValue
+  /** Swapped out (zram) memory in KB, Android only */
+  memorySwapKb: MetricValue
+  /** Anonymous (heap) memory in KB, Android only */
+  memoryAnonymousKb: MetricValue
+  /** Bytes allocated in the JS heap, Hermes only */
+  jsHeapAllocatedBytes: MetricValue
+  /** Size of the JS heap in bytes, Hermes only */
+  jsHeapSizeBytes: MetricValue
+  /** Total number of JS garbage collections, Hermes only */
+  jsGcCount: MetricValue
+  /** UI frames missed relative to the current refresh rate in the last 500 ms window */
+  uiDroppedFrames: MetricValue
+  /** Longest UI frame in the last 500 ms window */
+  uiMaxFrameTimeMs: MetricValue
+  /** UI frames that missed 4+ refresh intervals since start */
+  uiStutterCount: MetricValue
+  /** UI frames over twice the recent frame time and longer than 83.3 ms since start */
+  uiJankCount: MetricValue
+  /** Same as `uiJankCount` but longer than 125 ms */
+  uiBigJankCount: MetricValue
+  /** UI frames longer than 700 ms since start */
+  uiFrozenFrameCount: MetricValue
+  /** Share of one core (percent) this toolkit used in the last second, see `getOverheadStats` */
+  toolkitCpuUsage: MetricValue
+  /** Share of one core (percent) spent in this toolkit's tasks on JS runtimes in the last second */
+  toolkitJsThreadUsage: MetricValue
+  /** JS FPS over the last 250 ms, sliding, updated every 250 ms (main runtime) */
+  jsFpsInstant: MetricValue
+  /** JS FPS over the last second, sliding, updated every 250 ms (main runtime) */
+  jsFps1s: MetricValue
+  /** JS FPS over the last five seconds, sliding, updated every 250 ms (main runtime) */
+  jsFps5s: MetricValue
+  /** JS FPS since tracking started or the tracking mode changed, updated every 250 ms (main runtime) */
+  jsFpsSession: MetricValue
+  /** Refresh period of the counter hooks from the sampling profile, 0 while they are off */
+  counterUpdateIntervalMs: MetricValue
+}
+
+export type MetricName = keyof MetricsSnapshot
+
+/** Slot index of every metric, bit `1 << slot` in the masks passed to metric listeners */
+export const METRIC_SLOTS: Record<MetricName, number> = {
+  jsFps: JS_FPS_SLOT,
+  jsDroppedFrames: JS_DROPPED_FRAMES_SLOT,
+  uiFps: UI_FPS_SLOT,
+  cpuUsage: CPU_USAGE_SLOT,
+  memoryUsage: MEMORY_USAGE_SLOT,
+  jsThreadCpuUsage: JS_THREAD_CPU_USAGE_SLOT,
+  uiThreadCpuUsage: UI_THREAD_CPU_USAGE_SLOT,
+  memoryPssKb: MEMORY_PSS_KB_SLOT,
+  memoryRssKb: MEMORY_RSS_KB_SLOT,
+  memoryPrivateDirtyKb: MEMORY_PRIVATE_DIRTY_KB_SLOT,
+  memorySwapKb: MEMORY_SWAP_KB_SLOT,
+  memoryAnonymousKb: MEMORY_ANONYMOUS_KB_SLOT,
+  jsHeapAllocatedBytes: JS_HEAP_ALLOCATED_BYTES_SLOT,
+  jsHeapSizeBytes: JS_HEAP_SIZE_BYTES_SLOT,
+  jsGcCount: JS_GC_COUNT_SLOT,
+  uiDroppedFrames: UI_DROPPED_FRAMES_SLOT,
+  uiMaxFrameTimeMs: UI_MAX_FRAME_TIME_MS_SLOT,
+  uiStutterCount: UI_STUTTER_COUNT_SLOT,
+  uiJankCount: UI_JANK_COUNT_SLOT,
+  uiBigJankCount: UI_BIG_JANK_COUNT_SLOT,
+  uiFrozenFrameCount: UI_FROZEN_FRAME_COUNT_SLOT,
+  toolkitCpuUsage: TOOLKIT_CPU_USAGE_SLOT,
+  toolkitJsThreadUsage: TOOLKIT_JS_THREAD_USAGE_SLOT,
+  jsFpsInstant: JS_FPS_INSTANT_SLOT,
+  jsFps1s: JS_FPS_1S_SLOT,
+  jsFps5s: JS_FPS_5S_SLOT,
+  jsFpsSession: JS_FPS_SESSION_SLOT,
+  counterUpdateIntervalMs: COUNTER_UPDATE_INTERVAL_MS_SLOT,
+}
+
+let samplersStarted = false
+
+/**
+ * Returns the shared metrics buffer. The samplers are started lazily by their legacy
+ * per-metric getters, so touch each of them once to make sure the block gets filled.
+ */
+export const getMetricsBuffer = () => {
+  if (!samplersStarted) {
+    samplersStarted = true
+    JsFpsTracking.getJsFpsBuffer()
+    PerformanceToolkit.getUiFpsBuffer()
+    PerformanceToolkit.getCpuUsageBuffer()
+    PerformanceToolkit.getMemoryUsageBuffer()
+  }
+  return PerformanceMetrics.getMetricsBuffer()
+}
+
+/**
+ * Reads a consistent snapshot of all metrics from the metrics buffer.
+ * Works on any thread (JS or worklets) without calling into native. The read is retried until
+ * no native write was in progress while it copied, so values from two different updates are
+ * never mixed. Native writes only store a few numbers, a retry waits for microseconds.
+ */
+export const readMetrics = (buffer: ArrayBuffer): MetricsSnapshot => {
+  'worklet'
+  const view = new DataView(buffer)
+  if (view.getUint32(LAYOUT_VERSION_OFFSET, true) !== LAYOUT_VERSION) {
+    throw new Error('Metrics buffer layout does not match the JS reader')
+  }
+  const slotSize = view.getUint32(SLOT_SIZE_OFFSET, true)
+  const readSlot = (slot: number): MetricValue => {
+    const offset = HEADER_SIZE + slot * slotSize
+    return {
+      value: view.getFloat64(offset, true),
+      updatedAtMs: view.getFloat64(offset + 8, true),
+    }
+  }
+  const readAll = (): MetricsSnapshot => ({
+    jsFps: readSlot(JS_FPS_SLOT),
+    jsDroppedFrames: readSlot(JS_DROPPED_FRAMES_SLOT),
+    uiFps: readSlot(UI_FPS_SLOT),
+    cpuUsage: readSlot(CPU_USAGE_SLOT),
+    memoryUsage: readSlot(MEMORY_USAGE_SLOT),
+    jsThreadCpuUsage: readSlot(JS_THREAD_CPU_USAGE_SLOT),
+    uiThreadCpuUsage: readSlot(UI_THREAD_CPU_USAGE_SLOT),
+    memoryPssKb: readSlot(MEMORY_PSS_KB_SLOT),
+    memoryRssKb: readSlot(MEMORY_RSS_KB_SLOT),
+    memoryPrivateDirtyKb: readSlot(MEMORY_PRIVATE_DIRTY_KB_SLOT),
+    memorySwapKb: readSlot(MEMORY_SWAP_KB_SLOT),
+    memoryAnonymousKb: readSlot(MEMORY_ANONYMOUS_KB_SLOT),
+    jsHeapAllocatedBytes: readSlot(JS_HEAP_ALLOCATED_BYTES_SLOT),
+    jsHeapSizeBytes: readSlot(JS_HEAP_SIZE_BYTES_SLOT),
+    jsGcCount: readSlot(JS_GC_COUNT_SLOT),
+    uiDroppedFrames: readSlot(UI_DROPPED_FRAMES_SLOT),
+    uiMaxFrameTimeMs: readSlot(UI_MAX_FRAME_TIME_MS_SLOT),
+    uiStutterCount: readSlot(UI_STUTTER_COUNT_SLOT),
+    uiJankCount: readSlot(UI_JANK_COUNT_SLOT),
+    uiBigJankCount: readSlot(UI_BIG_JANK_COUNT_SLOT),
+    uiFrozenFrameCount: readSlot(UI_FROZEN_FRAME_COUNT_SLOT),
+    toolkitCpuUsage: readSlot(TOOLKIT_CPU_USAGE_SLOT),
+    toolkitJsThreadUsage: readSlot(TOOLKIT_JS_THREAD_USAGE_SLOT),
+    jsFpsInstant: readSlot(JS_FPS_INSTANT_SLOT),
+    jsFps1s: readSlot(JS_FPS_1S_SLOT),
+    jsFps5s: readSlot(JS_FPS_5S_SLOT),
+    jsFpsSession: readSlot(JS_FPS_SESSION_SLOT),
+    counterUpdateIntervalMs: readSlot(COUNTER_UPDATE_INTERVAL_MS_SLOT),
+  })
+
+  for (;;) {
+    const before = view.getUint32(SEQUENCE_OFFSET, true)
+    if (before % 2 !== 0) {
+      continue // Write in progress, wait for the writer to finish
+    }
+    const snapshot = readAll()
+    if (view.getUint32(SEQUENCE_OFFSET, true) === before) {
+      return snapshot
+    }
+  }
+}
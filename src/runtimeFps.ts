@@ -0,0 +1,84 @@
+import { BoxedJsFpsTracking, JsFpsTracking, PerformanceToolkit } from './hybrids'
+import type { JsFpsTracking as JsFpsTrackingSpec } from './specs/js-fps-tracking.nitro'
+
+// Must match the layout in cpp/RuntimeFpsTable.hpp
+const HEADER_SIZE = 16
+const CAPACITY_OFFSET = 0
+const RECORD_SIZE_OFFSET = 4
+
+// Raw JSI method registered in cpp/HybridJsFpsTracking.cpp, not part of the generated spec
+type JsFpsTrackingWithRuntimeRegistration = JsFpsTrackingSpec & {
+  registerUiRuntime(): void
+}
+
+export type RuntimeFps = {
+  /** Runtime name, `main` for the React Native JS runtime, `ui` for the worklets UI runtime */
+  name: string
+  fps: number
+  /** Frames missed relative to the current refresh rate in the last second */
+  droppedFrames: number
+  /** Longest time a probe waited for the runtime in the last second */
+  maxLatencyMs: number
+  /** When the values were last written (same timebase as `performance.now()`), 0 if never written */
+  updatedAtMs: number
+}
+
+/**
+ * Returns the buffer with the FPS of every tracked runtime and starts tracking the registered runtimes.
+ * UI FPS tracking is started too, runtimes on the UI thread are probed from its frame callback.
+ */
+export const getRuntimeFpsBuffer = () => {
+  PerformanceToolkit.getUiFpsBuffer()
+  return JsFpsTracking.getRuntimeFpsBuffer()
+}
+
+/**
+ * Runtime names by slot of the runtime FPS buffer, empty for free slots.
+ * Changes only when a runtime is (un)registered, cache it and pass it to `readRuntimeFps`.
+ */
+export const getTrackedRuntimes = () => JsFpsTracking.getTrackedRuntimes()
+
+export const unregisterRuntime = (name: string) =>
+  JsFpsTracking.unregisterRuntime(name)
+
+/**
+ * Registers the runtime this worklet runs on as `ui`, so it gets its own FPS tracker.
+ * Must run on the UI thread after UI FPS tracking delivered a frame, e.g.
+ * `getRuntimeFpsBuffer()` on JS and then `scheduleOnUI(registerUiRuntime)` a frame later.
+ */
+export const registerUiRuntime = () => {
+  'worklet'
+  const tracking =
+    BoxedJsFpsTracking.unbox() as JsFpsTrackingWithRuntimeRegistration
+  tracking.registerUiRuntime()
+}
+
+/**
+ * Reads the active runtimes from the runtime FPS buffer.
+ * Works on any thread (JS or worklets), the buffer is shared with native without copying.
+ */
+export const readRuntimeFps = (
+  buffer: ArrayBuffer,
+  names: string[]
+): RuntimeFps[] => {
+  'worklet'
+  const view = new DataView(buffer)
+  const capacity = view.getUint32(CAPACITY_OFFSET, true)
+  const recordSize = view.getUint32(RECORD_SIZE_OFFSET, true)
+  const runtimes: RuntimeFps[] = []
+  for (let slot = 0; slot < capacity; slot++) {
+    const offset = HEADER_SIZE + slot * recordSize
+    const name = names[slot]
+    if (view.getUint32(offset, true) === 0 || !name) {
+      continue
+    }
+    runtimes.push({
+      name,
+      fps: view.getInt32(offset + 4, true),
+      droppedFrames: view.getInt32(offset + 8, true),
+      maxLatencyMs: view.getFloat64(offset + 16, true),
+      updatedAtMs: view.getFloat64(offset + 24, true),
+    })
+  }
+  return runtimes
+}
@@ -1,6 +1,46 @@
 import { type HybridObject } from 'react-native-nitro-modules'
 
+/**
+ * - `continuous`: probes the JS thread every frame from a native pacing timer (default)
+ * - `on-demand`: probes only while native UI frames are produced, otherwise backs off while idle
+ */
+export type JsFpsTrackingMode = 'continuous' | 'on-demand'
+
+export interface LongTask {
+  /** When the late JS tick was posted (same timebase as `performance.now()`) */
+  startMs: number
+  /** How long the JS thread didn't respond */
+  durationMs: number
+  /** Chrome trace JSON sampled by the Hermes sampling profiler during the freeze, if supported */
+  sampledTrace?: string
+}
+
 export interface JsFpsTracking
   extends HybridObject<{ ios: 'c++'; android: 'c++' }> {
   getJsFpsBuffer(): ArrayBuffer
+  getJsDroppedFramesBuffer(): ArrayBuffer
+  getJsFrameTimelineBuffer(): ArrayBuffer
+  getJsLagEventsBuffer(): ArrayBuffer
+  setTrackingMode(mode: JsFpsTrackingMode): void
+  getTrackingMode(): JsFpsTrackingMode
+  /**
+   * Records JS thread freezes longer than `thresholdMs`, 0 (default) disables the watchdog.
+   */
+  setLongTaskThreshold(thresholdMs: number): void
+  /**
+   * Returns and removes the recorded freezes, oldest first.
+   */
+  drainLongTasks(): LongTask[]
+  /**
+   * FPS of every tracked runtime (main, worklets UI runtime, workers), see src/runtimeFps.ts for the layout.
+   */
+  getRuntimeFpsBuffer(): ArrayBuffer
+  /**
+   * Runtime name per slot of the runtime FPS buffer, empty for free slots. Slot 0 is the main runtime.
+   */
+  getTrackedRuntimes(): string[]
+  /**
+   * Stops tracking the runtime registered as `name`.
+   */
+  unregisterRuntime(name: string): void
 }
@@ -0,0 +1,223 @@
+import { type HybridObject } from 'react-native-nitro-modules'
+
+export interface Percentiles {
+  p50: number
+  p90: number
+  p99: number
+  max: number
+  /** Number of samples in the window */
+  count: number
+}
+
+export interface MetricPercentiles {
+  jsLatencyMs: Percentiles
+  jsFps: Percentiles
+  uiFps: Percentiles
+  cpuUsage: Percentiles
+  memoryUsage: Percentiles
+  /** Duration of every UI frame */
+  uiFrameTimeMs: Percentiles
+}
+
+/**
+ * - `above` / `below`: the value stayed past `threshold`
+ * - `slope-above` / `slope-below`: the value changes faster than `threshold` units per minute
+ */
+export type AlertCondition = 'above' | 'below' | 'slope-above' | 'slope-below'
+
+export interface AlertRule {
+  /** Metric slot, see `METRIC_SLOTS` in src/metricsBlock.ts */
+  metric: number
+  condition: AlertCondition
+  threshold: number
+  /**
+   * `above` / `below`: how long the condition must hold before the rule fires.
+   * Slopes: the window the slope is computed over (60 s by default).
+   */
+  forMs?: number
+  /** Like `forMs`, in consecutive samples. Slopes use this window instead of `forMs` when set. */
+  forSamples?: number
+}
+
+export interface Alert {
+  ruleId: number
+  metric: number
+  /** Latest value, or the slope per minute for slope rules */
+  value: number
+  /** When the violation started (same timebase as `performance.now()`) */
+  startedAtMs: number
+  firedAtMs: number
+  /** Samples the rule fired on, oldest first */
+  windowValues: number[]
+  windowTimestampsMs: number[]
+}
+
+/** Cumulative cost of the toolkit itself since it started measuring */
+export interface OverheadStats {
+  /** CPU time of the native timer thread (FPS pacing and reporting, samplers, listener delivery) */
+  schedulerCpuMs: number
+  /** CPU time of the session recording writer threads */
+  sessionWriterCpuMs: number
+  /** Time spent in toolkit tasks on JS runtimes (FPS probes, heap samples) */
+  jsTaskMs: number
+  /** Time spent in the toolkit's UI frame callback work */
+  uiFrameMs: number
+  /** Number of tasks posted to JS runtimes */
+  jsTasks: number
+  /** Wakeups of the timer and session writer threads */
+  wakeups: number
+  /** Calls the toolkit made into a JS runtime */
+  jsiCalls: number
+  /** How long these totals cover */
+  measuredForMs: number
+}
+
+/**
+ * - `off`: nothing is measured
+ * - `production`: 2 s windows, slow samplers, no per-tick timeline records
+ * - `qa`: the built-in defaults, with the per-tick JS frame timeline (the initial profile)
+ * - `profiling`: every sampler at its fastest rate, short windows
+ */
+export type SamplingProfile = 'off' | 'production' | 'qa' | 'profiling'
+
+/** Every interval is in ms, 0 means off */
+export interface SamplingConfig {
+  /** Profile the config started from */
+  profile: SamplingProfile
+  /** JS FPS window of every tracked runtime (250-10000) */
+  jsFpsWindowMs: number
+  /** UI FPS window (250-10000) */
+  uiFpsWindowMs: number
+  /** CPU sampling period, rounded to 250 ms steps */
+  cpuIntervalMs: number
+  memoryIntervalMs: number
+  jsHeapIntervalMs: number
+  /** How often the UI thread counter hooks refresh (250-10000) */
+  counterUpdateIntervalMs: number
+  /** Whether every JS tick is written to the frame timeline */
+  frameTimeline: boolean
+}
+
+export interface SamplingOverrides {
+  jsFpsWindowMs?: number
+  uiFpsWindowMs?: number
+  cpuIntervalMs?: number
+  memoryIntervalMs?: number
+  jsHeapIntervalMs?: number
+  counterUpdateIntervalMs?: number
+  frameTimeline?: boolean
+}
+
+/**
+ * When the process reached each startup milestone, recorded once per process (reloads don't
+ * record again). Steady clock ms like `updatedAtMs` of the metrics, 0 if not reached (yet).
+ */
+export interface StartupTimeline {
+  /** Process creation, from the kernel */
+  processStartMs: number
+  /** The toolkit's native library loaded (JNI_OnLoad on Android, before main() on iOS) */
+  nativeLibraryLoadedMs: number
+  /** The JS runtime was handed to the toolkit's TurboModule, when JS first requires it */
+  runtimeCreatedMs: number
+  /** The TurboModule's JSI bindings were installed into the runtime */
+  bindingsInstalledMs: number
+  /** The JS thread ran its first task after the runtime was handed over */
+  firstJsTickMs: number
+  /** The first UI frame after the native library loaded */
+  firstUiFrameMs: number
+}
+
+export interface PerformanceMetrics
+  extends HybridObject<{ ios: 'c++'; android: 'c++' }> {
+  /**
+   * Latest value of every metric in a single shared buffer, see src/metricsBlock.ts for the layout.
+   * The buffer is allocated once, keep it and read it as often as needed.
+   */
+  getMetricsBuffer(): ArrayBuffer
+  /**
+   * Per-thread CPU usage sampled from procfs, see src/threadCpuUsage.ts for the layout.
+   * Android only, on iOS the buffer stays empty.
+   */
+  getThreadCpuUsageBuffer(): ArrayBuffer
+  /**
+   * Percentiles of every metric over the last `windowSeconds` (1-10), computed from native histograms.
+   */
+  getMetricPercentiles(windowSeconds: number): MetricPercentiles
+  /**
+   * Starts recording every sample into a binary session file, see cpp/SessionRecorder.hpp for the format.
+   * Writes to `path`, or to a new file in the app cache directory. Resolves with the file path.
+   * The file is created off the JS thread, await it before `stopSessionRecording`.
+   */
+  startSessionRecording(path?: string): Promise<string>
+  /**
+   * Stops the running session and resolves with its file path, undefined if no session was running.
+   * Flushing and closing the file happens off the JS thread. Rejects if the session ended early
+   * because the file couldn't grow (storage full), the file still holds everything recorded until then.
+   */
+  stopSessionRecording(): Promise<string | undefined>
+  /**
+   * Converts a recorded session into a Chrome Trace Event JSON file (opens in ui.perfetto.dev).
+   * Writes next to the session (`.json`) unless `tracePath` is given. Resolves with the trace path.
+   */
+  exportSessionTrace(sessionPath: string, tracePath?: string): Promise<string>
+  /**
+   * Returns the id of a user timing name, the same name always returns the same id.
+   * Intern names once (module scope) and pass the id to `mark` / `beginSpan` / `endSpan`.
+   */
+  internTimingName(name: string): number
+  /**
+   * Records a mark into the running session, a no-op while no session is recording.
+   */
+  mark(nameId: number): void
+  /**
+   * Opens a span on the calling thread, it is recorded when `endSpan` is called with the same id.
+   */
+  beginSpan(nameId: number): void
+  /**
+   * Closes the innermost open span with `nameId` on the calling thread.
+   */
+  endSpan(nameId: number): void
+  /**
+   * Calls `listener` with a bitmask of the metric slots (see src/metricsBlock.ts) whose value changed,
+   * batched across metrics and at most once per frame. Read the values from the metrics buffer.
+   * `minChanges[slot]` is the smallest change of a slot that is reported, any change by default.
+   * Returns an id for `removeMetricsListener`.
+   */
+  addMetricsListener(
+    listener: (changedSlots: number) => void,
+    minChanges?: number[]
+  ): number
+  /**
+   * Posts metric changes to the worklets UI runtime registered as `ui` (see `registerUiRuntime`),
+   * by calling its global `__performanceToolkitOnMetricsChange(changedSlots)`. Batched to at most
+   * one call per `counterUpdateIntervalMs` of the sampling profile, none while it is 0.
+   * Used by the UI counter hooks. Returns an id for `removeMetricsListener`.
+   */
+  addUiMetricsListener(): number
+  removeMetricsListener(listenerId: number): void
+  /**
+   * Evaluates `rule` natively against every sample of its metric, on the native scheduler thread.
+   * `onAlert` is only called when the rule fires, once per violation. Returns an id for `removeAlertRule`.
+   */
+  addAlertRule(rule: AlertRule, onAlert: (alert: Alert) => void): number
+  removeAlertRule(ruleId: number): void
+  /**
+   * Cumulative cost of the toolkit itself, starts measuring on the first call (or `getMetricsBuffer`).
+   * The share of one core over the last second is also published as `toolkitCpuUsage` / `toolkitJsThreadUsage`.
+   */
+  getOverheadStats(): OverheadStats
+  /**
+   * Switches every sampler, window and writer to `profile`, with `overrides` on top. Applies right
+   * away without restarting anything, the shared buffers stay the same. Returns the applied config.
+   */
+  setSamplingProfile(
+    profile: SamplingProfile,
+    overrides?: SamplingOverrides
+  ): SamplingConfig
+  getSamplingConfig(): SamplingConfig
+  /**
+   * The startup milestones of this process, see `StartupTimeline`. Meant to be read once startup is
+   * over, e.g. when the first screen is interactive.
+   */
+  getStartupTimeline(): StartupTimeline
+}
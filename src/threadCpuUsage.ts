@@ -0,0 +1,87 @@
+import { PerformanceMetrics } from './hybrids'
+
+// Must match the layout in cpp/CpuSampler.hpp
+const HEADER_SIZE = 16
+const SEQUENCE_OFFSET = 0
+const THREAD_COUNT_OFFSET = 4
+const RECORD_SIZE_OFFSET = 8
+const NAME_OFFSET = 16
+const NAME_SIZE = 24
+const MAX_READ_ATTEMPTS = 8
+
+export type ThreadRole =
+  | 'other'
+  | 'ui'
+  | 'js'
+  | 'native-modules'
+  | 'react-background'
+
+// Indexed by `ThreadRole` in cpp/CpuSampler.hpp
+const THREAD_ROLES: ThreadRole[] = [
+  'other',
+  'ui',
+  'js',
+  'native-modules',
+  'react-background',
+]
+
+export type ThreadCpuUsage = {
+  tid: number
+  name: string
+  role: ThreadRole
+  /** Percent of one core since the previous sample */
+  cpuUsage: number
+}
+
+/**
+ * Returns the per-thread CPU usage buffer and starts the native sampler (every 500 ms).
+ * Android only, on iOS the buffer stays empty.
+ */
+export const getThreadCpuUsageBuffer = () =>
+  PerformanceMetrics.getThreadCpuUsageBuffer()
+
+/**
+ * Reads the latest per-thread CPU usage sample, sorted by CPU usage (highest first).
+ * Works on any thread (JS or worklets) without calling into native.
+ */
+export const readThreadCpuUsage = (buffer: ArrayBuffer): ThreadCpuUsage[] => {
+  'worklet'
+  const view = new DataView(buffer)
+  const recordSize = view.getUint32(RECORD_SIZE_OFFSET, true)
+
+  const readAll = () => {
+    const threads: ThreadCpuUsage[] = []
+    const count = view.getUint32(THREAD_COUNT_OFFSET, true)
+    for (let index = 0; index < count; index++) {
+      const offset = HEADER_SIZE + index * recordSize
+      let name = ''
+      for (let i = 0; i < NAME_SIZE; i++) {
+        const char = view.getUint8(offset + NAME_OFFSET + i)
+        if (char === 0) {
+          break
+        }
+        name += String.fromCharCode(char)
+      }
+      threads.push({
+        tid: view.getInt32(offset, true),
+        role: THREAD_ROLES[view.getUint32(offset + 4, true)] ?? 'other',
+        cpuUsage: view.getFloat64(offset + 8, true),
+        name,
+      })
+    }
+    return threads
+  }
+
+  let threads = readAll()
+  for (let attempt = 0; attempt < MAX_READ_ATTEMPTS; attempt++) {
+    const before = view.getUint32(SEQUENCE_OFFSET, true)
+    if (before % 2 !== 0) {
+      continue // Sample being written
+    }
+    threads = readAll()
+    if (view.getUint32(SEQUENCE_OFFSET, true) === before) {
+      break
+    }
+  }
+  return threads.sort((a, b) => b.cpuUsage - a.cpuUsage)
+}